@@ -52,6 +52,7 @@ bool AppDelegate::applicationDidFinishLaunching() {
     director->setDisplayStats(true);
 
     // set FPS. the default value is 1.0/60 if you don't call this
+    // LineDrawer stops the loop while the canvas is idle and starts it again on input, see setOnDemandRendering()
     director->setAnimationInterval(1.0 / 60);
 
     // Set the design resolution
@@ -11,95 +11,13 @@
 
 #include <stdio.h>
 #include <array>
+#include <map>
+#include "StrokeBridge.hpp"
+#include "Stroke/InputClock.hpp"
+#include "Stroke/PanTracker.hpp"
 
 using namespace cocos2d;
 
-class VelocityCalculator {
-    
-public:
-    using time_point = std::chrono::high_resolution_clock::time_point;
-    static constexpr int MaxVelocitySamples = 10;
-    static constexpr bool Debug = false;
-    
-public:
-    VelocityCalculator () : _sampleCount(0), _runningVelocitySum(0, 0), _velocitySamples {}, _first(true) {
-    }
-    
-    void reset()
-    {
-        _sampleCount = 0;
-        _runningVelocitySum = Vec2 {0, 0};
-        _first = true;
-        _velocitySamples = {};
-    }
-    
-    void addLocation(Vec2 location)
-    {
-        using namespace std::chrono;
-        addLocation(location, high_resolution_clock::now());
-    }
-    
-    void addLocation(Vec2 location, time_point timestamp)
-    {
-        using namespace std::chrono;
-        
-        if (Debug)
-            CCLOG("adding location %.2f %.2f timestamp %.2lld", location.x, location.y, time_point_cast<milliseconds>(timestamp).time_since_epoch().count());
-        
-        if (!_first) {
-            high_resolution_clock::duration timeSinceLastUpdate = (timestamp - _prevTimestamp);
-            
-            if (Debug)
-                CCLOG("time since last update %.2lld", duration_cast<milliseconds>(timeSinceLastUpdate).count());
-            
-            Vec2 instVelocity = Vec2 {
-                (location.x - _prevLocation.x) / duration_cast<milliseconds>(timeSinceLastUpdate).count() * 1000,
-                (location.y - _prevLocation.y) / duration_cast<milliseconds>(timeSinceLastUpdate).count() * 1000
-            };
-            
-            int lastSampleIndex = _sampleCount % MaxVelocitySamples;
-            Vec2 lastSample = _velocitySamples[lastSampleIndex];
-            
-            _runningVelocitySum -= lastSample;
-            _runningVelocitySum += instVelocity;
-            
-            _velocitySamples[lastSampleIndex] = instVelocity;
-            _sampleCount++;
-        }
-        else {
-            _first = false;
-        }
-        
-        _prevLocation = location;
-        _prevTimestamp = timestamp;
-    }
-    
-    Vec2 getLastVelocitySample()
-    {
-        int lastSampleIndex = _sampleCount % MaxVelocitySamples;
-        return _velocitySamples[lastSampleIndex];
-    }
-    
-    int getSampleCount() { return _sampleCount; }
-    
-    Vec2 getRunningAvgVelocity()
-    {
-        return _sampleCount >= MaxVelocitySamples
-        ? Vec2 { _runningVelocitySum.x / MaxVelocitySamples, _runningVelocitySum.y / MaxVelocitySamples }
-        : Vec2 { _runningVelocitySum.x / _sampleCount, _runningVelocitySum.y / _sampleCount };
-    }
-    
-private:
-    bool _first;
-    time_point _prevTimestamp;
-    Vec2 _prevLocation;
-    
-    std::array<Vec2, MaxVelocitySamples> _velocitySamples;
-    int _sampleCount;
-    Vec2 _runningVelocitySum;
-    
-};
-
 class BasicGestureRecognizer : public Ref
 {
 public:
@@ -123,6 +41,15 @@ public:
     virtual void addWithSceneGraphPriority(EventDispatcher *eventDispatcher, Node *node) = 0;
     
 protected:
+    //! moves tracker through every sample the platform coalesced into the touch's event, or to its one location
+    static bool moveTracker(stroke::PanTracker &tracker, Touch *touch)
+    {
+        stroke::Vec2 location = toStroke(touch->getLocation());
+        if (auto samples = stroke::InputClock::getSamples(location))
+            return tracker.touchMoved(samples->data(), samples->size());
+        return tracker.touchMoved(location, stroke::InputClock::getEventTime());
+    }
+    
     targetCallBack _target;
     State _state;
     Vec2 _location;
@@ -131,7 +58,7 @@ protected:
 class PanGestureRecognizer : public BasicGestureRecognizer
 {
 public:
-    static constexpr float MinPanDistance = 5.0f;
+    static constexpr float MinPanDistance = stroke::PanTracker::MinPanDistance;
     
 public:
     static PanGestureRecognizer *create()
@@ -154,39 +81,23 @@ public:
         auto eventListener = EventListenerTouchOneByOne::create();
         
         eventListener->onTouchBegan = [this] (Touch *touch, Event *event) -> bool {
-            _location = touch->getLocation();
-            _velocityCalc.reset();
-            _velocityCalc.addLocation(_location);
-            _beganLocation = touch->getLocation();
-            _state = Possible;
+            _tracker.touchBegan(toStroke(touch->getLocation()), stroke::InputClock::getEventTime());
+            syncWithTracker();
             return true;
         };
         
         eventListener->onTouchMoved = [this] (Touch *touch, Event *event) {
-            Vec2 location = touch->getLocation();
-            _velocityCalc.addLocation(touch->getLocation());
-            _location = location;
-            
-            if (_state == Possible) {
-                if ((location - _beganLocation).getLength() > MinPanDistance) {
-                    _state = Began;
-                    _target(this);
-                    return;
-                }
-            }
-            else if (_state == Began) {
-                _state = Changed;
-            }
-            
-            if (_state == Changed) {
+            bool notify = moveTracker(_tracker, touch);
+            syncWithTracker();
+            if (notify) {
                 _target(this);
             }
         };
         
         eventListener->onTouchEnded = [this] (Touch *touch, Event *event) {
-            _location = touch->getLocation();
-            if (_state == Changed) {
-                _state = Completed;
+            bool notify = _tracker.touchEnded(toStroke(touch->getLocation()));
+            syncWithTracker();
+            if (notify) {
                 _target(this);
             }
         };
@@ -194,11 +105,119 @@ public:
         eventDispatcher->addEventListenerWithSceneGraphPriority(eventListener, node);
     }
     
-    Vec2 getVelocity() { return _velocityCalc.getRunningAvgVelocity(); }
+    Vec2 getVelocity() { return toCocos(_tracker.getVelocity()); }
+    stroke::PanTracker::time_point getTimestamp() const { return _tracker.getTimestamp(); }
+    //! every sample of the move, oldest first, with the location and velocity above as the last
+    const std::vector<stroke::PanSample> &getSamples() const { return _tracker.getSamples(); }
+    
+private:
+    void syncWithTracker()
+    {
+        _state = static_cast<State>(_tracker.getState());
+        _location = toCocos(_tracker.getLocation());
+    }
+    
+    //! the state machine and velocity estimate, shared with the headless replay benchmark
+    stroke::PanTracker _tracker;
+    
+};
+
+//! Pans of any number of fingers at once, each with a PanTracker of its own under its touch id. The target
+//! is called for every state change of every pan, with getTouchId(), getState(), getLocation() and
+//! getVelocity() describing that one.
+class MultiPanGestureRecognizer : public BasicGestureRecognizer
+{
+public:
+    static MultiPanGestureRecognizer *create()
+    {
+        MultiPanGestureRecognizer *node = new (std::nothrow) MultiPanGestureRecognizer();
+        if (node)
+        {
+            node->init();
+            node->autorelease();
+        }
+        else
+        {
+            CC_SAFE_DELETE(node);
+        }
+        return node;
+    }
+    
+    MultiPanGestureRecognizer () : _touchId(0), _samples(&_noSamples) {}
+    
+    void addWithSceneGraphPriority(EventDispatcher *eventDispatcher, Node *node)
+    {
+        auto eventListener = EventListenerTouchAllAtOnce::create();
+        
+        eventListener->onTouchesBegan = [this] (const std::vector<Touch *> &touches, Event *event) {
+            auto now = stroke::InputClock::getEventTime();
+            for (auto touch : touches) {
+                _trackers[touch->getID()].touchBegan(toStroke(touch->getLocation()), now);
+            }
+        };
+        
+        eventListener->onTouchesMoved = [this] (const std::vector<Touch *> &touches, Event *event) {
+            for (auto touch : touches) {
+                auto tracker = _trackers.find(touch->getID());
+                if (tracker != _trackers.end() && moveTracker(tracker->second, touch))
+                    notify(tracker->first, tracker->second);
+            }
+        };
+        
+        //! a cancelled touch ends its stroke where it was, the ink so far stays
+        eventListener->onTouchesEnded = eventListener->onTouchesCancelled = [this] (const std::vector<Touch *> &touches, Event *event) {
+            for (auto touch : touches) {
+                auto tracker = _trackers.find(touch->getID());
+                if (tracker == _trackers.end())
+                    continue;
+                //! a pan that began and ended without moving again still completes, so its stroke ends
+                bool began = tracker->second.getState() == stroke::PanTracker::Began;
+                if (tracker->second.touchEnded(toStroke(touch->getLocation())))
+                    notify(tracker->first, tracker->second);
+                else if (began)
+                    notify(tracker->first, tracker->second, Completed);
+                _trackers.erase(tracker);
+            }
+        };
+        
+        eventDispatcher->addEventListenerWithSceneGraphPriority(eventListener, node);
+    }
+    
+    int getTouchId() const { return _touchId; }
+    Vec2 getVelocity() const { return _velocity; }
+    //! of the touch the state change came with
+    stroke::PanTracker::time_point getTimestamp() const { return _timestamp; }
+    //! Every sample of the move the state change came with, oldest first, with the location, velocity and
+    //! timestamp above as the last; empty for a pan that completed.
+    const std::vector<stroke::PanSample> &getSamples() const { return *_samples; }
+    
+    //! fingers down
+    size_t getTouchCount() const { return _trackers.size(); }
     
 private:
-    Vec2 _beganLocation;
-    VelocityCalculator _velocityCalc;
+    void notify(int touchId, stroke::PanTracker &tracker)
+    {
+        notify(touchId, tracker, static_cast<State>(tracker.getState()));
+    }
+    
+    void notify(int touchId, stroke::PanTracker &tracker, State state)
+    {
+        _touchId = touchId;
+        _state = state;
+        _location = toCocos(tracker.getLocation());
+        _velocity = toCocos(tracker.getVelocity());
+        _timestamp = tracker.getTimestamp();
+        _samples = state == Completed ? &_noSamples : &tracker.getSamples();
+        _target(this);
+    }
+    
+    //! by touch id, while the finger is down
+    std::map<int, stroke::PanTracker> _trackers;
+    int _touchId;
+    Vec2 _velocity;
+    stroke::PanTracker::time_point _timestamp;
+    const std::vector<stroke::PanSample> *_samples;
+    const std::vector<stroke::PanSample> _noSamples;
     
 };
 
@@ -0,0 +1,35 @@
+//
+//  InkOverlay.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include <algorithm>
+#include "InkOverlay.hpp"
+
+void InkOverlay::addMesh(const stroke::StrokeMesh &mesh, const Color4F &color)
+{
+    if (mesh.empty())
+        return;
+    //! the pass that drew mesh last frame still has it in its buffers, so a growing stroke uploads only its new piece
+    auto last = std::find_if(_passes.begin() + _passCount, _passes.end(), [&mesh] (const std::unique_ptr<Pass> &pass) { return pass->mesh == &mesh; });
+    if (last != _passes.end())
+        std::swap(*last, _passes[_passCount]);
+    else if (_passCount == _passes.size())
+        _passes.emplace_back(new Pass);
+    auto &pass = *_passes[_passCount++];
+    pass.mesh = &mesh;
+    pass.color = color;
+}
+
+void InkOverlay::draw(Renderer *renderer, const Mat4 &transform, uint32_t flags)
+{
+    for (size_t i = 0; i < _passCount; ++i) {
+        auto &pass = *_passes[i];
+        pass.renderer.draw(renderer, transform, flags, getGlobalZOrder(), *pass.mesh, pass.color);
+    }
+    _passCount = 0;
+    Node::draw(renderer, transform, flags);
+}
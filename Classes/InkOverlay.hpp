@@ -0,0 +1,63 @@
+//
+//  InkOverlay.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef InkOverlay_hpp
+#define InkOverlay_hpp
+
+#include <memory>
+#include <vector>
+#include "StrokeRenderer.hpp"
+
+using namespace cocos2d;
+
+//! Ink that is drawn straight to the frame buffer over the canvas, for the next frame only, and never into
+//! a tile: what a later frame replaces, such as the strokes in progress and the predicted wet ink at their
+//! tips. It costs the fill of the ink itself, with no texture of its own. Add it after the canvas so it
+//! composites above the tiles.
+class InkOverlay : public Node {
+
+public:
+    static InkOverlay *create()
+    {
+        InkOverlay *node = new (std::nothrow) InkOverlay();
+        if (node && node->init())
+        {
+            node->autorelease();
+        }
+        else
+        {
+            CC_SAFE_DELETE(node);
+        }
+        return node;
+    }
+
+    InkOverlay () : _passCount(0) {}
+
+    //! Queues mesh, in this node's coordinates, for the next frame, over the meshes queued before it. mesh
+    //! has to stay unchanged until the renderer has drawn it.
+    void addMesh(const stroke::StrokeMesh &mesh, const Color4F &color);
+
+    virtual void draw(Renderer *renderer, const Mat4 &transform, uint32_t flags);
+
+private:
+    //! kept across frames, each renderer has buffers of its own
+    struct Pass {
+        Pass () : mesh(nullptr) {}
+
+        StrokeRenderer renderer;
+        //! the mesh queued, and after the frame the one the buffers hold
+        const stroke::StrokeMesh *mesh;
+        Color4F color;
+    };
+
+    std::vector<std::unique_ptr<Pass>> _passes;
+    size_t _passCount;
+
+};
+
+#endif /* InkOverlay_hpp */
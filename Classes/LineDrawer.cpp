@@ -10,3 +10,4 @@
 
 
 const Color4F LineDrawer::BackgroundColor = Color4F {1.0, 1.0, 1.0, 1.0};
+const Color4F LineDrawer::InkColor = Color4F {0.0, 0.0, 0.0, 1.0};
@@ -10,32 +10,30 @@
 #define LineDrawer_hpp
 
 #include <stdio.h>
+#include <map>
+#include <memory>
+#include <vector>
 #include "GestureRecognizers.hpp"
+#include "InkOverlay.hpp"
+#include "StrokeBridge.hpp"
+#include "TiledCanvas.hpp"
+#include "Stroke/RedrawPolicy.hpp"
+#include "Stroke/StrokePipeline.hpp"
 
 using namespace cocos2d;
 
 class LineDrawer : public Node {
     
 public:
-    static constexpr float DefaultLineWidth = 1.0f;
-    static constexpr float Overdraw = .5f;
+    static constexpr float DefaultLineWidth = stroke::DefaultLineWidth;
+    static constexpr float Overdraw = stroke::StrokeTessellator::Overdraw;
     static const Color4F BackgroundColor;
+    static const Color4F InkColor;
     
-    struct LinePoint {
-        Vec2 pos;
-        float width;
-        
-        LinePoint (Vec2 p, float w) : pos(p), width(w) {}
-        LinePoint() : pos {0, 0}, width {DefaultLineWidth} {}
-    };
-    
-    struct CirclePoint {
-        Vec2 pos;
-        float width;
-        Vec2 dir;
-        CirclePoint (Vec2 p, float w, Vec2 d) : pos(p), width(w), dir(d) {}
-    };
-
+    using LinePoint = stroke::LinePoint;
+    
+    //! the touch id startNewLine(), addPoint() and endLine() draw under, apart from any finger's
+    static constexpr int LineTouchId = -1;
     
 public:
     static LineDrawer *create()
@@ -53,10 +51,13 @@ public:
         return node;
     }
     
-    LineDrawer () : _enableLineSmoothing(true), _lastSize(0.0) {}
+    LineDrawer () : _panGestureRecognizer(nullptr), _longPressGestureRecognizer(nullptr), _frameMesh(nullptr), _flattening(stroke::StrokeSmoother::Flattening::Adaptive), _flatteningTolerance(stroke::StrokeSmoother::DefaultFlatteningTolerance), _capTolerance(stroke::StrokeTessellator::DefaultCapTolerance), _predictionHorizon(stroke::InkPredictor::DefaultHorizon), _liveOverlay(true), _threaded(false), _canvas(nullptr), _inkOverlay(nullptr), _zoom(1), _rasterizePending(false), _entryOpen(false), _strokeEnding(false), _redoQueued(false), _ctrlDown(false), _shiftDown(false), _skippedFrames(0) {}
     ~LineDrawer() {
-        if (_renderTexture != nullptr)
-            _renderTexture->release();
+        if (_canvas != nullptr)
+            _canvas->release();
+        
+        if (_inkOverlay != nullptr)
+            _inkOverlay->release();
         
         if (_panGestureRecognizer != nullptr)
             _panGestureRecognizer->release();
@@ -67,7 +68,7 @@ public:
     
     virtual bool init()
     {
-        _panGestureRecognizer = PanGestureRecognizer::create();
+        _panGestureRecognizer = MultiPanGestureRecognizer::create();
         _panGestureRecognizer->retain();
         
         _panGestureRecognizer->setTarget(CC_CALLBACK_1(LineDrawer::handlePanGestureRecognizer, this));
@@ -79,14 +80,44 @@ public:
         _longPressGestureRecognizer->setTarget(CC_CALLBACK_1(LineDrawer::handleLongPressGestureRecognizer, this));
         _longPressGestureRecognizer->addWithSceneGraphPriority(this->getEventDispatcher(), this);
         
-        Size size = Director::getInstance()->getWinSize();
-        _renderTexture = RenderTexture::create(size.width, size.height, Texture2D::PixelFormat::RGBA8888);
-        _renderTexture->retain();
+        //! the canvas only has tiles where there is ink, the background is the frame buffer's clear color
+        Director::getInstance()->setClearColor(BackgroundColor);
+        _canvas = TiledCanvas::create();
+        _canvas->retain();
+        _canvas->setBackgroundColor(BackgroundColor);
+        this->addChild(_canvas);
+        
+        //! the wet ink goes over the tiles, so after them
+        _inkOverlay = InkOverlay::create();
+        _inkOverlay->retain();
+        this->addChild(_inkOverlay);
+        
+        //! any finger coming down starts the frame loop, before the pan recognizer has seen it move
+        auto touchListener = EventListenerTouchAllAtOnce::create();
+        touchListener->onTouchesBegan = [this] (const std::vector<Touch *> &touches, Event *) {
+            for (size_t i = 0; i < touches.size(); ++i) {
+                if (_redrawPolicy.touchBegan())
+                    Director::getInstance()->startAnimation();
+            }
+        };
+        touchListener->onTouchesEnded = touchListener->onTouchesCancelled = [this] (const std::vector<Touch *> &touches, Event *) {
+            for (size_t i = 0; i < touches.size(); ++i) {
+                _redrawPolicy.touchEnded();
+            }
+        };
+        this->getEventDispatcher()->addEventListenerWithSceneGraphPriority(touchListener, this);
+        
+        auto keyboardListener = EventListenerKeyboard::create();
+        keyboardListener->onKeyPressed = CC_CALLBACK_2(LineDrawer::handleKeyPressed, this);
+        keyboardListener->onKeyReleased = CC_CALLBACK_2(LineDrawer::handleKeyReleased, this);
+        this->getEventDispatcher()->addEventListenerWithSceneGraphPriority(keyboardListener, this);
         
-        _renderTexture->clear(BackgroundColor.r, BackgroundColor.g, BackgroundColor.b, BackgroundColor.a);
-        _renderTexture->setAnchorPoint(Vec2 {0, 0});
-        _renderTexture->setPosition(Vec2 {size.width * .5f, size.height * .5f});
-        this->addChild(_renderTexture);
+        //! the render texture pass is timed where the renderer executes it, around the render texture's own commands
+        _renderTextureBeginCommand.func = [this] { _profiler.begin(stroke::FrameStats::RenderTexture); };
+        _renderTextureEndCommand.func = [this] {
+            _profiler.end(stroke::FrameStats::RenderTexture);
+            _profiler.endFrame();
+        };
         
         return true;
     }
@@ -95,340 +126,536 @@ public:
     {
 //        LongPressGestureRecognizer *recognizer = static_cast<LongPressGestureRecognizer *>(r);
 //        CCLOG("got long press");
-        _renderTexture->beginWithClear(BackgroundColor.r, BackgroundColor.g, BackgroundColor.b, BackgroundColor.a);
-        _renderTexture->end();
+        //! strokes in progress carry on as new strokes of the cleared model, outside any history entry
+        for (auto &pipeline : _pipelines) {
+            pipeline->setModel(nullptr);
+        }
+        _canvas->clear();
+        _model.clear();
+        for (auto &pipeline : _pipelines) {
+            pipeline->setModel(&_model, 1 / _zoom);
+        }
+        _redoQueued = false;
+        _entryOpen = false;
+        _strokeEnding = false;
+        invalidate();
     }
     
     void handlePanGestureRecognizer(BasicGestureRecognizer *r)
     {
 //        CCLOG("received gesture %d", recognizer->getState());
-        PanGestureRecognizer *recognizer = static_cast<PanGestureRecognizer *>(r);
+        MultiPanGestureRecognizer *recognizer = static_cast<MultiPanGestureRecognizer *>(r);
+        int touchId = recognizer->getTouchId();
         
         switch (recognizer->getState()) {
-            case PanGestureRecognizer::Began: {
-                Vec2 location = recognizer->getLocation();
-                //        CCLOG("touch began: %.2f %.2f", location.x, location.y);
-
-                _points.clear();
+            //! every sample of the move at once, however many the platform coalesced into it
+            case PanGestureRecognizer::Began:
+                beginTouch(touchId).panBegan(recognizer->getSamples().data(), recognizer->getSamples().size());
+                break;
                 
-                _lastSize = 0.0;
-                float size = extractSize(recognizer->getVelocity());
+            case PanGestureRecognizer::Changed:
+                if (auto pipeline = findTouch(touchId))
+                    pipeline->panChanged(recognizer->getSamples().data(), recognizer->getSamples().size());
+                break;
                 
-                startNewLine(location, size);
-                addPoint(location, size);
-                addPoint(location, size);
-
+            case PanGestureRecognizer::Completed:
+                if (auto pipeline = findTouch(touchId)) {
+                    pipeline->panCompleted(toStroke(recognizer->getLocation()), toStroke(recognizer->getVelocity()));
+                    endTouch(touchId);
+                }
                 break;
-            }
                 
-            case PanGestureRecognizer::Changed: {
-                Vec2 location = recognizer->getLocation();
-                //        CCLOG("touch moved: %.2f %.2f", location.x, location.y);
+            default:
+                break;
+        }
+    }
+    
+    //! Ctrl+Z undoes the last stroke, Ctrl+Shift+Z or Ctrl+Y redoes it.
+    void handleKeyPressed(EventKeyboard::KeyCode key, Event *event)
+    {
+        switch (key) {
+            case EventKeyboard::KeyCode::KEY_CTRL:
+            case EventKeyboard::KeyCode::KEY_RIGHT_CTRL:
+                _ctrlDown = true;
+                break;
                 
-                //! skip points that are too close
-                float eps = 1.5f;
-                if (_points.size() > 0) {
-                    auto v = _points.back().pos - location;
-                    float length = v.getLength();
-                    
-                    if (length < eps) {
-                        return;
-                    } else {
-                    }
+            case EventKeyboard::KeyCode::KEY_SHIFT:
+            case EventKeyboard::KeyCode::KEY_RIGHT_SHIFT:
+                _shiftDown = true;
+                break;
+                
+            case EventKeyboard::KeyCode::KEY_Z:
+            case EventKeyboard::KeyCode::KEY_CAPITAL_Z:
+                if (_ctrlDown) {
+                    if (_shiftDown)
+                        redo();
+                    else
+                        undo();
                 }
+                break;
                 
-                float size = extractSize(recognizer->getVelocity());
-                addPoint(location, size);
+            case EventKeyboard::KeyCode::KEY_Y:
+                if (_ctrlDown)
+                    redo();
                 break;
-            }
                 
-            case PanGestureRecognizer::Completed: {
-                Vec2 location = recognizer->getLocation();
-                float size = extractSize(recognizer->getVelocity());
-                endLine(location, size);
-                //        CCLOG("touch ended: %.2f %.2f", location.x, location.y);
-                //        CCLOG("line has points %lu", _points.size());
+            default:
+                break;
+        }
+    }
+    
+    void handleKeyReleased(EventKeyboard::KeyCode key, Event *event)
+    {
+        switch (key) {
+            case EventKeyboard::KeyCode::KEY_CTRL:
+            case EventKeyboard::KeyCode::KEY_RIGHT_CTRL:
+                _ctrlDown = false;
+                break;
                 
+            case EventKeyboard::KeyCode::KEY_SHIFT:
+            case EventKeyboard::KeyCode::KEY_RIGHT_SHIFT:
+                _shiftDown = false;
                 break;
-            }
                 
             default:
                 break;
         }
     }
     
-    void startNewLine(Vec2 point, float size)
+    //! Undo puts back the tiles the last strokes drew over, from the canvas history, and takes the strokes
+    //! out of the model: every stroke of fingers that were down together goes at once. Nothing happens while
+    //! a stroke is being drawn, while a redo waits for its frame or once the history is exhausted.
+    bool undo()
+    {
+        if (_redoQueued || !_canvas->getHistory().canUndo())
+            return false;
+        for (size_t strokes = _canvas->undo(); strokes > 0; --strokes) {
+            _model.undoStroke();
+        }
+        invalidate();
+        return true;
+    }
+    
+    //! redo draws the undone strokes again from the model, on the next frame.
+    bool redo()
     {
-        _connectingLine = false;
-        addPoint(point, size);
+        if (!_canvas->getHistory().canRedo())
+            return false;
+        size_t strokes = _canvas->redo();
+        for (size_t i = 0; i < strokes; ++i) {
+            _model.redoStroke();
+        }
+        
+        if (!_redoQueued)
+            _redoMesh.clear();
+        for (size_t i = _model.getStrokeCount() - strokes; i < _model.getStrokeCount(); ++i) {
+            _rasterizer.rasterizeStroke(_model, i, _zoom, _strokeMesh);
+            _redoMesh.append(_strokeMesh);
+        }
+        _redoQueued = true;
+        invalidate();
+        return true;
     }
+    
+    void startNewLine(Vec2 point, float size) { beginTouch(LineTouchId).startNewLine(toStroke(point), size); }
     void addPoint(Vec2 point, float size)
     {
-        _points.push_back(LinePoint(point, size));
+        if (auto pipeline = findTouch(LineTouchId))
+            pipeline->addPoint(toStroke(point), size);
     }
+    //! a batch of points, in one pass through the pipeline
+    void addPoints(const LinePoint *points, size_t count)
+    {
+        if (auto pipeline = findTouch(LineTouchId))
+            pipeline->addPoints(points, count);
+    }
+    void addPoints(const std::vector<LinePoint> &points) { addPoints(points.data(), points.size()); }
     void endLine(Vec2 point, float size)
     {
-        addPoint(point, size);
-        _finishingLine = true;
+        if (auto pipeline = findTouch(LineTouchId)) {
+            pipeline->endLine(toStroke(point), size);
+            endTouch(LineTouchId);
+        }
+    }
+    
+    //! Adaptive flattening samples each curve only as densely as needed to stay within the tolerance,
+    //! in points, of the true curve. Fixed reproduces the original 32 to 128 samples per curve.
+    void setFlattening(stroke::StrokeSmoother::Flattening flattening)
+    {
+        _flattening = flattening;
+        for (auto &pipeline : _pipelines) {
+            pipeline->getSmoother().setFlattening(flattening);
+        }
+    }
+    void setFlatteningTolerance(float tolerance)
+    {
+        _flatteningTolerance = tolerance;
+        for (auto &pipeline : _pipelines) {
+            pipeline->getSmoother().setFlatteningTolerance(tolerance);
+        }
+    }
+    float getFlatteningTolerance() { return _flatteningTolerance; }
+    
+    //! round caps pick their segment count from the stroke radius so the rim stays within this tolerance, in points.
+    void setCapTolerance(float tolerance)
+    {
+        _capTolerance = tolerance;
+        for (auto &pipeline : _pipelines) {
+            pipeline->getTessellator().setCapTolerance(tolerance);
+        }
     }
+    float getCapTolerance() { return _capTolerance; }
     
+    //! vertices adaptive flattening avoided emitting compared to the fixed sample count, since the last reset.
+    size_t getSavedVertexCount()
+    {
+        size_t samples = 0;
+        for (auto &pipeline : _pipelines) {
+            samples += pipeline->getSmoother().getStats().getSavedSamples();
+        }
+        return samples * stroke::StrokeTessellator::VerticesPerSegment;
+    }
+    void resetFlatteningStats()
+    {
+        for (auto &pipeline : _pipelines) {
+            pipeline->getSmoother().resetStats();
+        }
+    }
+    
+    //! stroke width for a pan velocity, filtered against the previous width of the line being drawn if any
     float extractSize(Vec2 velocity)
     {
-        float vel = velocity.getLength();
-        float size = vel / 166.0f;
-        size = clampf(size, 1, 40);
-        
-        if (_lastSize != 0.0) {
-            size = size * 0.8f + _lastSize * 0.2f;
+        if (auto pipeline = findTouch(LineTouchId))
+            return pipeline->extractSize(toStroke(velocity));
+        float size = velocity.getLength() / stroke::StrokePipeline::SpeedPerWidth;
+        return std::min(std::max(size, stroke::StrokePipeline::MinWidth), stroke::StrokePipeline::MaxWidth);
+    }
+    
+    //! Smooths and tessellates on worker threads, one for each finger, so a burst of input points no longer
+    //! stretches the frame; each frame draws the latest meshes the workers have finished. A worker takes the
+    //! flattening and cap settings as they are when it starts. Takes effect from the next stroke.
+    void setThreadedTessellation(bool threaded) { _threaded = threaded; }
+    bool isThreadedTessellation() const { return _threaded; }
+    
+    //! Draws each stroke's ink ahead of the input by its predicted path over this many seconds, as wet ink
+    //! over the canvas that the real points replace on the next frame. Hides about a frame of latency at the
+    //! default of one frame; 0 turns it off. Not predicted with threaded tessellation.
+    void setPredictionHorizon(float seconds)
+    {
+        _predictionHorizon = seconds;
+        for (auto &pipeline : _pipelines) {
+            pipeline->setPredictionHorizon(seconds);
         }
-        _lastSize = size;
-        
-//        CCLOG("extracted size %.2f", size);
-
-        return size;
     }
+    float getPredictionHorizon() const { return _predictionHorizon; }
+    
+    //! Keeps each stroke in progress out of the canvas: its mesh grows by each frame's piece and is drawn
+    //! whole over the tiles, and into them once, on the frame it ends, each tile getting the triangles that
+    //! reach it. The tiles are left alone while the stroke is drawn, and the stroke can still be recolored
+    //! until then. On by default; threaded tessellation draws into the canvas as it goes. Takes effect from
+    //! the next stroke.
+    void setLiveOverlay(bool enable) { _liveOverlay = enable; }
+    bool isLiveOverlay() const { return _liveOverlay; }
+    
+    //! counters and timings of the last frame the renderer finished.
+    const stroke::FrameStats &getFrameStats() const { return _profiler.getLastFrame(); }
     
-    static void triangulateRect(Vec2 A, Vec2 B, Vec2 C, Vec2 D, Color4F color, std::vector<V3F_C4B_T2F> &vertices, std::vector<unsigned short> &indices, float z = 0)
+    TiledCanvas *getCanvas() { return _canvas; }
+    
+    //! every stroke drawn since the last clear, as vectors.
+    const stroke::StrokeModel &getModel() const { return _model; }
+    
+    //! Shows the document at zoom canvas points per document point. The canvas is rasterized again from the
+    //! model on the next frame, so the ink stays sharp rather than being scaled as pixels.
+    void setZoom(float zoom)
     {
-        triangulateRect(A, color, B, color, C, color, D, color, vertices, indices, z);
+        _zoom = zoom;
+        for (auto &pipeline : _pipelines) {
+            pipeline->setModel(&_model, 1 / zoom);
+        }
+        _rasterizePending = true;
+        invalidate();
     }
+    float getZoom() const { return _zoom; }
     
-    static void triangulateRect(Vec2 A, Color4F a, Vec2 B, Color4F b, Vec2 C, Color4F c, Vec2 D, Color4F d, std::vector<V3F_C4B_T2F> &vertices, std::vector<unsigned short> &indices, float z)
+    //! rasterizes the whole canvas again from the model on the next frame.
+    void redraw()
     {
-//        CCLOG("triangulate rect (%.2f %.2f) (%.2f %.2f) (%.2f %.2f) (%.2f %.2f)", A.x, A.y, B.x, B.y, C.x, C.y, D.x, D.y);
-        
-        auto startIndex = vertices.size();
-        
-        vertices.push_back(V3F_C4B_T2F {Vec3 {A.x, A.y, z}, Color4B {a}, Tex2F {}});
-        vertices.push_back(V3F_C4B_T2F {Vec3 {B.x, B.y, z}, Color4B {b}, Tex2F {}});
-        vertices.push_back(V3F_C4B_T2F {Vec3 {C.x, C.y, z}, Color4B {c}, Tex2F {}});
-        vertices.push_back(V3F_C4B_T2F {Vec3 {D.x, D.y, z}, Color4B {d}, Tex2F {}});
-        
-        indices.push_back(startIndex);     //A
-        indices.push_back(startIndex + 1); //B
-        indices.push_back(startIndex + 2); //C
-        
-        indices.push_back(startIndex + 1); //B
-        indices.push_back(startIndex + 2); //C
-        indices.push_back(startIndex + 3); //D
+        _rasterizePending = true;
+        invalidate();
     }
     
-    static void triangulateCircle(CirclePoint circle, Color4F color, float overdraw, std::vector<V3F_C4B_T2F> &vertices, std::vector<unsigned short> &indices, float z = 0)
+    //! Stops the Director's frame loop once the canvas is idle, and starts it again on touch-down, undo, redo,
+    //! zoom or redraw(), so a drawing left on screen costs no frames. On by default; off, the loop runs at its
+    //! animation interval whatever happens.
+    void setOnDemandRendering(bool onDemand)
     {
-        Color4F fadeOutColor = Color4F {};
-//        Color4F fadeOutColor = Color4F {1, 0, 0, .5};
-        
-        int numberOfSegments = 32;
-        float anglePerSegment = (float)(M_PI / (numberOfSegments - 1));
-        
-        //! we need to cover M_PI from this, dot product of normalized vectors is equal to cos angle between them... and if you include rightVec dot you get to know the correct direction :)
-        Vec2 perp = circle.dir.getPerp();
-        
-        float angle = acosf(perp.dot(Vec2 {0, 1}));
-        const float rightDot = perp.dot(Vec2 {1, 0});
-        if (rightDot < 0.0f) {
-            angle *= -1;
+        _redrawPolicy.setOnDemand(onDemand);
+        invalidate();
+    }
+    bool isOnDemandRendering() const { return _redrawPolicy.isOnDemand(); }
+    
+    //! frames drawn, wakeups and the share of the time the frame loop ran, since the last reset
+    stroke::RedrawPolicy::Stats getRedrawStats() const { return _redrawPolicy.getStats(); }
+    void resetRedrawStats() { _redrawPolicy.resetStats(); }
+    
+    //! frames that added no ink and left the canvas untouched.
+    uint64_t getSkippedFrameCount() const { return _skippedFrames; }
+    
+    //! writes every following frame to path as Chrome trace event JSON, for about://tracing or Perfetto.
+    //! An empty path stops tracing.
+    bool setTraceOutput(const std::string &path)
+    {
+        if (path.empty()) {
+            _profiler.closeTrace();
+            return true;
         }
-        
-        const float radius = circle.width * .5;
-        const unsigned short centerIndex = vertices.size();
-        
-        vertices.push_back(V3F_C4B_T2F {Vec3 {circle.pos.x, circle.pos.y, z}, Color4B {color}, Tex2F {}});
-        
-        int prevIndex;
-        Vec2 prevPoint, prevDir;
-        for (unsigned int i = 0; i < numberOfSegments; ++i) {
-            Vec2 dir = Vec2 {sinf(angle), cosf(angle)};
-            Vec2 curPoint = Vec2 {circle.pos.x + radius * dir.x, circle.pos.y + radius * dir.y};
-            
-            int currentIndex = vertices.size();
-            vertices.push_back(V3F_C4B_T2F {Vec3 {curPoint.x, curPoint.y, z}, Color4B {color}, Tex2F {}});
-            
-            if (i > 0) {
-                indices.push_back(centerIndex);
-                indices.push_back(prevIndex);
-                indices.push_back(currentIndex);
-                
-//                CCLOG("circle %d %lu %lu", centerIndex, vertices.size() - 2, vertices.size() - 1);
-                
-                // triangulate a overdrawn rect
-                Vec2 prevOverdrawnPoint = prevPoint + prevDir * overdraw;
-                Vec2 currentOverdrawnPoint = curPoint + dir * overdraw;
-                
-                auto prevOverdrawIndex = vertices.size();
-                vertices.push_back(V3F_C4B_T2F {Vec3 {prevOverdrawnPoint.x, prevOverdrawnPoint.y, z}, Color4B {fadeOutColor}, Tex2F {}});
-                
-                auto curOverdrawIndex = vertices.size();
-                vertices.push_back(V3F_C4B_T2F {Vec3 {currentOverdrawnPoint.x, currentOverdrawnPoint.y, z}, Color4B {fadeOutColor}, Tex2F {}});
-                
-                indices.push_back(prevIndex);
-                indices.push_back(curOverdrawIndex);
-                indices.push_back(prevOverdrawIndex);
-                
-                indices.push_back(prevIndex);
-                indices.push_back(currentIndex);
-                indices.push_back(curOverdrawIndex);
-            }
-            
-            
-            prevIndex = currentIndex;
-            prevPoint = curPoint;
-            prevDir = dir;
-            angle += anglePerSegment;
+        return _profiler.openTrace(path.c_str());
+    }
+    
+    //! records every pan sample of the following strokes, with its width, to path as a stroke log that
+    //! stroke::StrokeLogReader reads back. Strokes in progress carry on as new strokes of the log. An empty
+    //! path stops recording and writes the log's index.
+    bool setStrokeLog(const std::string &path)
+    {
+        for (auto &pipeline : _touchPipelines) {
+            pipeline.second->setLog(nullptr);
         }
-
+        _strokeLog.close();
+        if (path.empty())
+            return true;
+        if (!_strokeLog.open(path.c_str()))
+            return false;
+        for (auto &pipeline : _touchPipelines) {
+            pipeline.second->setLog(&_strokeLog);
+        }
+        return true;
     }
     
     virtual void draw(Renderer *renderer, const Mat4 &transform, uint32_t flags)
     {
-        _renderTexture->begin();
+        _profiler.beginFrame();
+        _canvas->beginFrame();
+        
+        //! nothing new to ink: the canvas tiles keep their pixels and composite them as they are
+        bool drawn = drawStrokes();
+        if (auto wetInk = predictStrokes())
+            _inkOverlay->addMesh(*wetInk, InkColor);
+        if (!drawn && !_rasterizePending && !_redoQueued) {
+            _skippedFrames++;
+            _profiler.endFrame();
+            endHistoryEntry(renderer);
+            scheduleNextFrame();
+            Node::draw(renderer, transform, flags);
+            return;
+        }
         
-        setGLProgramState(GLProgramState::getOrCreateWithGLProgramName(GLProgram::SHADER_NAME_POSITION_COLOR));
-        if (_points.size() > 2) {
-            Color4F brushColor {0, 0, 0, 1};
-            if (_enableLineSmoothing) {
-                auto smoothPoints = smoothLinePoints(_points);
-                drawLines(renderer, transform, smoothPoints, brushColor);
-            }
-            else {
-                drawLines(renderer, transform, _points, brushColor);
+        _renderTextureBeginCommand.init(getGlobalZOrder());
+        renderer->addCommand(&_renderTextureBeginCommand);
+        
+        _profiler.begin(stroke::FrameStats::Submission);
+        if (_rasterizePending) {
+            //! the model already has the points of this frame's mesh
+            _canvas->rasterize(renderer, getGlobalZOrder(), _model, _zoom, InkColor);
+            _rasterizePending = false;
+            _redoQueued = false;
+        }
+        else {
+            if (_redoQueued) {
+                _canvas->drawMesh(renderer, getGlobalZOrder(), _redoMesh, InkColor);
+                _redoQueued = false;
             }
-            _points.erase(_points.begin(), _points.end() - 2);
+            if (drawn)
+                _canvas->drawMesh(renderer, getGlobalZOrder(), *_frameMesh, InkColor);
         }
+        _profiler.end(stroke::FrameStats::Submission);
         
-        _renderTexture->end();
+        _renderTextureEndCommand.init(getGlobalZOrder());
+        renderer->addCommand(&_renderTextureEndCommand);
+        endHistoryEntry(renderer);
+        scheduleNextFrame();
         
         Node::draw(renderer, transform, flags);
     }
 
-    void drawLines(Renderer *renderer, const Mat4 &transform, std::vector<LinePoint> &linePoints, Color4F color)
+private:
+    //! A pipeline for a new stroke under touchId. The first stroke of a gesture opens the history entry,
+    //! strokes begun while other fingers are still down join it.
+    stroke::StrokePipeline &beginTouch(int touchId)
     {
-        const Color4F fadeOutColor {0, 0, 0, 0};
-        
-        LinePoint &prevPoint = linePoints[0];
-        
-        _vertices.clear();
-        _indices.clear();
-        
-        std::vector<CirclePoint> circles;
-        
-        for (int i = 1; i < linePoints.size(); i++) {
-            auto curPoint = linePoints[i];
-            
-            if (curPoint.pos.fuzzyEquals(prevPoint.pos, 0.0001f)) {
-                continue;
-            }
-            
-            Vec2 dir = curPoint.pos - prevPoint.pos;
-            Vec2 perp = dir.getPerp().getNormalized();
-            Vec2 A = prevPoint.pos + perp * prevPoint.width / 2;
-            Vec2 B = prevPoint.pos - perp * prevPoint.width / 2;
-            Vec2 C = curPoint.pos + perp * curPoint.width / 2;
-            Vec2 D = curPoint.pos - perp * curPoint.width / 2;
-            
-            if (_connectingLine || _indices.size() > 0) {
-                A = _prevC;
-                B = _prevD;
-            } else if (_indices.size() == 0) {
-                circles.push_back(CirclePoint {curPoint.pos, curPoint.width, (linePoints[i - 1].pos - curPoint.pos).getNormalized()});
-            }
-            
-            triangulateRect(A, B, C, D, color, _vertices, _indices);
-            
-            _prevD = D;
-            _prevC = C;
-            if (_finishingLine && (i == linePoints.size() - 1)) {
-                circles.push_back(CirclePoint {curPoint.pos, curPoint.width, (curPoint.pos - linePoints[i - 1].pos).getNormalized()});
-                _finishingLine = false;
-            }
-            
-            prevPoint = curPoint;
-            
-            //! Add overdraw
-            Vec2 F = A + perp * Overdraw;
-            Vec2 G = C + perp * Overdraw;
-            Vec2 H = B - perp * Overdraw;
-            Vec2 I = D - perp * Overdraw;
-            
-            if (_connectingLine || _indices.size() > 6) {
-                F = _prevG;
-                H = _prevI;
-            }
-            _prevG = G;
-            _prevI = I;
-            
-            triangulateRect(F, fadeOutColor, A, color, G, fadeOutColor, C, color, _vertices, _indices, 0);
-            triangulateRect(B, color, H, fadeOutColor, D, color, I, fadeOutColor, _vertices, _indices, 0);
+        if (findTouch(touchId))
+            endTouch(touchId);
+        if (!_entryOpen) {
+            _canvas->beginHistoryEntry();
+            _entryOpen = true;
         }
+        _canvas->addHistoryStroke();
+        _strokeEnding = false;
         
-        for (auto c : circles) {
-            triangulateCircle(c, color, Overdraw, _vertices, _indices);
+        stroke::StrokePipeline *pipeline;
+        if (!_freePipelines.empty()) {
+            pipeline = _freePipelines.back();
+            _freePipelines.pop_back();
         }
-        
-        TrianglesCommand::Triangles trs{&_vertices[0], &_indices[0], static_cast<ssize_t>(_vertices.size()), static_cast<ssize_t>(_indices.size())};
-        _triangleCommand.init(getGlobalZOrder(), 0, getGLProgramState(), cocos2d::BlendFunc::ALPHA_PREMULTIPLIED, trs, transform, 0);
-        renderer->addCommand(&_triangleCommand);
-        
-        if (_indices.size() > 0) {
-            _connectingLine = true;
+        else {
+            _pipelines.emplace_back(new stroke::StrokePipeline);
+            pipeline = _pipelines.back().get();
+            pipeline->setProfiler(&_profiler);
         }
-        
+        pipeline->getSmoother().setFlattening(_flattening);
+        pipeline->getSmoother().setFlatteningTolerance(_flatteningTolerance);
+        pipeline->getTessellator().setCapTolerance(_capTolerance);
+        pipeline->setThreaded(_threaded);
+        pipeline->setPredictionHorizon(_predictionHorizon);
+        pipeline->setRetainStroke(_liveOverlay);
+        pipeline->setModel(&_model, 1 / _zoom);
+        pipeline->setLog(_strokeLog.isOpen() ? &_strokeLog : nullptr);
+        _touchPipelines[touchId] = pipeline;
+        return *pipeline;
     }
     
-    static std::vector<LinePoint> smoothLinePoints(std::vector<LinePoint> &linePoints)
+    stroke::StrokePipeline *findTouch(int touchId)
     {
-        std::vector<LinePoint> result;
-        
-        if (linePoints.size() > 2) {
-            for (unsigned int i = 2; i < linePoints.size(); ++i) {
-                auto prev2 = linePoints[i - 2];
-                auto prev1 = linePoints[i - 1];
-                auto cur = linePoints[i];
-                
-                Vec2 midPoint1 = (prev1.pos + prev2.pos) * .5;
-                Vec2 midPoint2 = (cur.pos + prev1.pos) * .5;
-                
-                int segmentDistance = 2;
-                float distance = (midPoint1 - midPoint2).getLength();
-                int numberOfSegments = MIN(128, MAX(floorf(distance / segmentDistance), 32));
-                
-                float t = 0.0f;
-                float step = 1.0f / numberOfSegments;
-                for (int j = 0; j < numberOfSegments; j++) {
-                    LinePoint newPoint;
-                    newPoint.pos = midPoint1 * powf(1 - t, 2) + prev1.pos * 2.0f * (1 - t) * t + midPoint2 * t * t;
-                    newPoint.width = powf(1 - t, 2) * ((prev1.width + prev2.width) * 0.5f) + 2.0f * (1 - t) * t * prev1.width + t * t * ((cur.width + prev1.width) * 0.5f);
-                    
-                    result.push_back(newPoint);
-                    t += step;
-                }
-                LinePoint finalPoint;
-                finalPoint.pos = midPoint2;
-                finalPoint.width = (cur.width + prev1.width) * 0.5f;
-                result.push_back(finalPoint);
-            }
-
+        auto touch = _touchPipelines.find(touchId);
+        return touch != _touchPipelines.end() ? touch->second : nullptr;
+    }
+    
+    //! the pipeline is drawn once more on the next frame, for the end of its stroke, then reused
+    void endTouch(int touchId)
+    {
+        auto touch = _touchPipelines.find(touchId);
+        _endingPipelines.push_back(touch->second);
+        _touchPipelines.erase(touch);
+        if (_touchPipelines.empty())
+            _strokeEnding = true;
+    }
+    
+    //! a stroke drawn whole over the canvas until it ends, rather than into it frame by frame
+    static bool isLive(const stroke::StrokePipeline &pipeline) { return pipeline.isRetainStroke() && !pipeline.isThreaded(); }
+    
+    //! Draws the frame of every stroke in progress into one mesh, so any number of fingers cost the canvas a
+    //! single drawMesh() and one pass per tile. The canvas routes it by triangle, so each finger's ink goes to
+    //! its own tiles rather than those between the fingers. Live strokes go to the overlay instead, and into the canvas
+    //! whole on the frame they end. The frame a stroke ends on waits for its worker thread's last mesh, so the
+    //! history entry has all its tiles.
+    bool drawStrokes()
+    {
+        _drawnMeshes.clear();
+        for (auto &touch : _touchPipelines) {
+            auto &pipeline = *touch.second;
+            bool drawn = pipeline.drawFrame();
+            if (isLive(pipeline))
+                _inkOverlay->addMesh(pipeline.getMesh(), InkColor);
+            else if (drawn)
+                _drawnMeshes.push_back(&pipeline.getMesh());
+        }
+        for (auto pipeline : _endingPipelines) {
+            bool drawn = pipeline->drawFrame(true);
+            if ((drawn || isLive(*pipeline)) && !pipeline->getMesh().empty())
+                _drawnMeshes.push_back(&pipeline->getMesh());
+            _freePipelines.push_back(pipeline);
         }
+        _endingPipelines.clear();
         
-        return result;
+        if (_drawnMeshes.size() == 1) {
+            _frameMesh = _drawnMeshes.front();
+            return true;
+        }
+        _combinedMesh.clear();
+        for (auto mesh : _drawnMeshes) {
+            _combinedMesh.append(*mesh);
+        }
+        _frameMesh = &_combinedMesh;
+        return !_drawnMeshes.empty();
     }
     
-private:
-    std::vector<LinePoint> _points;
-    bool _connectingLine, _finishingLine;
-    Vec2 _prevC, _prevD, _prevG, _prevI;
-    bool _enableLineSmoothing;
+    //! the wet ink of every stroke in progress, as one mesh; nullptr if there is none
+    const stroke::StrokeMesh *predictStrokes()
+    {
+        _predictedMeshes.clear();
+        for (auto &touch : _touchPipelines) {
+            if (!touch.second->getPredictionMesh().empty())
+                _predictedMeshes.push_back(&touch.second->getPredictionMesh());
+        }
+        if (_predictedMeshes.size() <= 1)
+            return _predictedMeshes.empty() ? nullptr : _predictedMeshes.front();
+        _predictionMesh.clear();
+        for (auto mesh : _predictedMeshes) {
+            _predictionMesh.append(*mesh);
+        }
+        return &_predictionMesh;
+    }
     
-    PanGestureRecognizer *_panGestureRecognizer;
+    //! the history entry of a gesture closes once the frame with the last points of its last stroke has been drawn
+    void endHistoryEntry(Renderer *renderer)
+    {
+        if (_strokeEnding) {
+            _canvas->endHistoryEntry(renderer, getGlobalZOrder());
+            _strokeEnding = false;
+            _entryOpen = false;
+        }
+    }
+    
+    //! starts the frame loop if it was stopped, for a change made outside of a frame
+    void invalidate()
+    {
+        if (_redrawPolicy.invalidate())
+            Director::getInstance()->startAnimation();
+    }
+    
+    //! Stops the frame loop after this frame once there is nothing left to draw: no finger down, no stroke
+    //! ending or on a worker thread, no history entry, redo or rasterization waiting for a frame.
+    void scheduleNextFrame()
+    {
+        bool busy = !_touchPipelines.empty() || !_endingPipelines.empty() || _entryOpen || _redoQueued || _rasterizePending;
+        for (auto &pipeline : _pipelines) {
+            busy = busy || !pipeline->isIdle();
+        }
+        if (!_redrawPolicy.frameDrawn(busy))
+            Director::getInstance()->stopAnimation();
+    }
+    
+    MultiPanGestureRecognizer *_panGestureRecognizer;
     LongPressGestureRecognizer *_longPressGestureRecognizer;
     
-    TrianglesCommand _triangleCommand;
+    //! every pipeline made so far, each drawing one stroke at a time: those of the fingers down, by touch id,
+    //! those whose stroke ended since the last frame, and the free ones
+    std::vector<std::unique_ptr<stroke::StrokePipeline>> _pipelines;
+    std::map<int, stroke::StrokePipeline *> _touchPipelines;
+    std::vector<stroke::StrokePipeline *> _endingPipelines, _freePipelines;
+    //! the meshes drawn this frame, and the one mesh the canvas draws them as
+    std::vector<const stroke::StrokeMesh *> _drawnMeshes;
+    stroke::StrokeMesh _combinedMesh;
+    const stroke::StrokeMesh *_frameMesh;
+    std::vector<const stroke::StrokeMesh *> _predictedMeshes;
+    stroke::StrokeMesh _predictionMesh;
+    stroke::StrokeSmoother::Flattening _flattening;
+    float _flatteningTolerance;
+    float _capTolerance;
+    float _predictionHorizon;
+    bool _liveOverlay;
+    bool _threaded;
+    
+    TiledCanvas *_canvas;
+    InkOverlay *_inkOverlay;
+    stroke::StrokeModel _model;
+    float _zoom;
+    bool _rasterizePending;
     
-    std::vector<V3F_C4B_T2F> _vertices;
-    std::vector<unsigned short> _indices;
+    //! between the first finger of a gesture coming down and the frame its last stroke ends on
+    bool _entryOpen;
+    bool _strokeEnding;
+    //! strokes redone since the last frame, drawn on the next one
+    stroke::StrokeRasterizer _rasterizer;
+    stroke::StrokeMesh _strokeMesh, _redoMesh;
+    bool _redoQueued;
+    bool _ctrlDown, _shiftDown;
+    uint64_t _skippedFrames;
+    stroke::RedrawPolicy _redrawPolicy;
     
-    RenderTexture *_renderTexture;
-    float _lastSize;
+    stroke::FrameProfiler _profiler;
+    stroke::StrokeLogWriter _strokeLog;
+    CustomCommand _renderTextureBeginCommand, _renderTextureEndCommand;
 
 };
 
@@ -0,0 +1,43 @@
+//
+//  FrameProfiler.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "FrameProfiler.hpp"
+
+namespace stroke {
+
+const char *FrameStats::getPhaseName(Phase phase)
+{
+    static const char *const Names[PhaseCount] = {"smoothing", "tessellation", "submission", "render texture"};
+    return phase < PhaseCount ? Names[phase] : "unknown";
+}
+
+void FrameProfiler::beginFrame()
+{
+    _current = FrameStats {};
+    _current.frame = ++_frameCount;
+}
+
+void FrameProfiler::end(FrameStats::Phase phase)
+{
+    auto now = TraceWriter::Clock::now();
+    _current.micros[phase] += std::chrono::duration<double, std::micro>(now - _phaseStart[phase]).count();
+    _trace.complete(FrameStats::getPhaseName(phase), _phaseStart[phase], now);
+}
+
+void FrameProfiler::endFrame()
+{
+    _last = _current;
+
+    if (_trace.isOpen()) {
+        static const char *const Keys[] = {"raw points", "smoothed points", "vertices", "indices", "dirty area"};
+        const double values[] = {(double)_current.rawPoints, (double)_current.smoothedPoints, (double)_current.vertices, (double)_current.indices, (double)_current.dirtyArea};
+        _trace.counter("geometry", TraceWriter::Clock::now(), Keys, values, 5);
+    }
+}
+
+}
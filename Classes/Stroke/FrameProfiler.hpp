@@ -0,0 +1,79 @@
+//
+//  FrameProfiler.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef FrameProfiler_hpp
+#define FrameProfiler_hpp
+
+#include <stddef.h>
+#include <stdint.h>
+#include "TraceWriter.hpp"
+
+namespace stroke {
+
+//! Where a frame of stroke drawing spends its time, and how much geometry it produced.
+struct FrameStats {
+    enum Phase {
+        Smoothing,
+        Tessellation,
+        //! queueing the render commands for the frame
+        Submission,
+        //! the render texture pass as the renderer executes it: begin, stroke buffer upload and draw, end
+        RenderTexture,
+        PhaseCount
+    };
+
+    uint64_t frame;
+    //! input points handed to the smoother (or the tessellator, without smoothing)
+    size_t rawPoints;
+    size_t smoothedPoints;
+    size_t vertices;
+    size_t indices;
+    size_t batches;
+    //! area of the frame's dirty rectangle in points, 0 when the frame added no ink and skipped the render texture
+    float dirtyArea;
+    double micros[PhaseCount];
+
+    static const char *getPhaseName(Phase phase);
+};
+
+//! Collects FrameStats for the frame being drawn and, while a trace is open, writes every phase as a trace
+//! slice and the geometry counts as trace counters. Phases are measured between begin() and end(), which
+//! may come from render command callbacks after the frame's draw call has returned; endFrame() then
+//! publishes the frame.
+class FrameProfiler {
+
+public:
+    FrameProfiler () : _frameCount(0), _current {}, _last {}, _phaseStart {} {}
+
+    void beginFrame();
+    void endFrame();
+
+    void begin(FrameStats::Phase phase) { _phaseStart[phase] = TraceWriter::Clock::now(); }
+    void end(FrameStats::Phase phase);
+
+    //! the frame being collected, for the geometry counts.
+    FrameStats &current() { return _current; }
+
+    //! the last frame endFrame() completed.
+    const FrameStats &getLastFrame() const { return _last; }
+
+    bool openTrace(const char *path) { return _trace.open(path); }
+    void closeTrace() { _trace.close(); }
+    TraceWriter &getTrace() { return _trace; }
+
+private:
+    uint64_t _frameCount;
+    FrameStats _current, _last;
+    TraceWriter::Clock::time_point _phaseStart[FrameStats::PhaseCount];
+    TraceWriter _trace;
+
+};
+
+}
+
+#endif /* FrameProfiler_hpp */
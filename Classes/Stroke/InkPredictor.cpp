@@ -0,0 +1,67 @@
+//
+//  InkPredictor.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "InkPredictor.hpp"
+
+namespace stroke {
+
+constexpr float InkPredictor::DefaultHorizon;
+constexpr int InkPredictor::Steps;
+constexpr float InkPredictor::AccelerationSmoothing;
+
+//! below this speed, in points per second, the pen is resting and there is nothing worth predicting
+static const float MinSpeed = 10.0f;
+
+void InkPredictor::addSample(Vec2 location, Vec2 velocity, time_point timestamp)
+{
+    float seconds = std::chrono::duration<float>(timestamp - _timestamp).count();
+    //! samples delivered together carry no acceleration
+    if (_sampleCount > 0 && seconds > 0) {
+        Vec2 acceleration = (velocity - _velocity) * (1 / seconds);
+        _acceleration = _acceleration * (1 - AccelerationSmoothing) + acceleration * AccelerationSmoothing;
+    }
+    _location = location;
+    _velocity = velocity;
+    _timestamp = timestamp;
+    _sampleCount++;
+}
+
+bool InkPredictor::canPredict() const
+{
+    return _sampleCount >= 2 && _horizon > 0 && _velocity.getLength() >= MinSpeed;
+}
+
+//! The acceleration can change the velocity by at most its own length over the horizon, so the path bends
+//! and slows but never turns back on itself.
+Vec2 InkPredictor::locationAt(float seconds) const
+{
+    Vec2 acceleration = _acceleration;
+    float limit = _velocity.getLength() / _horizon;
+    float length = acceleration.getLength();
+    if (length > limit)
+        acceleration *= limit / length;
+    return _location + _velocity * seconds + acceleration * (seconds * seconds * .5f);
+}
+
+void InkPredictor::predict(float width, std::vector<LinePoint> &points) const
+{
+    points.clear();
+    if (!canPredict())
+        return;
+
+    for (int step = 1; step <= Steps; ++step) {
+        points.push_back(LinePoint {locationAt(_horizon * step / Steps), width});
+    }
+}
+
+Vec2 InkPredictor::predictLocation() const
+{
+    return canPredict() ? locationAt(_horizon) : _location;
+}
+
+}
@@ -0,0 +1,71 @@
+//
+//  InkPredictor.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef InkPredictor_hpp
+#define InkPredictor_hpp
+
+#include <vector>
+#include "StrokeTypes.hpp"
+#include "VelocityCalculator.hpp"
+
+namespace stroke {
+
+//! Where the pen is going next: extrapolates the last pan location along the pan velocity and the
+//! acceleration seen between the velocities of the recent samples, so the ink can be drawn ahead of the input
+//! it has. The acceleration is low pass filtered and never allowed to turn the stroke around within the
+//! horizon, since a wrong guess shows as a hook at the tip.
+class InkPredictor {
+
+public:
+    using time_point = VelocityCalculator::time_point;
+
+    //! a frame at 60 Hz
+    static constexpr float DefaultHorizon = 1 / 60.0f;
+    //! points the predicted path is sampled at
+    static constexpr int Steps = 4;
+    //! the new acceleration's share of the filtered one
+    static constexpr float AccelerationSmoothing = 0.5f;
+
+public:
+    InkPredictor () : _horizon(DefaultHorizon) { reset(); }
+
+    //! how far ahead of the last sample to predict, in seconds; 0 predicts nothing.
+    void setHorizon(float seconds) { _horizon = seconds > 0 ? seconds : 0; }
+    float getHorizon() const { return _horizon; }
+
+    void reset()
+    {
+        _sampleCount = 0;
+        _acceleration = Vec2 {0, 0};
+    }
+
+    //! a pan location with its velocity in points per second, stamped with the time of the touch.
+    void addSample(Vec2 location, Vec2 velocity, time_point timestamp);
+
+    //! Replaces points with the predicted path after the last sample, of the given width, excluding the
+    //! sample itself. Empty until there are two samples, or when the pen is barely moving.
+    void predict(float width, std::vector<LinePoint> &points) const;
+
+    //! where the path ends, or the last location if nothing is predicted
+    Vec2 predictLocation() const;
+
+private:
+    bool canPredict() const;
+    Vec2 locationAt(float seconds) const;
+
+private:
+    float _horizon;
+    int _sampleCount;
+    Vec2 _location, _velocity, _acceleration;
+    time_point _timestamp;
+
+};
+
+}
+
+#endif /* InkPredictor_hpp */
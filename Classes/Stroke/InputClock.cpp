@@ -0,0 +1,62 @@
+//
+//  InputClock.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "InputClock.hpp"
+
+namespace stroke {
+
+constexpr float InputClock::SameLocation;
+
+InputClock::time_point InputClock::_eventTime;
+bool InputClock::_hasEvent = false;
+std::vector<std::vector<InputSample>> InputClock::_touchSamples;
+size_t InputClock::_touchCount = 0;
+
+void InputClock::beginEvent(time_point timestamp)
+{
+    _eventTime = timestamp;
+    _hasEvent = true;
+}
+
+void InputClock::beginEvent(double ageSeconds)
+{
+    //! a timestamp from the future, on a clock that drifted, is taken as now
+    auto age = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(ageSeconds > 0 ? ageSeconds : 0));
+    beginEvent(clock::now() - age);
+}
+
+void InputClock::endEvent()
+{
+    _hasEvent = false;
+    _touchCount = 0;
+}
+
+void InputClock::addSamples(const InputSample *samples, size_t count)
+{
+    if (count == 0)
+        return;
+    if (_touchCount == _touchSamples.size())
+        _touchSamples.emplace_back();
+    _touchSamples[_touchCount++].assign(samples, samples + count);
+}
+
+const std::vector<InputSample> *InputClock::getSamples(Vec2 location)
+{
+    for (size_t i = 0; i < _touchCount; ++i) {
+        if ((_touchSamples[i].back().location - location).getLengthSq() <= SameLocation * SameLocation)
+            return &_touchSamples[i];
+    }
+    return nullptr;
+}
+
+InputClock::time_point InputClock::getEventTime()
+{
+    return _hasEvent ? _eventTime : clock::now();
+}
+
+}
@@ -0,0 +1,73 @@
+//
+//  InputClock.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef InputClock_hpp
+#define InputClock_hpp
+
+#include <chrono>
+#include <vector>
+#include "StrokeTypes.hpp"
+
+namespace stroke {
+
+//! a touch location and the time it was there, in the coordinates the touch is delivered in
+struct InputSample {
+    Vec2 location;
+    std::chrono::steady_clock::time_point timestamp;
+};
+
+//! The time input events happened, rather than when their callbacks run. Touches reach the gesture
+//! recognizers through cocos2d, which drops the platform's timestamps; the platform code that hands an
+//! event to cocos2d brackets the call with beginEvent() and endEvent(), and the recognizers read the
+//! event's time back with getEventTime(). Without a platform timestamp the time is taken on the spot.
+//!
+//! Platforms that sample touches faster than they deliver events coalesce the samples in between into the
+//! event: the platform code adds them with addSamples(), and the recognizers take them all rather than
+//! the touch's one location.
+//!
+//! Events are dispatched on the thread that runs the frame loop, so one event is current at a time.
+class InputClock {
+
+public:
+    using clock = std::chrono::steady_clock;
+    using time_point = clock::time_point;
+
+public:
+    //! the event being dispatched happened at timestamp
+    static void beginEvent(time_point timestamp);
+    //! the event being dispatched happened ageSeconds before now, for platform timestamps on another clock
+    static void beginEvent(double ageSeconds);
+    //! Ends the event, and drops its samples.
+    static void endEvent();
+
+    //! The samples of one touch of the event being dispatched, oldest first and ending at the location the
+    //! touch is delivered with, in its coordinates.
+    static void addSamples(const InputSample *samples, size_t count);
+    //! the samples of the event's touch at location, or nullptr if the platform added none
+    static const std::vector<InputSample> *getSamples(Vec2 location);
+
+    //! the time of the event being dispatched, or now between events
+    static time_point getEventTime();
+    //! whether getEventTime() has a platform timestamp
+    static bool hasEventTime() { return _hasEvent; }
+
+private:
+    //! within this of a touch's location, in points, samples are taken to end at it
+    static constexpr float SameLocation = 0.01f;
+
+    static time_point _eventTime;
+    static bool _hasEvent;
+    //! the samples of the event's touches, the first _touchCount of them; kept, to be reused
+    static std::vector<std::vector<InputSample>> _touchSamples;
+    static size_t _touchCount;
+
+};
+
+}
+
+#endif /* InputClock_hpp */
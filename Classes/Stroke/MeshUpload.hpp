@@ -0,0 +1,89 @@
+//
+//  MeshUpload.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef MeshUpload_hpp
+#define MeshUpload_hpp
+
+#include <algorithm>
+#include "StrokeMesh.hpp"
+
+namespace stroke {
+
+//! What of a mesh has to go to a vertex and index buffer pair kept across frames. A mesh that only grows
+//! between clear()s, such as a live stroke's, uploads just the vertices and indices appended since the last
+//! frame, so the bytes a frame uploads follow what the stroke added, not its length. The buffers grow by
+//! doubling, the only time a grown mesh goes up whole again. Another mesh, or one cleared since, goes up
+//! whole into the buffers as they are.
+class MeshUpload {
+
+public:
+    //! elements of a buffer, from start
+    struct Range {
+        size_t start;
+        size_t count;
+    };
+
+public:
+    MeshUpload () : _mesh(nullptr), _generation(0), _vertexCount(0), _indexCount(0), _vertexCapacity(0), _indexCapacity(0),
+      _vertexRange {0, 0}, _indexRange {0, 0}, _vertexResized(false), _indexResized(false) {}
+
+    //! Works out the ranges of mesh to upload this frame, taking them as uploaded from then on.
+    void update(const StrokeMesh &mesh)
+    {
+        auto vertices = mesh.getVertices().size();
+        auto indices = mesh.getIndices().size();
+        if (&mesh != _mesh || mesh.getGeneration() != _generation || vertices < _vertexCount || indices < _indexCount) {
+            _mesh = &mesh;
+            _generation = mesh.getGeneration();
+            _vertexCount = 0;
+            _indexCount = 0;
+        }
+
+        _vertexResized = grow(vertices, _vertexCapacity, _vertexCount);
+        _indexResized = grow(indices, _indexCapacity, _indexCount);
+        _vertexRange = Range {_vertexCount, vertices - _vertexCount};
+        _indexRange = Range {_indexCount, indices - _indexCount};
+        _vertexCount = vertices;
+        _indexCount = indices;
+    }
+
+    const Range &getVertexRange() const { return _vertexRange; }
+    const Range &getIndexRange() const { return _indexRange; }
+    //! whether the buffer has to be reallocated at its capacity before the range goes into it
+    bool isVertexBufferResized() const { return _vertexResized; }
+    bool isIndexBufferResized() const { return _indexResized; }
+    size_t getVertexCapacity() const { return _vertexCapacity; }
+    size_t getIndexCapacity() const { return _indexCapacity; }
+
+    //! what the last update() uploads
+    size_t getUploadBytes() const { return _vertexRange.count * sizeof(Vertex) + _indexRange.count * sizeof(unsigned short); }
+
+private:
+    //! doubles capacity when size outgrows it, which loses what was uploaded
+    static bool grow(size_t size, size_t &capacity, size_t &uploaded)
+    {
+        if (size <= capacity)
+            return false;
+        capacity = std::max(size, capacity * 2);
+        uploaded = 0;
+        return true;
+    }
+
+private:
+    const StrokeMesh *_mesh;
+    size_t _generation;
+    size_t _vertexCount, _indexCount;
+    size_t _vertexCapacity, _indexCapacity;
+    Range _vertexRange, _indexRange;
+    bool _vertexResized, _indexResized;
+
+};
+
+}
+
+#endif /* MeshUpload_hpp */
@@ -0,0 +1,15 @@
+//
+//  PanTracker.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "PanTracker.hpp"
+
+namespace stroke {
+
+constexpr float PanTracker::MinPanDistance;
+
+}
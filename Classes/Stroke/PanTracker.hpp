@@ -0,0 +1,113 @@
+//
+//  PanTracker.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef PanTracker_hpp
+#define PanTracker_hpp
+
+#include <vector>
+#include "StrokeTypes.hpp"
+#include "InputClock.hpp"
+#include "VelocityCalculator.hpp"
+
+namespace stroke {
+
+//! a location of a pan with the velocity there and the time it was there
+struct PanSample {
+    Vec2 location;
+    Vec2 velocity;
+    std::chrono::steady_clock::time_point timestamp;
+};
+
+//! The pan gesture state machine of PanGestureRecognizer, without cocos2d touches or callbacks: a touch
+//! becomes a pan once it has moved MinPanDistance from where it began. Each touch call returns whether the
+//! recognizer's target should be notified of the new state.
+//!
+//! A move can bring several samples, coalesced by the platform into one event. The state changes once per
+//! event, and getSamples() has every sample of the event from the one the pan began at, each with the
+//! velocity up to it.
+class PanTracker {
+
+public:
+    //! same values as BasicGestureRecognizer::State
+    enum State { Possible, Began, Changed, Completed, Failed };
+
+    static constexpr float MinPanDistance = 5.0f;
+
+    using time_point = VelocityCalculator::time_point;
+
+public:
+    PanTracker () : _state(Possible) {}
+
+    void touchBegan(Vec2 location, time_point timestamp)
+    {
+        _location = location;
+        _timestamp = timestamp;
+        _velocityCalc.reset();
+        _velocityCalc.addLocation(location, timestamp);
+        _beganLocation = location;
+        _state = Possible;
+    }
+
+    bool touchMoved(Vec2 location, time_point timestamp)
+    {
+        InputSample sample {location, timestamp};
+        return touchMoved(&sample, 1);
+    }
+
+    //! the samples of one move event, oldest first
+    bool touchMoved(const InputSample *samples, size_t count)
+    {
+        _samples.clear();
+        State state = _state == Began ? Changed : _state;
+        for (size_t i = 0; i < count; ++i) {
+            _velocityCalc.addLocation(samples[i].location, samples[i].timestamp);
+            _location = samples[i].location;
+            _timestamp = samples[i].timestamp;
+
+            if (state == Possible) {
+                if ((_location - _beganLocation).getLength() <= MinPanDistance)
+                    continue;
+                state = Began;
+            }
+            _samples.push_back(PanSample {_location, _velocityCalc.getVelocity(), _timestamp});
+        }
+        _state = state;
+
+        return _state == Began || _state == Changed;
+    }
+
+    bool touchEnded(Vec2 location)
+    {
+        _location = location;
+        if (_state == Changed) {
+            _state = Completed;
+            return true;
+        }
+        return false;
+    }
+
+    State getState() const { return _state; }
+    Vec2 getLocation() const { return _location; }
+    //! of the last touch that moved, or began
+    time_point getTimestamp() const { return _timestamp; }
+    Vec2 getVelocity() { return _velocityCalc.getVelocity(); }
+    //! the samples of the last move that notified, oldest first; the last is getLocation() and getVelocity()
+    const std::vector<PanSample> &getSamples() const { return _samples; }
+
+private:
+    State _state;
+    Vec2 _location, _beganLocation;
+    time_point _timestamp;
+    VelocityCalculator _velocityCalc;
+    std::vector<PanSample> _samples;
+
+};
+
+}
+
+#endif /* PanTracker_hpp */
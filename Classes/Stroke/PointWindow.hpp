@@ -0,0 +1,67 @@
+//
+//  PointWindow.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef PointWindow_hpp
+#define PointWindow_hpp
+
+#include <algorithm>
+#include <vector>
+#include "StrokeTypes.hpp"
+
+namespace stroke {
+
+//! The input points still waiting to be drawn. Every frame draws the window and then keeps only its last
+//! two points, which moves the window start instead of erasing from the front of a vector. The kept points
+//! are copied back to the start of the storage only when a push finds it full, so the storage is allocated
+//! once and reused for the whole session. Unlike a wrapping ring buffer the points stay contiguous, which
+//! the smoother and tessellator need.
+class PointWindow {
+
+public:
+    static constexpr size_t DefaultCapacity = 256;
+
+public:
+    PointWindow (size_t capacity = DefaultCapacity) : _start(0) { _storage.reserve(capacity); }
+
+    void push_back(const LinePoint &point)
+    {
+        if (_start > 0 && _storage.size() == _storage.capacity()) {
+            _storage.erase(_storage.begin(), _storage.begin() + _start);
+            _start = 0;
+        }
+        _storage.push_back(point);
+    }
+
+    //! drops all but the last count points.
+    void keepLast(size_t count)
+    {
+        _start = _storage.size() - std::min(count, size());
+    }
+
+    void clear()
+    {
+        _storage.clear();
+        _start = 0;
+    }
+
+    const LinePoint *data() const { return _storage.data() + _start; }
+    size_t size() const { return _storage.size() - _start; }
+    bool empty() const { return size() == 0; }
+
+    const LinePoint &operator[](size_t i) const { return _storage[_start + i]; }
+    const LinePoint &back() const { return _storage.back(); }
+
+private:
+    std::vector<LinePoint> _storage;
+    size_t _start;
+
+};
+
+}
+
+#endif /* PointWindow_hpp */
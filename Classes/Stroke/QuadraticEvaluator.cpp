@@ -0,0 +1,269 @@
+//
+//  QuadraticEvaluator.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "QuadraticEvaluator.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STROKE_HAVE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(STROKE_HAVE_SSE2) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define STROKE_HAVE_AVX2 1
+#define STROKE_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#include <immintrin.h>
+#elif defined(STROKE_HAVE_SSE2) && defined(__AVX2__)
+#define STROKE_HAVE_AVX2 1
+#define STROKE_TARGET_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define STROKE_HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace stroke {
+
+static_assert(sizeof(LinePoint) == 3 * sizeof(float), "LinePoint must be tightly packed x, y, width");
+
+namespace {
+
+using EvaluateFunc = void (*)(const QuadraticCurve &, int, LinePoint *);
+
+inline void evaluateOne(const QuadraticCurve &q, float t, LinePoint *out)
+{
+    out->pos.x = (q.ax * t + q.bx) * t + q.cx;
+    out->pos.y = (q.ay * t + q.by) * t + q.cy;
+    out->width = (q.aw * t + q.bw) * t + q.cw;
+}
+
+void evaluateScalar(const QuadraticCurve &q, int count, LinePoint *out)
+{
+    if (count <= 0)
+        return;
+
+    //! forward differencing: the second difference of a quadratic is constant, two adds per channel per sample.
+    const float h = 1.0f / count;
+    const float h2 = h * h;
+
+    float x = q.cx, y = q.cy, w = q.cw;
+    float dx = q.bx * h + q.ax * h2, dy = q.by * h + q.ay * h2, dw = q.bw * h + q.aw * h2;
+    const float ddx = 2 * q.ax * h2, ddy = 2 * q.ay * h2, ddw = 2 * q.aw * h2;
+
+    for (int i = 0; i < count; ++i) {
+        out[i].pos.x = x;
+        out[i].pos.y = y;
+        out[i].width = w;
+        x += dx; dx += ddx;
+        y += dy; dy += ddy;
+        w += dw; dw += ddw;
+    }
+}
+
+#if STROKE_HAVE_SSE2
+//! stores 4 samples given as x, y and width lanes into 4 consecutive LinePoints (48 bytes).
+inline void storeInterleaved(__m128 X, __m128 Y, __m128 W, float *dst)
+{
+    __m128 xyLo = _mm_unpacklo_ps(X, Y);                                   // x0 y0 x1 y1
+    __m128 xyHi = _mm_unpackhi_ps(X, Y);                                   // x2 y2 x3 y3
+    __m128 wxLo = _mm_unpacklo_ps(W, X);                                   // w0 x0 w1 x1
+    __m128 ywLo = _mm_unpacklo_ps(Y, W);                                   // y0 w0 y1 w1
+    __m128 wxHi = _mm_unpackhi_ps(W, X);                                   // w2 x2 w3 x3
+    __m128 ywHi = _mm_unpackhi_ps(Y, W);                                   // y2 w2 y3 w3
+
+    _mm_storeu_ps(dst, _mm_shuffle_ps(xyLo, wxLo, _MM_SHUFFLE(3, 0, 1, 0)));     // x0 y0 w0 x1
+    _mm_storeu_ps(dst + 4, _mm_shuffle_ps(ywLo, xyHi, _MM_SHUFFLE(1, 0, 3, 2))); // y1 w1 x2 y2
+    _mm_storeu_ps(dst + 8, _mm_shuffle_ps(wxHi, ywHi, _MM_SHUFFLE(3, 2, 3, 0))); // w2 x3 y3 w3
+}
+
+void evaluateSSE2(const QuadraticCurve &q, int count, LinePoint *out)
+{
+    const float h = 1.0f / count;
+    const __m128 step = _mm_set1_ps(h);
+    const __m128 ax = _mm_set1_ps(q.ax), ay = _mm_set1_ps(q.ay), aw = _mm_set1_ps(q.aw);
+    const __m128 bx = _mm_set1_ps(q.bx), by = _mm_set1_ps(q.by), bw = _mm_set1_ps(q.bw);
+    const __m128 cx = _mm_set1_ps(q.cx), cy = _mm_set1_ps(q.cy), cw = _mm_set1_ps(q.cw);
+
+    __m128 index = _mm_set_ps(3, 2, 1, 0);
+    const __m128 four = _mm_set1_ps(4);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 t = _mm_mul_ps(index, step);
+        __m128 X = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(ax, t), bx), t), cx);
+        __m128 Y = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(ay, t), by), t), cy);
+        __m128 W = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(aw, t), bw), t), cw);
+        storeInterleaved(X, Y, W, &out[i].pos.x);
+        index = _mm_add_ps(index, four);
+    }
+    for (; i < count; ++i) {
+        evaluateOne(q, i * h, &out[i]);
+    }
+}
+#endif
+
+#if STROKE_HAVE_AVX2
+STROKE_TARGET_AVX2
+void evaluateAVX2(const QuadraticCurve &q, int count, LinePoint *out)
+{
+    const float h = 1.0f / count;
+    const __m256 step = _mm256_set1_ps(h);
+    const __m256 ax = _mm256_set1_ps(q.ax), ay = _mm256_set1_ps(q.ay), aw = _mm256_set1_ps(q.aw);
+    const __m256 bx = _mm256_set1_ps(q.bx), by = _mm256_set1_ps(q.by), bw = _mm256_set1_ps(q.bw);
+    const __m256 cx = _mm256_set1_ps(q.cx), cy = _mm256_set1_ps(q.cy), cw = _mm256_set1_ps(q.cw);
+
+    __m256 index = _mm256_set_ps(7, 6, 5, 4, 3, 2, 1, 0);
+    const __m256 eight = _mm256_set1_ps(8);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 t = _mm256_mul_ps(index, step);
+        __m256 X = _mm256_fmadd_ps(_mm256_fmadd_ps(ax, t, bx), t, cx);
+        __m256 Y = _mm256_fmadd_ps(_mm256_fmadd_ps(ay, t, by), t, cy);
+        __m256 W = _mm256_fmadd_ps(_mm256_fmadd_ps(aw, t, bw), t, cw);
+
+        float *dst = &out[i].pos.x;
+        storeInterleaved(_mm256_castps256_ps128(X), _mm256_castps256_ps128(Y), _mm256_castps256_ps128(W), dst);
+        storeInterleaved(_mm256_extractf128_ps(X, 1), _mm256_extractf128_ps(Y, 1), _mm256_extractf128_ps(W, 1), dst + 12);
+        index = _mm256_add_ps(index, eight);
+    }
+    for (; i < count; ++i) {
+        evaluateOne(q, i * h, &out[i]);
+    }
+}
+#endif
+
+#if STROKE_HAVE_NEON
+void evaluateNEON(const QuadraticCurve &q, int count, LinePoint *out)
+{
+    const float h = 1.0f / count;
+    const float32x4_t ax = vdupq_n_f32(q.ax), ay = vdupq_n_f32(q.ay), aw = vdupq_n_f32(q.aw);
+    const float32x4_t bx = vdupq_n_f32(q.bx), by = vdupq_n_f32(q.by), bw = vdupq_n_f32(q.bw);
+    const float32x4_t cx = vdupq_n_f32(q.cx), cy = vdupq_n_f32(q.cy), cw = vdupq_n_f32(q.cw);
+
+    const float lanes[4] = {0, 1, 2, 3};
+    float32x4_t index = vld1q_f32(lanes);
+    const float32x4_t four = vdupq_n_f32(4);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t t = vmulq_n_f32(index, h);
+        float32x4x3_t xyw;
+        xyw.val[0] = vmlaq_f32(cx, vmlaq_f32(bx, ax, t), t);
+        xyw.val[1] = vmlaq_f32(cy, vmlaq_f32(by, ay, t), t);
+        xyw.val[2] = vmlaq_f32(cw, vmlaq_f32(bw, aw, t), t);
+        //! vst3 interleaves the three channels into x, y, width order for us
+        vst3q_f32(&out[i].pos.x, xyw);
+        index = vaddq_f32(index, four);
+    }
+    for (; i < count; ++i) {
+        evaluateOne(q, i * h, &out[i]);
+    }
+}
+#endif
+
+EvaluateFunc functionFor(QuadraticEvaluator::Backend backend)
+{
+    switch (backend) {
+#if STROKE_HAVE_SSE2
+        case QuadraticEvaluator::Backend::SSE2:
+            return evaluateSSE2;
+#endif
+#if STROKE_HAVE_AVX2
+        case QuadraticEvaluator::Backend::AVX2:
+            return evaluateAVX2;
+#endif
+#if STROKE_HAVE_NEON
+        case QuadraticEvaluator::Backend::NEON:
+            return evaluateNEON;
+#endif
+        default:
+            return evaluateScalar;
+    }
+}
+
+QuadraticEvaluator::Backend bestBackend()
+{
+    if (QuadraticEvaluator::isSupported(QuadraticEvaluator::Backend::AVX2))
+        return QuadraticEvaluator::Backend::AVX2;
+    if (QuadraticEvaluator::isSupported(QuadraticEvaluator::Backend::SSE2))
+        return QuadraticEvaluator::Backend::SSE2;
+    if (QuadraticEvaluator::isSupported(QuadraticEvaluator::Backend::NEON))
+        return QuadraticEvaluator::Backend::NEON;
+    return QuadraticEvaluator::Backend::Scalar;
+}
+
+QuadraticEvaluator::Backend currentBackend = bestBackend();
+EvaluateFunc currentFunc = functionFor(currentBackend);
+
+}
+
+void QuadraticEvaluator::evaluate(const QuadraticCurve &curve, int count, LinePoint *out)
+{
+    currentFunc(curve, count, out);
+}
+
+QuadraticEvaluator::Backend QuadraticEvaluator::getBackend()
+{
+    return currentBackend;
+}
+
+bool QuadraticEvaluator::isSupported(Backend backend)
+{
+    switch (backend) {
+        case Backend::Scalar:
+            return true;
+        case Backend::SSE2:
+#if STROKE_HAVE_SSE2
+            return true;
+#else
+            return false;
+#endif
+        case Backend::AVX2:
+#if STROKE_HAVE_AVX2 && (defined(__GNUC__) || defined(__clang__))
+            //! also called from a static initializer, before the runtime has probed the CPU
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#elif STROKE_HAVE_AVX2
+            return true;
+#else
+            return false;
+#endif
+        case Backend::NEON:
+#if STROKE_HAVE_NEON
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+bool QuadraticEvaluator::setBackend(Backend backend)
+{
+    if (!isSupported(backend))
+        return false;
+
+    currentBackend = backend;
+    currentFunc = functionFor(backend);
+    return true;
+}
+
+const char *QuadraticEvaluator::getBackendName(Backend backend)
+{
+    switch (backend) {
+        case Backend::Scalar: return "scalar";
+        case Backend::SSE2: return "sse2";
+        case Backend::AVX2: return "avx2";
+        case Backend::NEON: return "neon";
+    }
+    return "unknown";
+}
+
+}
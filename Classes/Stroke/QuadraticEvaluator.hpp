@@ -0,0 +1,63 @@
+//
+//  QuadraticEvaluator.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef QuadraticEvaluator_hpp
+#define QuadraticEvaluator_hpp
+
+#include "StrokeTypes.hpp"
+
+namespace stroke {
+
+//! A quadratic curve over position and width together, in power basis: value(t) = a t^2 + b t + c per channel.
+struct QuadraticCurve {
+    float ax, ay, aw;
+    float bx, by, bw;
+    float cx, cy, cw;
+
+    //! the Bezier curve from p0 to p2 with p1 as control point.
+    static QuadraticCurve fromControlPoints(const LinePoint &p0, const LinePoint &p1, const LinePoint &p2)
+    {
+        QuadraticCurve q;
+        q.ax = p0.pos.x - 2 * p1.pos.x + p2.pos.x;
+        q.ay = p0.pos.y - 2 * p1.pos.y + p2.pos.y;
+        q.aw = p0.width - 2 * p1.width + p2.width;
+        q.bx = 2 * (p1.pos.x - p0.pos.x);
+        q.by = 2 * (p1.pos.y - p0.pos.y);
+        q.bw = 2 * (p1.width - p0.width);
+        q.cx = p0.pos.x;
+        q.cy = p0.pos.y;
+        q.cw = p0.width;
+        return q;
+    }
+};
+
+//! Samples quadratic curves at evenly spaced t. The vector backends evaluate 4 (SSE2, NEON) or 8 (AVX2)
+//! samples at once with Horner's rule and interleave x, y and width straight into LinePoint storage;
+//! the scalar fallback uses forward differencing. The best backend for the CPU is picked on first use.
+class QuadraticEvaluator {
+
+public:
+    enum class Backend { Scalar, SSE2, AVX2, NEON };
+
+public:
+    //! writes count points for t = i / count, i in [0, count). t = 1 is left to the caller.
+    static void evaluate(const QuadraticCurve &curve, int count, LinePoint *out);
+
+    static Backend getBackend();
+    static bool isSupported(Backend backend);
+
+    //! forces a backend, for benchmarks. Returns false and keeps the current one if unsupported.
+    static bool setBackend(Backend backend);
+
+    static const char *getBackendName(Backend backend);
+
+};
+
+}
+
+#endif /* QuadraticEvaluator_hpp */
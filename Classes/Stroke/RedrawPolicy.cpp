@@ -0,0 +1,90 @@
+//
+//  RedrawPolicy.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "RedrawPolicy.hpp"
+
+namespace stroke {
+
+constexpr int RedrawPolicy::DefaultLingerFrames;
+
+bool RedrawPolicy::touchBegan(time_point now)
+{
+    _touches++;
+    return wake(now);
+}
+
+void RedrawPolicy::touchEnded()
+{
+    if (_touches > 0)
+        _touches--;
+    //! the frames that draw the end of the stroke
+    _framesLeft = _lingerFrames;
+}
+
+bool RedrawPolicy::invalidate(time_point now)
+{
+    return wake(now);
+}
+
+bool RedrawPolicy::wake(time_point now)
+{
+    _framesLeft = _lingerFrames > 0 ? _lingerFrames : 1;
+    if (_running)
+        return false;
+
+    account(now);
+    _running = true;
+    _stats.wakeups++;
+    return true;
+}
+
+bool RedrawPolicy::frameDrawn(bool busy, time_point now)
+{
+    _stats.framesDrawn++;
+    if (busy || _touches > 0) {
+        _framesLeft = _lingerFrames;
+        return true;
+    }
+    if (_framesLeft > 0)
+        _framesLeft--;
+    if (!_onDemand || _framesLeft > 0)
+        return true;
+
+    account(now);
+    _running = false;
+    return false;
+}
+
+void RedrawPolicy::account(time_point now)
+{
+    double seconds = std::chrono::duration<double>(now - _since).count();
+    if (_running)
+        _stats.runningSeconds += seconds;
+    else
+        _stats.idleSeconds += seconds;
+    _since = now;
+}
+
+RedrawPolicy::Stats RedrawPolicy::getStats(time_point now) const
+{
+    Stats stats = _stats;
+    double seconds = std::chrono::duration<double>(now - _since).count();
+    if (_running)
+        stats.runningSeconds += seconds;
+    else
+        stats.idleSeconds += seconds;
+    return stats;
+}
+
+void RedrawPolicy::resetStats(time_point now)
+{
+    _stats = Stats {0, 0, 0, 0};
+    _since = now;
+}
+
+}
@@ -0,0 +1,100 @@
+//
+//  RedrawPolicy.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef RedrawPolicy_hpp
+#define RedrawPolicy_hpp
+
+#include <stdint.h>
+#include <chrono>
+
+namespace stroke {
+
+//! Decides when the frame loop has to run, for rendering on demand. The loop runs while a finger is down,
+//! while the caller reports work in flight, and for a few frames after the last change; otherwise it
+//! stops, and the display keeps the last frame at no cost. Touch-downs and invalidations start the loop
+//! again, so the first frame after them is drawn on the next display refresh.
+//!
+//! The policy only tracks what happened and when. Starting and stopping the loop is up to the caller:
+//! touchBegan() and invalidate() return true when the loop has to be started, frameDrawn() false when
+//! it can stop. Continuous, the loop always runs and only the counters are kept.
+class RedrawPolicy {
+
+public:
+    using clock = std::chrono::steady_clock;
+    using time_point = clock::time_point;
+
+    //! frames drawn after the last change, for what shows a frame later: meshes from a worker thread,
+    //! history tiles read back after the frame that drew them
+    static constexpr int DefaultLingerFrames = 2;
+
+    //! What the loop has cost since the last resetStats(), as a stand-in for the power it drew: every
+    //! frame is a wakeup of the CPU and a pass over the screen for the GPU.
+    struct Stats {
+        uint64_t framesDrawn;
+        //! times the loop was started from idle
+        uint64_t wakeups;
+        double runningSeconds;
+        double idleSeconds;
+
+        //! share of the time the loop ran
+        double getDutyCycle() const
+        {
+            double total = runningSeconds + idleSeconds;
+            return total > 0 ? runningSeconds / total : 1;
+        }
+    };
+
+public:
+    RedrawPolicy () : _onDemand(true), _lingerFrames(DefaultLingerFrames), _running(true), _touches(0), _framesLeft(DefaultLingerFrames), _stats {0, 0, 0, 0}, _since(clock::now()) {}
+
+    //! on demand by default; continuous keeps the loop running whatever happens
+    void setOnDemand(bool onDemand) { _onDemand = onDemand; }
+    bool isOnDemand() const { return _onDemand; }
+
+    void setLingerFrames(int frames) { _lingerFrames = frames > 0 ? frames : 0; }
+    int getLingerFrames() const { return _lingerFrames; }
+
+    bool isRunning() const { return _running; }
+    int getTouchCount() const { return _touches; }
+
+    //! a finger came down: the loop runs until the last one is lifted. True if it has to be started.
+    bool touchBegan(time_point now = clock::now());
+    void touchEnded();
+    //! something changed that has to be drawn. True if the loop has to be started.
+    bool invalidate(time_point now = clock::now());
+
+    //! Called after drawing a frame; busy while the caller still has work that needs frames. False once
+    //! the loop can stop, and it counts as stopped from then on.
+    bool frameDrawn(bool busy, time_point now = clock::now());
+
+    //! the counters, with the time up to now accounted to the loop's current state
+    Stats getStats(time_point now = clock::now()) const;
+    void resetStats(time_point now = clock::now());
+
+private:
+    //! starts the loop if it was stopped, true if it was
+    bool wake(time_point now);
+    void account(time_point now);
+
+private:
+    bool _onDemand;
+    int _lingerFrames;
+    bool _running;
+    int _touches;
+    //! frames left to draw before the loop may stop
+    int _framesLeft;
+
+    Stats _stats;
+    //! when the running or idle time was last accounted
+    time_point _since;
+
+};
+
+}
+
+#endif /* RedrawPolicy_hpp */
@@ -0,0 +1,213 @@
+//
+//  SoftwareRenderer.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "SoftwareRenderer.hpp"
+
+#include <math.h>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define STROKE_SSE2 1
+#endif
+
+namespace stroke {
+
+constexpr int SoftwareRenderer::DefaultBinSize;
+constexpr int SoftwareRenderer::GLTolerance;
+
+static uint8_t toChannel(float value)
+{
+    return (uint8_t)std::min(255, std::max(0, (int)(value + .5f)));
+}
+
+void Image::clear(const Color4F &color)
+{
+    uint32_t pixel = pack(toChannel(color.r * color.a * 255), toChannel(color.g * color.a * 255), toChannel(color.b * color.a * 255), toChannel(color.a * 255));
+    std::fill(pixels.begin(), pixels.end(), pixel);
+}
+
+void SoftwareRenderer::draw(Image &image, const StrokeMesh &mesh, const Color4F &color, Vec2 origin, float scale)
+{
+    _triangleCount = 0;
+    if (mesh.empty() || image.width <= 0 || image.height <= 0)
+        return;
+
+    auto &vertices = mesh.getVertices();
+    _pixelVertices.resize(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        _pixelVertices[i] = Vertex {(vertices[i].x - origin.x) * scale, (vertices[i].y - origin.y) * scale, vertices[i].coverage};
+    }
+
+    _triangles.clear();
+    auto &indices = mesh.getIndices();
+    for (auto &batch : mesh.getBatches()) {
+        const Vertex *v = _pixelVertices.data() + batch.vertexStart;
+        const unsigned short *index = indices.data() + batch.indexStart;
+        for (size_t i = 0; i + 2 < batch.indexCount; i += 3) {
+            Triangle triangle;
+            if (setupTriangle(v[index[i]], v[index[i + 1]], v[index[i + 2]], image, color.a, triangle))
+                _triangles.push_back(triangle);
+        }
+    }
+    _triangleCount = _triangles.size();
+
+    _binColumns = (image.width + _binSize - 1) / _binSize;
+    _binRows = (image.height + _binSize - 1) / _binSize;
+    _bins.resize((size_t)_binColumns * _binRows);
+    for (auto &bin : _bins) {
+        bin.clear();
+    }
+    for (uint32_t t = 0; t < _triangles.size(); ++t) {
+        auto &triangle = _triangles[t];
+        for (int by = triangle.minY / _binSize; by <= triangle.maxY / _binSize; ++by) {
+            for (int bx = triangle.minX / _binSize; bx <= triangle.maxX / _binSize; ++bx) {
+                _bins[by * _binColumns + bx].push_back(t);
+            }
+        }
+    }
+
+    //! premultiplied, as StrokeRenderer sets u_color, in 0 to 255
+    const float source[4] = {color.r * color.a * 255, color.g * color.a * 255, color.b * color.a * 255, color.a * 255};
+    _pool.run(_bins.size(), [&] (size_t bin) { drawBin(image, bin, source); });
+}
+
+bool SoftwareRenderer::setupTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2, const Image &image, float alpha, Triangle &triangle) const
+{
+    //! a triangle that adds no coverage leaves every pixel as it was
+    if (v0.coverage <= 0 && v1.coverage <= 0 && v2.coverage <= 0)
+        return false;
+
+    float area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+    if (!(area != 0))
+        return false;
+
+    const Vertex *v[3] = {&v0, area > 0 ? &v1 : &v2, area > 0 ? &v2 : &v1};
+    area = fabsf(area);
+
+    float minX = std::min(v0.x, std::min(v1.x, v2.x)), maxX = std::max(v0.x, std::max(v1.x, v2.x));
+    float minY = std::min(v0.y, std::min(v1.y, v2.y)), maxY = std::max(v0.y, std::max(v1.y, v2.y));
+    triangle.minX = std::max(0, (int)ceilf(minX - .5f));
+    triangle.minY = std::max(0, (int)ceilf(minY - .5f));
+    triangle.maxX = std::min(image.width - 1, (int)floorf(maxX - .5f));
+    triangle.maxY = std::min(image.height - 1, (int)floorf(maxY - .5f));
+    if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY)
+        return false;
+
+    for (int k = 0; k < 3; ++k) {
+        auto &p0 = *v[k];
+        auto &p1 = *v[(k + 1) % 3];
+        triangle.a[k] = p0.y - p1.y;
+        triangle.b[k] = p1.x - p0.x;
+        triangle.c[k] = -(triangle.a[k] * p0.x + triangle.b[k] * p0.y);
+        //! counter-clockwise with y up: left edges run downwards and top edges run to the left
+        triangle.inclusive[k] = triangle.a[k] > 0 || (triangle.a[k] == 0 && triangle.b[k] < 0);
+    }
+
+    float dc1 = v[1]->coverage - v[0]->coverage, dc2 = v[2]->coverage - v[0]->coverage;
+    triangle.originX = v[0]->x;
+    triangle.originY = v[0]->y;
+    triangle.coverage = v[0]->coverage;
+    triangle.coverageX = (dc1 * (v[2]->y - v[0]->y) - dc2 * (v[1]->y - v[0]->y)) / area;
+    triangle.coverageY = (dc2 * (v[1]->x - v[0]->x) - dc1 * (v[2]->x - v[0]->x)) / area;
+    triangle.solid = alpha >= 1 && v0.coverage >= 1 && v1.coverage >= 1 && v2.coverage >= 1;
+    return true;
+}
+
+bool SoftwareRenderer::inside(const Triangle &triangle, float x, float y)
+{
+    for (int k = 0; k < 3; ++k) {
+        float e = triangle.a[k] * x + triangle.b[k] * y + triangle.c[k];
+        if (!(e > 0 || (e == 0 && triangle.inclusive[k])))
+            return false;
+    }
+    return true;
+}
+
+void SoftwareRenderer::drawBin(Image &image, size_t bin, const float color[4]) const
+{
+    const int binX0 = (int)(bin % _binColumns) * _binSize, binY0 = (int)(bin / _binColumns) * _binSize;
+    const int binX1 = std::min(image.width, binX0 + _binSize) - 1, binY1 = std::min(image.height, binY0 + _binSize) - 1;
+
+    for (auto t : _bins[bin]) {
+        auto &triangle = _triangles[t];
+        const int x0 = std::max(triangle.minX, binX0), x1 = std::min(triangle.maxX, binX1);
+        const int y0 = std::max(triangle.minY, binY0), y1 = std::min(triangle.maxY, binY1);
+
+        for (int y = y0; y <= y1; ++y) {
+            const float py = y + .5f;
+
+            //! the span where every edge function is positive, a pixel wider than solved for, then trimmed by
+            //! testing its ends exactly so that shared edges split the same way as the pixel test
+            float lo = (float)x0, hi = (float)x1;
+            bool empty = false;
+            for (int k = 0; k < 3 && !empty; ++k) {
+                float e = triangle.b[k] * py + triangle.c[k];
+                if (triangle.a[k] > 0)
+                    lo = std::max(lo, ceilf(-e / triangle.a[k] - .5f) - 1);
+                else if (triangle.a[k] < 0)
+                    hi = std::min(hi, floorf(-e / triangle.a[k] - .5f) + 1);
+                else
+                    empty = !(e > 0 || (e == 0 && triangle.inclusive[k]));
+            }
+            if (empty || lo > hi)
+                continue;
+
+            int start = (int)lo, end = (int)hi;
+            while (start <= end && !inside(triangle, start + .5f, py))
+                start++;
+            while (end >= start && !inside(triangle, end + .5f, py))
+                end--;
+            if (start <= end)
+                drawSpan(&image.at(0, y), start, end, py, triangle, color);
+        }
+    }
+}
+
+void SoftwareRenderer::drawSpan(uint32_t *row, int x0, int x1, float py, const Triangle &triangle, const float color[4]) const
+{
+    if (triangle.solid) {
+        std::fill(row + x0, row + x1 + 1, Image::pack(toChannel(color[0]), toChannel(color[1]), toChannel(color[2]), toChannel(color[3])));
+        return;
+    }
+
+    const float rowCoverage = triangle.coverage + triangle.coverageY * (py - triangle.originY);
+    const float alpha = color[3] / 255;
+
+#if STROKE_SSE2
+    const __m128 source = _mm_loadu_ps(color);
+    const __m128 half = _mm_set1_ps(.5f);
+    const __m128i zero = _mm_setzero_si128();
+    for (int x = x0; x <= x1; ++x) {
+        float coverage = rowCoverage + triangle.coverageX * (x + .5f - triangle.originX);
+        coverage = std::min(1.0f, std::max(0.0f, coverage));
+
+        //! one pixel's four channels per vector: source * coverage + destination * (1 - alpha * coverage)
+        __m128i d = _mm_cvtsi32_si128((int)row[x]);
+        d = _mm_unpacklo_epi16(_mm_unpacklo_epi8(d, zero), zero);
+        __m128 result = _mm_add_ps(_mm_mul_ps(source, _mm_set1_ps(coverage)), _mm_mul_ps(_mm_cvtepi32_ps(d), _mm_set1_ps(1 - alpha * coverage)));
+        __m128i packed = _mm_cvttps_epi32(_mm_add_ps(result, half));
+        packed = _mm_packs_epi32(packed, packed);
+        row[x] = (uint32_t)_mm_cvtsi128_si32(_mm_packus_epi16(packed, packed));
+    }
+#else
+    for (int x = x0; x <= x1; ++x) {
+        float coverage = rowCoverage + triangle.coverageX * (x + .5f - triangle.originX);
+        coverage = std::min(1.0f, std::max(0.0f, coverage));
+
+        const float keep = 1 - alpha * coverage;
+        uint32_t pixel = row[x];
+        row[x] = Image::pack(toChannel(color[0] * coverage + Image::channel(pixel, 0) * keep),
+                             toChannel(color[1] * coverage + Image::channel(pixel, 1) * keep),
+                             toChannel(color[2] * coverage + Image::channel(pixel, 2) * keep),
+                             toChannel(color[3] * coverage + Image::channel(pixel, 3) * keep));
+    }
+#endif
+}
+
+}
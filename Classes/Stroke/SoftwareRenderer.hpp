@@ -0,0 +1,111 @@
+//
+//  SoftwareRenderer.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef SoftwareRenderer_hpp
+#define SoftwareRenderer_hpp
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "StrokeMesh.hpp"
+#include "WorkerPool.hpp"
+
+namespace stroke {
+
+//! Premultiplied RGBA8888 pixels, laid out as glReadPixels returns them: R, G, B, A bytes per pixel and the
+//! bottom row first, so pixel (x, y) covers canvas point (x, y) to (x + 1, y + 1) at scale 1.
+struct Image {
+    int width, height;
+    std::vector<uint32_t> pixels;
+
+    Image () : width(0), height(0) {}
+    Image (int w, int h) : width(w), height(h), pixels((size_t)w * h) {}
+
+    uint32_t &at(int x, int y) { return pixels[(size_t)y * width + x]; }
+    uint32_t at(int x, int y) const { return pixels[(size_t)y * width + x]; }
+
+    //! fills the image with color, premultiplied
+    void clear(const Color4F &color);
+
+    static uint32_t pack(uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+    {
+        return (uint32_t)r | (uint32_t)g << 8 | (uint32_t)b << 16 | (uint32_t)a << 24;
+    }
+    static uint8_t channel(uint32_t pixel, int c) { return (uint8_t)(pixel >> (8 * c)); }
+};
+
+//! The CPU counterpart of StrokeRenderer: draws the meshes StrokeTessellator produces into an Image, for
+//! rendering and checking drawings where there is no GPU, and exports without a GL readback.
+//!
+//! It rasterizes the way GL does: a pixel is in a triangle if its center is (shared edges go to one side by
+//! the top-left rule), the vertex coverage is interpolated linearly, and the color times the coverage is
+//! blended over the image as GL_ONE, GL_ONE_MINUS_SRC_ALPHA with each result rounded to 8 bits. The fringe
+//! the tessellator puts around every stroke is what antialiases it, as on the GPU. Compared with a GL
+//! renderer drawing the same mesh into an RGBA8888 target, a pixel differs by at most GLTolerance in any
+//! channel: GPUs interpolate coverage at lower precision, and lowp fragment colors on mobile GPUs step
+//! their results a little differently.
+//!
+//! The image is split into bins of binSize pixels square; every triangle is listed in the bins its bounds
+//! overlap, and the bins are drawn in parallel on a WorkerPool, each drawing its triangles in mesh order.
+//! A pixel therefore blends in the same order whatever the thread count, and the output is identical.
+class SoftwareRenderer {
+
+public:
+    static constexpr int DefaultBinSize = 64;
+    static constexpr int GLTolerance = 2;
+
+public:
+    //! threadCount includes the calling thread; 0 is one per hardware thread.
+    explicit SoftwareRenderer (unsigned threadCount = 0, int binSize = DefaultBinSize)
+    : _pool(threadCount), _binSize(binSize), _binColumns(0), _binRows(0), _triangleCount(0) {}
+
+    unsigned getThreadCount() const { return _pool.getThreadCount(); }
+
+    //! Draws mesh over image in color. origin is the canvas point at the image's bottom left corner and
+    //! scale the pixels per canvas point, as a render texture's transform would map them.
+    void draw(Image &image, const StrokeMesh &mesh, const Color4F &color, Vec2 origin = Vec2 {0, 0}, float scale = 1);
+
+    //! triangles the last draw() rasterized, after culling those outside the image or without area
+    size_t getTriangleCount() const { return _triangleCount; }
+
+private:
+    //! a triangle in pixels, counter-clockwise, as edge functions a * x + b * y + c that are positive inside
+    //! and a plane for its coverage
+    struct Triangle {
+        float a[3], b[3], c[3];
+        //! whether a pixel center exactly on the edge is inside
+        bool inclusive[3];
+        //! coverage at (originX, originY), the first vertex, and its gradient
+        float originX, originY, coverage, coverageX, coverageY;
+        //! the pixels whose centers the bounds contain, clipped to the image
+        int minX, minY, maxX, maxY;
+        //! fully covered throughout, so it replaces pixels rather than blending
+        bool solid;
+    };
+
+    bool setupTriangle(const Vertex &v0, const Vertex &v1, const Vertex &v2, const Image &image, float alpha, Triangle &triangle) const;
+    static bool inside(const Triangle &triangle, float x, float y);
+    void drawBin(Image &image, size_t bin, const float color[4]) const;
+    void drawSpan(uint32_t *row, int x0, int x1, float y, const Triangle &triangle, const float color[4]) const;
+
+private:
+    WorkerPool _pool;
+    int _binSize;
+
+    std::vector<Vertex> _pixelVertices;
+    std::vector<Triangle> _triangles;
+    //! triangle indices per bin, in mesh order
+    std::vector<std::vector<uint32_t>> _bins;
+    int _binColumns, _binRows;
+    size_t _triangleCount;
+
+};
+
+}
+
+#endif /* SoftwareRenderer_hpp */
@@ -0,0 +1,83 @@
+//
+//  SpscQueue.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef SpscQueue_hpp
+#define SpscQueue_hpp
+
+#include <stddef.h>
+#include <atomic>
+#include <vector>
+
+namespace stroke {
+
+//! Bounded lock-free queue for exactly one producer thread and one consumer thread. The storage is a ring
+//! of a power of two slots allocated once; each side owns one index and only reads the other's, so a push
+//! or pop is a couple of atomic loads and one release store, with no lock and no allocation.
+template <typename T>
+class SpscQueue {
+
+public:
+    //! capacity is rounded up to a power of two.
+    explicit SpscQueue (size_t capacity) : _head(0), _tail(0)
+    {
+        size_t size = 1;
+        while (size < capacity)
+            size <<= 1;
+        _slots.resize(size);
+        _mask = size - 1;
+    }
+
+    SpscQueue (const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    //! producer side: false, leaving the queue as it was, when it is full.
+    bool tryPush(const T &value)
+    {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _head.load(std::memory_order_acquire) == _slots.size())
+            return false;
+        _slots[tail & _mask] = value;
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    //! consumer side: false when there is nothing to take.
+    bool tryPop(T &value)
+    {
+        size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire))
+            return false;
+        value = _slots[head & _mask];
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    //! exact on the consumer side; from the producer, the queue may have emptied since.
+    bool empty() const { return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire); }
+
+    size_t capacity() const { return _slots.size(); }
+
+private:
+    static constexpr size_t CacheLine = 64;
+
+    std::vector<T> _slots;
+    size_t _mask;
+    //! a cache line apart, so the two threads don't invalidate each other's index on every push and pop.
+    //! Padded rather than alignas(64): operator new doesn't honor extended alignment before C++17, and
+    //! the queue is a member of heap allocated workers.
+    char _headPadding[CacheLine];
+    std::atomic<size_t> _head;
+    char _tailPadding[CacheLine - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> _tail;
+    char _endPadding[CacheLine - sizeof(std::atomic<size_t>)];
+
+};
+
+}
+
+#endif /* SpscQueue_hpp */
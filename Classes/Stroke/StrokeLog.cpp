@@ -0,0 +1,472 @@
+//
+//  StrokeLog.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "StrokeLog.hpp"
+
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include "Varint.hpp"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace stroke {
+
+namespace {
+
+//! no record yet in the block, so no slot to repeat
+const uint32_t NoSlot = UINT32_MAX;
+//! more slots than fingers, so a corrupt tag doesn't make the reader allocate without bound
+const uint32_t MaxSlots = 1024;
+//! a time and a width delta paired into one varint, with the same-stroke bit beside them, stay within 64 bits
+const int64_t PairLimit = 1 << 29;
+
+void put32(std::vector<uint8_t> &out, uint32_t value)
+{
+    for (int i = 0; i < 4; ++i) {
+        out.push_back((uint8_t)(value >> (8 * i)));
+    }
+}
+
+void put64(std::vector<uint8_t> &out, uint64_t value)
+{
+    for (int i = 0; i < 8; ++i) {
+        out.push_back((uint8_t)(value >> (8 * i)));
+    }
+}
+
+uint32_t get32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+uint64_t get64(const uint8_t *p)
+{
+    return (uint64_t)get32(p) | (uint64_t)get32(p + 4) << 32;
+}
+
+int32_t quantize(float value) { return (int32_t)lroundf(value / strokelog::PositionStep); }
+
+}
+
+void StrokeLogWriter::reset()
+{
+    _failed = false;
+    _hasEpoch = false;
+    _block.clear();
+    _blockRecords = 0;
+    _slots.clear();
+    _index.clear();
+    _records = 0;
+    _bytes = 0;
+}
+
+bool StrokeLogWriter::open(const char *path)
+{
+    close();
+    _file = fopen(path, "wb");
+    if (!_file)
+        return false;
+    reset();
+
+    std::vector<uint8_t> header(strokelog::Magic, strokelog::Magic + sizeof(strokelog::Magic));
+    put32(header, strokelog::Version);
+    float positionStep = strokelog::PositionStep;
+    double timeStep = strokelog::TimeStep;
+    uint32_t positionBits;
+    uint64_t timeBits;
+    memcpy(&positionBits, &positionStep, sizeof(positionBits));
+    memcpy(&timeBits, &timeStep, sizeof(timeBits));
+    put32(header, positionBits);
+    put64(header, timeBits);
+    _failed = fwrite(header.data(), 1, header.size(), _file) != header.size();
+    _bytes = header.size();
+    return true;
+}
+
+bool StrokeLogWriter::close()
+{
+    if (!_file)
+        return true;
+    flushBlock();
+
+    uint64_t indexOffset = _bytes;
+    std::vector<uint8_t> trailer;
+    put64(trailer, indexOffset);
+    put32(trailer, (uint32_t)(_index.size() / strokelog::IndexEntryBytes));
+    put32(trailer, strokelog::IndexMagic);
+    _failed = _failed || fwrite(_index.data(), 1, _index.size(), _file) != _index.size();
+    _failed = _failed || fwrite(trailer.data(), 1, trailer.size(), _file) != trailer.size();
+    _bytes += _index.size() + trailer.size();
+
+    _failed = fclose(_file) != 0 || _failed;
+    _file = nullptr;
+    return !_failed;
+}
+
+uint32_t StrokeLogWriter::beginStroke(Vec2 location, float width, time_point timestamp)
+{
+    uint32_t slot = 0;
+    while (slot < _slots.size() && _slots[slot].open) {
+        slot++;
+    }
+    if (slot == _slots.size())
+        _slots.push_back(Slot {});
+    _slots[slot].open = true;
+    write(StrokeLogRecord::Begin, slot, location, width, timestamp);
+    return slot;
+}
+
+void StrokeLogWriter::addSample(uint32_t slot, Vec2 location, float width, time_point timestamp)
+{
+    write(StrokeLogRecord::Sample, slot, location, width, timestamp);
+}
+
+void StrokeLogWriter::endStroke(uint32_t slot, Vec2 location, float width, time_point timestamp)
+{
+    write(StrokeLogRecord::End, slot, location, width, timestamp);
+    if (slot < _slots.size())
+        _slots[slot].open = false;
+}
+
+void StrokeLogWriter::write(StrokeLogRecord::Kind kind, uint32_t slot, Vec2 location, float width, time_point timestamp)
+{
+    if (!_file || slot >= _slots.size())
+        return;
+    if (!_hasEpoch) {
+        _epoch = timestamp;
+        _hasEpoch = true;
+    }
+    int64_t ticks = llround(std::chrono::duration<double>(timestamp - _epoch).count() / strokelog::TimeStep);
+    int32_t x = quantize(location.x), y = quantize(location.y), w = quantize(width);
+
+    //! a time or width delta too large to pair with the other goes at the start of a block, as a slot's first
+    Slot &s = _slots[slot];
+    bool pairable = llabs(ticks - s.ticks - s.dt) < PairLimit && llabs((int64_t)w - s.width) < PairLimit;
+    if (_blockRecords == strokelog::BlockRecords || (_blockRecords && s.known && kind != StrokeLogRecord::Begin && !pairable))
+        flushBlock();
+    if (_blockRecords == 0)
+        startBlock(ticks);
+
+    bool fresh = kind == StrokeLogRecord::Begin || !s.known;
+    //! the common record, the next sample of the stroke before it, needs no tag
+    bool same = kind == StrokeLogRecord::Sample && slot == _lastSlot && !fresh;
+
+    if (fresh) {
+        varint::write64(_block, varint::zigzag64(ticks - _ticks) << 1);
+        varint::write(_block, slot << 2 | kind);
+        varint::write64(_block, varint::interleave(varint::zigzag(x - _lastX), varint::zigzag(y - _lastY)));
+        varint::writeSigned(_block, w);
+        s.dt = 0;
+        s.dx = s.dy = 0;
+    }
+    else {
+        uint64_t timeWidth = varint::interleave(varint::zigzag((int32_t)(ticks - s.ticks - s.dt)), varint::zigzag(w - s.width));
+        varint::write64(_block, timeWidth << 1 | (same ? 1 : 0));
+        if (!same)
+            varint::write(_block, slot << 2 | kind);
+        varint::write64(_block, varint::interleave(varint::zigzag(x - (s.x + s.dx)), varint::zigzag(y - (s.y + s.dy))));
+        s.dt = ticks - s.ticks;
+        s.dx = x - s.x;
+        s.dy = y - s.y;
+    }
+    s.ticks = ticks;
+    s.x = x;
+    s.y = y;
+    s.width = w;
+    s.known = true;
+
+    _ticks = ticks;
+    _lastX = x;
+    _lastY = y;
+    _lastSlot = slot;
+    _blockRecords++;
+    _records++;
+}
+
+void StrokeLogWriter::startBlock(int64_t ticks)
+{
+    _block.clear();
+    _blockStart = _ticks = ticks;
+    _lastX = _lastY = 0;
+    _lastSlot = NoSlot;
+    for (auto &slot : _slots) {
+        slot.known = false;
+    }
+}
+
+void StrokeLogWriter::flushBlock()
+{
+    if (_blockRecords == 0)
+        return;
+
+    std::vector<uint8_t> header;
+    put32(header, (uint32_t)_block.size());
+    put32(header, _blockRecords);
+    put64(header, (uint64_t)_blockStart);
+    _failed = _failed || fwrite(header.data(), 1, header.size(), _file) != header.size();
+    _failed = _failed || fwrite(_block.data(), 1, _block.size(), _file) != _block.size();
+
+    put64(_index, _bytes);
+    put64(_index, (uint64_t)_blockStart);
+    put32(_index, _blockRecords);
+    put32(_index, (uint32_t)_block.size());
+    _bytes += header.size() + _block.size();
+    _blockRecords = 0;
+}
+
+bool StrokeLogReader::open(const char *path)
+{
+    close();
+    _error.clear();
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return fail(std::string("can't open ") + path);
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return fail(std::string(path) + " is empty");
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping)
+        return fail(std::string("can't map ") + path);
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        return fail(std::string("can't map ") + path);
+    }
+    _mapping = mapping;
+    _data = (const uint8_t *)view;
+    _size = (size_t)size.QuadPart;
+#else
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+        return fail(std::string("can't open ") + path);
+    struct stat status;
+    if (fstat(fd, &status) != 0 || status.st_size == 0) {
+        ::close(fd);
+        return fail(std::string(path) + " is empty");
+    }
+    void *view = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED)
+        return fail(std::string("can't map ") + path);
+    _data = (const uint8_t *)view;
+    _size = (size_t)status.st_size;
+#endif
+
+    if (_size < strokelog::HeaderBytes || memcmp(_data, strokelog::Magic, sizeof(strokelog::Magic)) != 0)
+        return fail(std::string(path) + " is not a stroke log");
+    if (get32(_data + 8) != strokelog::Version)
+        return fail(std::string(path) + " is a stroke log of another version");
+    uint32_t positionBits = get32(_data + 12);
+    uint64_t timeBits = get64(_data + 16);
+    memcpy(&_positionStep, &positionBits, sizeof(_positionStep));
+    memcpy(&_timeStep, &timeBits, sizeof(_timeStep));
+    if (!(_positionStep > 0) || !(_timeStep > 0))
+        return fail(std::string(path) + " has no quantization steps");
+
+    _records = 0;
+    _indexed = readIndex();
+    if (!_indexed && !scanBlocks())
+        return false;
+    return true;
+}
+
+void StrokeLogReader::close()
+{
+    if (_data) {
+#if defined(_WIN32)
+        UnmapViewOfFile(_data);
+        CloseHandle((HANDLE)_mapping);
+#else
+        munmap((void *)_data, _size);
+#endif
+    }
+    _data = nullptr;
+    _size = 0;
+    _mapping = nullptr;
+    _blocks.clear();
+    _blockTicks.clear();
+    _records = 0;
+}
+
+bool StrokeLogReader::fail(const std::string &error)
+{
+    close();
+    _error = error;
+    return false;
+}
+
+bool StrokeLogReader::readIndex()
+{
+    if (_size < strokelog::HeaderBytes + strokelog::TrailerBytes)
+        return false;
+    const uint64_t end = _size - strokelog::TrailerBytes;
+    const uint8_t *trailer = _data + end;
+    uint64_t indexOffset = get64(trailer);
+    uint32_t count = get32(trailer + 8);
+    //! by subtraction, so a corrupt offset or count can't wrap around into a match
+    if (get32(trailer + 12) != strokelog::IndexMagic || indexOffset < strokelog::HeaderBytes || indexOffset > end
+        || (end - indexOffset) % strokelog::IndexEntryBytes != 0 || count != (end - indexOffset) / strokelog::IndexEntryBytes)
+        return false;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint8_t *entry = _data + indexOffset + i * strokelog::IndexEntryBytes;
+        uint64_t offset = get64(entry);
+        //! the index has to agree with the block it points to
+        if (!addBlock(offset) || _blockTicks.back() != (int64_t)get64(entry + 8) || _blocks.back().recordCount != get32(entry + 16)) {
+            _blocks.clear();
+            _blockTicks.clear();
+            _records = 0;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool StrokeLogReader::scanBlocks()
+{
+    //! up to the first block that runs past the end, as the last one of a log that was never closed would
+    for (uint64_t offset = strokelog::HeaderBytes; offset + strokelog::BlockHeaderBytes <= _size; ) {
+        if (!addBlock(offset))
+            break;
+        offset = _blocks.back().offset + _blocks.back().payloadBytes;
+    }
+    return true;
+}
+
+bool StrokeLogReader::addBlock(uint64_t headerOffset)
+{
+    if (_size < strokelog::BlockHeaderBytes || headerOffset > _size - strokelog::BlockHeaderBytes)
+        return false;
+    const uint8_t *header = _data + headerOffset;
+    uint32_t payloadBytes = get32(header);
+    uint32_t records = get32(header + 4);
+    int64_t ticks = (int64_t)get64(header + 8);
+    uint64_t offset = headerOffset + strokelog::BlockHeaderBytes;
+    if (payloadBytes > _size - offset || records == 0)
+        return false;
+
+    _blocks.push_back(Block {offset, payloadBytes, records, ticks * _timeStep});
+    _blockTicks.push_back(ticks);
+    _records += records;
+    return true;
+}
+
+size_t StrokeLogReader::findBlock(double seconds) const
+{
+    auto block = std::upper_bound(_blocks.begin(), _blocks.end(), seconds, [] (double s, const Block &b) { return s < b.seconds; });
+    return block == _blocks.begin() ? 0 : block - _blocks.begin() - 1;
+}
+
+StrokeLogReader::Cursor StrokeLogReader::read(size_t block) const
+{
+    if (block >= _blocks.size())
+        return Cursor {};
+    auto &b = _blocks[block];
+    return Cursor {_data + b.offset, _data + b.offset + b.payloadBytes, b.recordCount, _blockTicks[block], _positionStep, _timeStep};
+}
+
+StrokeLogReader::Cursor::Cursor (const uint8_t *p, const uint8_t *end, uint32_t records, int64_t ticks, float positionStep, double timeStep)
+: _p(p), _end(end), _left(records), _failed(false), _ticks(ticks), _lastX(0), _lastY(0), _lastSlot(NoSlot), _positionStep(positionStep), _timeStep(timeStep)
+{
+}
+
+bool StrokeLogReader::Cursor::next(StrokeLogRecord &record)
+{
+    if (_left == 0)
+        return false;
+
+    uint64_t first;
+    if (!varint::read64(_p, _end, first))
+        return fail();
+    bool same = (first & 1) != 0;
+
+    StrokeLogRecord::Kind kind = StrokeLogRecord::Sample;
+    uint32_t slot = _lastSlot;
+    if (!same) {
+        uint32_t tag;
+        if (!varint::read(_p, _end, tag) || (tag & 3) > StrokeLogRecord::End || (tag >> 2) >= MaxSlots)
+            return fail();
+        kind = (StrokeLogRecord::Kind)(tag & 3);
+        slot = tag >> 2;
+    }
+    else if (slot == NoSlot) {
+        return fail();
+    }
+    if (slot >= _slots.size())
+        _slots.resize(slot + 1, Slot {false, 0, 0, 0, 0, 0, 0, 0});
+
+    uint64_t location;
+    uint32_t zx, zy;
+    if (!varint::read64(_p, _end, location))
+        return fail();
+    varint::deinterleave(location, zx, zy);
+
+    Slot &s = _slots[slot];
+    int64_t ticks;
+    int32_t x, y, w;
+    if (kind == StrokeLogRecord::Begin || !s.known) {
+        if (!varint::readSigned(_p, _end, w))
+            return fail();
+        ticks = _ticks + varint::unzigzag64(first >> 1);
+        x = _lastX + varint::unzigzag(zx);
+        y = _lastY + varint::unzigzag(zy);
+        s.dt = 0;
+        s.dx = s.dy = 0;
+    }
+    else {
+        uint32_t zt, zw;
+        varint::deinterleave(first >> 1, zt, zw);
+        ticks = s.ticks + s.dt + varint::unzigzag(zt);
+        w = s.width + varint::unzigzag(zw);
+        x = s.x + s.dx + varint::unzigzag(zx);
+        y = s.y + s.dy + varint::unzigzag(zy);
+        s.dt = ticks - s.ticks;
+        s.dx = x - s.x;
+        s.dy = y - s.y;
+    }
+    s.ticks = ticks;
+    s.x = x;
+    s.y = y;
+    s.width = w;
+    s.known = true;
+
+    _ticks = ticks;
+    _lastX = x;
+    _lastY = y;
+    _lastSlot = slot;
+    _left--;
+
+    record.kind = kind;
+    record.slot = slot;
+    record.location = Vec2 {x * _positionStep, y * _positionStep};
+    record.width = w * _positionStep;
+    record.seconds = ticks * _timeStep;
+    return true;
+}
+
+bool StrokeLogReader::Cursor::fail()
+{
+    _failed = true;
+    _left = 0;
+    return false;
+}
+
+}
@@ -0,0 +1,239 @@
+//
+//  StrokeLog.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef StrokeLog_hpp
+#define StrokeLog_hpp
+
+#include <stddef.h>
+#include <stdint.h>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "StrokeTypes.hpp"
+
+namespace stroke {
+
+//! One entry of a stroke log: a pan sample as StrokePipeline took it, with the width it extracted, at the
+//! beginning, along or at the end of a stroke. Strokes drawn at the same time are told apart by slot, the
+//! smallest not taken by a stroke in progress.
+struct StrokeLogRecord {
+    enum Kind { Begin, Sample, End };
+
+    Kind kind;
+    uint32_t slot;
+    Vec2 location;
+    float width;
+    //! since the first record of the log
+    double seconds;
+};
+
+//! The stroke log file format, shared by StrokeLogWriter and StrokeLogReader.
+//!
+//! A header, then blocks of up to BlockRecords records, then an index of the blocks and a trailer that
+//! points to it. Locations and widths are quantized to PositionStep and times to TimeStep. A record along a
+//! stroke is two varints: the time and width deltas interleaved, then the x and y ones, with a tag for the
+//! kind and slot only when it isn't the next sample of the stroke before it. Time and location are taken as
+//! the change from the stroke's last step, width from its last width, so a sample takes about 4 bytes
+//! against the 20 of its floats and double timestamp. A stroke's first record in a block is a delta from the
+//! record before it. A block starts its deltas afresh, so it decodes on its own, straight from a mapping of
+//! the file; a log whose index was never written is read by walking the block headers.
+//!
+//! Fields are little endian.
+namespace strokelog {
+
+static constexpr char Magic[8] = {'S', 'D', 'S', 'T', 'R', 'O', 'K', 'E'};
+static constexpr uint32_t Version = 1;
+static constexpr uint32_t IndexMagic = 0x58444e49;  // "INDX"
+
+static constexpr float PositionStep = 1.0f / 16;
+static constexpr double TimeStep = 100e-6;
+static constexpr uint32_t BlockRecords = 4096;
+
+//! magic, version, and the steps a log was quantized with
+static constexpr size_t HeaderBytes = 8 + 4 + 4 + 8;
+//! payload bytes, records and the time of the block's start in TimeStep ticks, then the payload
+static constexpr size_t BlockHeaderBytes = 4 + 4 + 8;
+//! offset of the block header in the file, its start ticks, records and payload bytes
+static constexpr size_t IndexEntryBytes = 8 + 8 + 4 + 4;
+//! offset of the index, blocks and IndexMagic
+static constexpr size_t TrailerBytes = 8 + 4 + 4;
+//! the floats and double timestamp of a record, what a log would take unencoded
+static constexpr size_t RawRecordBytes = 4 * 3 + 8;
+
+}
+
+//! Records pan samples into a stroke log file as they are drawn; StrokePipeline::setLog() feeds it. The
+//! encoded blocks go to a buffered FILE as they fill up, and close() writes the index.
+class StrokeLogWriter {
+
+public:
+    using time_point = std::chrono::steady_clock::time_point;
+
+public:
+    StrokeLogWriter () : _file(nullptr) { reset(); }
+    ~StrokeLogWriter() { close(); }
+
+    StrokeLogWriter(const StrokeLogWriter &) = delete;
+    StrokeLogWriter &operator=(const StrokeLogWriter &) = delete;
+
+    //! starts a new log at path, closing any log in progress. Returns false if the file can't be created.
+    bool open(const char *path);
+    //! writes the last block and the index and closes the file. Returns false if any write failed.
+    bool close();
+    bool isOpen() const { return _file != nullptr; }
+
+    //! a stroke starting with this sample; returns its slot for the calls below
+    uint32_t beginStroke(Vec2 location, float width, time_point timestamp);
+    void addSample(uint32_t slot, Vec2 location, float width, time_point timestamp);
+    //! ends the stroke in slot with this sample, freeing the slot
+    void endStroke(uint32_t slot, Vec2 location, float width, time_point timestamp);
+
+    uint64_t getRecordCount() const { return _records; }
+    //! of the file so far, including the block not written yet
+    uint64_t getByteCount() const { return _bytes + (_blockRecords ? strokelog::BlockHeaderBytes + _block.size() : 0); }
+
+private:
+    //! what the next delta of a slot is taken against, within the block
+    struct Slot {
+        bool open;
+        bool known;
+        int64_t ticks, dt;
+        int32_t x, y, width;
+        int32_t dx, dy;
+    };
+
+    void reset();
+    void write(StrokeLogRecord::Kind kind, uint32_t slot, Vec2 location, float width, time_point timestamp);
+    void startBlock(int64_t ticks);
+    void flushBlock();
+
+private:
+    std::FILE *_file;
+    bool _failed;
+    bool _hasEpoch;
+    time_point _epoch;
+
+    std::vector<uint8_t> _block;
+    uint32_t _blockRecords;
+    int64_t _blockStart;
+    //! of the last record, for the next stroke's first
+    int64_t _ticks;
+    int32_t _lastX, _lastY;
+    uint32_t _lastSlot;
+    std::vector<Slot> _slots;
+
+    //! per block: offset, start ticks, records, payload bytes
+    std::vector<uint8_t> _index;
+    uint64_t _records;
+    uint64_t _bytes;
+
+};
+
+//! Reads a stroke log by mapping the file into memory: opening costs the index, not the log, and records
+//! are decoded straight from the mapping. Any block can be decoded on its own, for seeking by time.
+class StrokeLogReader {
+
+public:
+    struct Block {
+        //! of the block's payload in the file
+        uint64_t offset;
+        uint32_t payloadBytes;
+        uint32_t recordCount;
+        //! of the block's first record, in seconds since the first record of the log
+        double seconds;
+    };
+
+    //! Decodes the records of a block, in order, from the mapped bytes.
+    class Cursor {
+
+    public:
+        Cursor () : _p(nullptr), _end(nullptr), _left(0), _failed(false) {}
+
+        //! the next record into record, false once the block is over or its bytes are malformed
+        bool next(StrokeLogRecord &record);
+        //! whether next() stopped on malformed bytes rather than the end of the block
+        bool failed() const { return _failed; }
+
+    private:
+        friend class StrokeLogReader;
+        Cursor (const uint8_t *p, const uint8_t *end, uint32_t records, int64_t ticks, float positionStep, double timeStep);
+
+        struct Slot {
+            bool known;
+            int64_t ticks, dt;
+            int32_t x, y, width;
+            int32_t dx, dy;
+        };
+
+        bool fail();
+
+        const uint8_t *_p, *_end;
+        uint32_t _left;
+        bool _failed;
+        int64_t _ticks;
+        int32_t _lastX, _lastY;
+        uint32_t _lastSlot;
+        std::vector<Slot> _slots;
+        float _positionStep;
+        double _timeStep;
+
+    };
+
+public:
+    StrokeLogReader () : _data(nullptr), _size(0), _mapping(nullptr), _positionStep(0), _timeStep(0), _records(0), _indexed(false) {}
+    ~StrokeLogReader() { close(); }
+
+    StrokeLogReader(const StrokeLogReader &) = delete;
+    StrokeLogReader &operator=(const StrokeLogReader &) = delete;
+
+    //! maps the log at path, closing any log open. Returns false, with getError() saying why, if the file
+    //! can't be mapped or isn't a stroke log.
+    bool open(const char *path);
+    void close();
+    bool isOpen() const { return _data != nullptr; }
+    const std::string &getError() const { return _error; }
+
+    size_t getBlockCount() const { return _blocks.size(); }
+    const Block &getBlock(size_t index) const { return _blocks[index]; }
+    uint64_t getRecordCount() const { return _records; }
+    //! of the mapped file
+    size_t getByteCount() const { return _size; }
+    //! whether the index was read from the file, rather than rebuilt from the blocks of an unfinished log
+    bool hasIndex() const { return _indexed; }
+
+    //! the block holding the records at seconds: the last one starting at or before it
+    size_t findBlock(double seconds) const;
+    Cursor read(size_t block) const;
+
+private:
+    bool fail(const std::string &error);
+    bool readIndex();
+    bool scanBlocks();
+    bool addBlock(uint64_t headerOffset);
+
+private:
+    const uint8_t *_data;
+    size_t _size;
+    //! the platform's handle of the mapping, if it needs one
+    void *_mapping;
+    std::string _error;
+    //! as the log's header gives them
+    float _positionStep;
+    double _timeStep;
+
+    std::vector<Block> _blocks;
+    std::vector<int64_t> _blockTicks;
+    uint64_t _records;
+    bool _indexed;
+
+};
+
+}
+
+#endif /* StrokeLog_hpp */
@@ -0,0 +1,63 @@
+//
+//  StrokeMesh.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "StrokeMesh.hpp"
+
+#include <algorithm>
+
+namespace stroke {
+
+constexpr size_t StrokeMesh::MaxBatchVertices;
+constexpr size_t StrokeMesh::MaxBatchIndices;
+
+void StrokeMesh::appendOverlapping(const StrokeMesh &mesh, const Bounds &bounds)
+{
+    for (auto &batch : mesh._batches) {
+        const Vertex *vertices = mesh._vertices.data() + batch.vertexStart;
+        const unsigned short *indices = mesh._indices.data() + batch.indexStart;
+        size_t run = 0;
+        bool inRun = false;
+        for (size_t i = 0; i < batch.indexCount; i += 3) {
+            Bounds triangle;
+            for (size_t k = i; k < i + 3; ++k) {
+                triangle.add(vertices[indices[k]].x, vertices[indices[k]].y);
+            }
+            bool overlapping = triangle.overlaps(bounds);
+            if (overlapping && !inRun) {
+                run = i;
+                inRun = true;
+            }
+            else if (!overlapping && inRun) {
+                appendRun(vertices, indices + run, i - run);
+                inRun = false;
+            }
+        }
+        if (inRun)
+            appendRun(vertices, indices + run, batch.indexCount - run);
+    }
+}
+
+void StrokeMesh::appendRun(const Vertex *vertices, const unsigned short *indices, size_t indexCount)
+{
+    //! the tessellator adds a stroke's vertices in order, so a run's triangles share a short range of them
+    unsigned short first = indices[0], last = indices[0];
+    for (size_t i = 1; i < indexCount; ++i) {
+        first = std::min(first, indices[i]);
+        last = std::max(last, indices[i]);
+    }
+    unsigned short base = beginPrimitive(last - first + 1, indexCount);
+    for (size_t i = first; i <= last; ++i) {
+        addVertex(vertices[i]);
+    }
+    for (size_t i = 0; i < indexCount; ++i) {
+        _indices.push_back((unsigned short)(base + indices[i] - first));
+    }
+    _batches.back().indexCount += indexCount;
+}
+
+}
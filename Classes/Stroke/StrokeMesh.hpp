@@ -0,0 +1,136 @@
+//
+//  StrokeMesh.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef StrokeMesh_hpp
+#define StrokeMesh_hpp
+
+#include <stddef.h>
+#include <vector>
+#include "StrokeTypes.hpp"
+
+namespace stroke {
+
+//! A range of the mesh that can be drawn with 16 bit indices. Indices are relative to vertexStart.
+struct MeshBatch {
+    size_t vertexStart;
+    size_t vertexCount;
+    size_t indexStart;
+    size_t indexCount;
+};
+
+//! Triangle mesh with 16 bit indices, split into batches so that no batch addresses more vertices than an
+//! unsigned short can index. Each batch is one glDrawElements call; the index limit keeps a batch's index
+//! buffer upload the same size as the cocos2d renderer's (INDEX_VBO_SIZE).
+class StrokeMesh {
+
+public:
+    static constexpr size_t MaxBatchVertices = 65535;
+    static constexpr size_t MaxBatchIndices = 65536 * 6 / 4;
+
+public:
+    StrokeMesh (size_t maxBatchVertices = MaxBatchVertices, size_t maxBatchIndices = MaxBatchIndices)
+    : _generation(0), _maxBatchVertices(maxBatchVertices), _maxBatchIndices(maxBatchIndices) {}
+
+    //! for tests: smaller limits exercise batch splitting without building huge meshes.
+    void setBatchLimits(size_t maxBatchVertices, size_t maxBatchIndices)
+    {
+        _maxBatchVertices = maxBatchVertices;
+        _maxBatchIndices = maxBatchIndices;
+    }
+
+    void clear()
+    {
+        _vertices.clear();
+        _indices.clear();
+        _batches.clear();
+        _bounds = Bounds {};
+        _generation++;
+    }
+
+    //! Makes room for a primitive of vertexCount vertices and indexCount indices, opening a new batch if
+    //! the current one cannot take it. Returns the batch relative index the primitive's first vertex will get.
+    unsigned short beginPrimitive(size_t vertexCount, size_t indexCount)
+    {
+        if (_batches.empty()
+            || _batches.back().vertexCount + vertexCount > _maxBatchVertices
+            || _batches.back().indexCount + indexCount > _maxBatchIndices) {
+            _batches.push_back(MeshBatch {_vertices.size(), 0, _indices.size(), 0});
+        }
+        return (unsigned short)_batches.back().vertexCount;
+    }
+
+    //! appends a vertex to the current batch and returns its batch relative index.
+    unsigned short addVertex(const Vertex &vertex)
+    {
+        _vertices.push_back(vertex);
+        _bounds.add(vertex.x, vertex.y);
+        return (unsigned short)(_batches.back().vertexCount++);
+    }
+
+    void addTriangle(unsigned short a, unsigned short b, unsigned short c)
+    {
+        _indices.push_back(a);
+        _indices.push_back(b);
+        _indices.push_back(c);
+        _batches.back().indexCount += 3;
+    }
+
+    //! appends every batch of mesh, merging them into the current batch while the limits allow.
+    void append(const StrokeMesh &mesh)
+    {
+        for (auto &batch : mesh._batches) {
+            unsigned short base = beginPrimitive(batch.vertexCount, batch.indexCount);
+            for (size_t i = 0; i < batch.vertexCount; ++i) {
+                addVertex(mesh._vertices[batch.vertexStart + i]);
+            }
+            for (size_t i = 0; i < batch.indexCount; ++i) {
+                _indices.push_back((unsigned short)(base + mesh._indices[batch.indexStart + i]));
+            }
+            _batches.back().indexCount += batch.indexCount;
+        }
+    }
+
+    //! Appends the triangles of mesh whose bounds overlap bounds, in runs of consecutive triangles that bring
+    //! along the vertices between them: the part of a mesh that can draw into a tile.
+    void appendOverlapping(const StrokeMesh &mesh, const Bounds &bounds);
+
+    bool empty() const { return _indices.empty(); }
+
+    std::vector<Vertex> &getVertices() { return _vertices; }
+    std::vector<unsigned short> &getIndices() { return _indices; }
+    const std::vector<Vertex> &getVertices() const { return _vertices; }
+    const std::vector<unsigned short> &getIndices() const { return _indices; }
+    const std::vector<MeshBatch> &getBatches() const { return _batches; }
+
+    //! bounds of every vertex added since the last clear, overdraw fringe included: the area the mesh can touch.
+    const Bounds &getBounds() const { return _bounds; }
+
+    //! counts the clear()s, so a copy on the GPU can tell a mesh that grew from one built again.
+    size_t getGeneration() const { return _generation; }
+
+    Vertex *getBatchVertices(const MeshBatch &batch) { return _vertices.data() + batch.vertexStart; }
+    unsigned short *getBatchIndices(const MeshBatch &batch) { return _indices.data() + batch.indexStart; }
+
+private:
+    void appendRun(const Vertex *vertices, const unsigned short *indices, size_t indexCount);
+
+private:
+    std::vector<Vertex> _vertices;
+    std::vector<unsigned short> _indices;
+    std::vector<MeshBatch> _batches;
+    Bounds _bounds;
+    size_t _generation;
+
+    size_t _maxBatchVertices;
+    size_t _maxBatchIndices;
+
+};
+
+}
+
+#endif /* StrokeMesh_hpp */
@@ -0,0 +1,138 @@
+//
+//  StrokeModel.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "StrokeModel.hpp"
+#include "Varint.hpp"
+
+namespace stroke {
+
+constexpr float StrokeModel::QuantizationStep;
+
+void StrokeModel::beginStroke()
+{
+    endStroke();
+    openStroke();
+}
+
+size_t StrokeModel::openStroke()
+{
+    _undone.clear();
+    _strokes.push_back(EncodedStroke {});
+    _openCount++;
+    return _strokes.size() - 1;
+}
+
+void StrokeModel::addPoint(const LinePoint &point)
+{
+    if (_strokes.empty() || _strokes.back().finished)
+        beginStroke();
+    addPoint(_strokes.size() - 1, point);
+}
+
+void StrokeModel::addPoint(size_t index, const LinePoint &point)
+{
+    auto &stroke = _strokes[index];
+    const int32_t q[3] = {quantize(point.pos.x), quantize(point.pos.y), quantize(point.width)};
+
+    size_t size = stroke.data.size();
+    for (int i = 0; i < 3; ++i) {
+        varint::writeSigned(stroke.data, q[i] - stroke.last[i]);
+        stroke.last[i] = q[i];
+    }
+    _encodedBytes += stroke.data.size() - size;
+
+    float radius = point.width * .5f;
+    Bounds pointBounds {point.pos.x - radius, point.pos.y - radius, point.pos.x + radius, point.pos.y + radius};
+    stroke.bounds.add(pointBounds);
+    _bounds.add(pointBounds);
+
+    stroke.pointCount++;
+    _pointCount++;
+}
+
+void StrokeModel::endStroke()
+{
+    //! stops at the earliest open stroke, usually one of the last few
+    for (size_t i = _strokes.size(); i-- > 0 && _openCount > 0; ) {
+        endStroke(i);
+    }
+}
+
+void StrokeModel::endStroke(size_t index)
+{
+    if (!isStrokeOpen(index))
+        return;
+
+    _strokes[index].finished = true;
+    _openCount--;
+}
+
+bool StrokeModel::undoStroke()
+{
+    if (_strokes.empty() || _openCount > 0)
+        return false;
+
+    _undone.push_back(std::move(_strokes.back()));
+    _strokes.pop_back();
+    updateTotals();
+    return true;
+}
+
+bool StrokeModel::redoStroke()
+{
+    if (_undone.empty() || _openCount > 0)
+        return false;
+
+    _strokes.push_back(std::move(_undone.back()));
+    _undone.pop_back();
+    updateTotals();
+    return true;
+}
+
+void StrokeModel::updateTotals()
+{
+    _bounds = Bounds {};
+    _pointCount = 0;
+    _encodedBytes = 0;
+    for (auto &stroke : _strokes) {
+        _bounds.add(stroke.bounds);
+        _pointCount += stroke.pointCount;
+        _encodedBytes += stroke.data.size();
+    }
+}
+
+void StrokeModel::decode(size_t index, std::vector<LinePoint> &points) const
+{
+    auto &stroke = _strokes[index];
+    points.clear();
+
+    const uint8_t *p = stroke.data.data();
+    const uint8_t *end = p + stroke.data.size();
+    int32_t q[3] = {0, 0, 0};
+    for (uint32_t i = 0; i < stroke.pointCount; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            int32_t delta;
+            if (!varint::readSigned(p, end, delta))
+                return;
+            q[c] += delta;
+        }
+        points.push_back(LinePoint {Vec2 {q[0] * QuantizationStep, q[1] * QuantizationStep}, q[2] * QuantizationStep});
+    }
+}
+
+void StrokeModel::clear()
+{
+    _strokes.clear();
+    _undone.clear();
+    _openCount = 0;
+    _bounds = Bounds {};
+    _pointCount = 0;
+    _encodedBytes = 0;
+}
+
+}
@@ -0,0 +1,98 @@
+//
+//  StrokeModel.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef StrokeModel_hpp
+#define StrokeModel_hpp
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "StrokeTypes.hpp"
+
+namespace stroke {
+
+//! One retained stroke: its line points, widths already extracted from the pan velocity, quantized to
+//! QuantizationStep and stored as zigzag varint deltas from the previous point (x, y, width per point).
+struct EncodedStroke {
+    std::vector<uint8_t> data;
+    uint32_t pointCount;
+    //! of the point positions grown by half their width, before any overdraw
+    Bounds bounds;
+    //! ended by endStroke(), so it gets an end cap when rasterized
+    bool finished;
+    //! quantized x, y and width of the last point, which the next one is a delta from
+    int32_t last[3];
+};
+
+//! The drawing as vectors rather than pixels: every stroke's line points exactly as StrokePipeline queued
+//! them for smoothing, so the strokes can be tessellated again at any scale by a StrokeRasterizer.
+//! Points take about 3 bytes rather than the 12 of a LinePoint.
+class StrokeModel {
+
+public:
+    //! positions and widths are kept to a sixteenth of a point
+    static constexpr float QuantizationStep = 1.0f / 16;
+
+public:
+    StrokeModel () : _openCount(0), _pointCount(0), _encodedBytes(0) {}
+
+    //! starts a stroke, ending the open ones and dropping the strokes that could be redone.
+    void beginStroke();
+    //! adds to the last stroke, beginning one if it has ended.
+    void addPoint(const LinePoint &point);
+    //! ends every open stroke.
+    void endStroke();
+
+    //! Strokes drawn at the same time, one per finger: openStroke() starts a stroke alongside the open ones
+    //! and returns its index for the calls below. Drops the strokes that could be redone.
+    size_t openStroke();
+    void addPoint(size_t index, const LinePoint &point);
+    void endStroke(size_t index);
+
+    //! whether any stroke is still being drawn
+    bool isStrokeOpen() const { return _openCount > 0; }
+    bool isStrokeOpen(size_t index) const { return index < _strokes.size() && !_strokes[index].finished; }
+
+    size_t getStrokeCount() const { return _strokes.size(); }
+    const EncodedStroke &getStroke(size_t index) const { return _strokes[index]; }
+    //! of every stroke, see EncodedStroke::bounds
+    const Bounds &getBounds() const { return _bounds; }
+
+    size_t getPointCount() const { return _pointCount; }
+    size_t getEncodedBytes() const { return _encodedBytes; }
+
+    //! Takes the last stroke out of the drawing, keeping it for redoStroke(). Returns false if there is none
+    //! or a stroke is open.
+    bool undoStroke();
+    //! puts the last undone stroke back, as the last stroke. Returns false if there is none.
+    bool redoStroke();
+    size_t getUndoneCount() const { return _undone.size(); }
+
+    //! replaces points with the stroke's points, as quantization left them.
+    void decode(size_t index, std::vector<LinePoint> &points) const;
+
+    void clear();
+
+private:
+    static int32_t quantize(float value) { return (int32_t)lroundf(value / QuantizationStep); }
+    void updateTotals();
+
+private:
+    std::vector<EncodedStroke> _strokes;
+    std::vector<EncodedStroke> _undone;
+    size_t _openCount;
+
+    Bounds _bounds;
+    size_t _pointCount;
+    size_t _encodedBytes;
+
+};
+
+}
+
+#endif /* StrokeModel_hpp */
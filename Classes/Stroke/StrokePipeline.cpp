@@ -0,0 +1,252 @@
+//
+//  StrokePipeline.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "StrokePipeline.hpp"
+
+#include <algorithm>
+
+namespace stroke {
+
+constexpr float StrokePipeline::MinPointDistance;
+constexpr float StrokePipeline::SpeedPerWidth;
+constexpr float StrokePipeline::MinWidth;
+constexpr float StrokePipeline::MaxWidth;
+constexpr size_t StrokePipeline::NoStroke;
+constexpr uint32_t StrokePipeline::NoLogSlot;
+
+void StrokePipeline::panBegan(Vec2 location, Vec2 velocity, time_point timestamp)
+{
+    clearPoints();
+    _predictor.reset();
+    _predictor.addSample(location, velocity, timestamp);
+
+    _lastSize = 0.0;
+    float size = extractSize(velocity);
+
+    startNewLine(location, size);
+    addPoint(location, size);
+    addPoint(location, size);
+    logSample(StrokeLogRecord::Begin, location, size, timestamp);
+}
+
+void StrokePipeline::panChanged(Vec2 location, Vec2 velocity, time_point timestamp)
+{
+    _predictor.addSample(location, velocity, timestamp);
+
+    //! skip points that are too close
+    if (_hasLastPoint && (_lastPoint.pos - location).getLength() < MinPointDistance) {
+        logSample(StrokeLogRecord::Sample, location, _lastSize, timestamp);
+        return;
+    }
+
+    float size = extractSize(velocity);
+    addPoint(location, size);
+    logSample(StrokeLogRecord::Sample, location, size, timestamp);
+}
+
+void StrokePipeline::panBegan(const PanSample *samples, size_t count)
+{
+    if (count == 0)
+        return;
+    panBegan(samples[0].location, samples[0].velocity, samples[0].timestamp);
+    panChanged(samples + 1, count - 1);
+}
+
+void StrokePipeline::panChanged(const PanSample *samples, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        panChanged(samples[i].location, samples[i].velocity, samples[i].timestamp);
+    }
+}
+
+void StrokePipeline::panCompleted(Vec2 location, Vec2 velocity)
+{
+    float size = extractSize(velocity);
+    endLine(location, size);
+    //! the end carries no timestamp of its own, it is as old as the stroke's last sample
+    logSample(StrokeLogRecord::End, location, size, _logTime);
+}
+
+void StrokePipeline::setLog(StrokeLogWriter *log)
+{
+    if (log == _log)
+        return;
+    if (_log && _logSlot != NoLogSlot)
+        _log->endStroke(_logSlot, _logPoint.pos, _logPoint.width, _logTime);
+    _logSlot = NoLogSlot;
+    _log = log;
+}
+
+void StrokePipeline::logSample(StrokeLogRecord::Kind kind, Vec2 location, float width, time_point timestamp)
+{
+    if (!_log)
+        return;
+
+    //! a stroke that began before the log was set, or began again without ending, starts afresh
+    if (kind == StrokeLogRecord::Begin || _logSlot == NoLogSlot) {
+        if (_logSlot != NoLogSlot)
+            _log->endStroke(_logSlot, _logPoint.pos, _logPoint.width, _logTime);
+        _logSlot = _log->beginStroke(location, width, timestamp);
+        if (kind == StrokeLogRecord::End)
+            _log->endStroke(_logSlot, location, width, timestamp);
+    }
+    else if (kind == StrokeLogRecord::End) {
+        _log->endStroke(_logSlot, location, width, timestamp);
+    }
+    else {
+        _log->addSample(_logSlot, location, width, timestamp);
+    }
+
+    _logSlot = kind == StrokeLogRecord::End ? NoLogSlot : _logSlot;
+    _logPoint = LinePoint {location, width};
+    _logTime = timestamp;
+}
+
+float StrokePipeline::extractSize(Vec2 velocity)
+{
+    float size = velocity.getLength() / SpeedPerWidth;
+    size = std::min(std::max(size, MinWidth), MaxWidth);
+
+    if (_lastSize != 0.0) {
+        size = size * 0.8f + _lastSize * 0.2f;
+    }
+    _lastSize = size;
+
+    return size;
+}
+
+void StrokePipeline::setThreaded(bool threaded)
+{
+    if (threaded == isThreaded())
+        return;
+
+    _points.clear();
+    _hasLastPoint = false;
+    _framePoints = nullptr;
+    _framePointCount = 0;
+    _workerMesh = nullptr;
+    if (threaded)
+        _worker.reset(new TessellationWorker(_smoother, _tessellator, _enableLineSmoothing));
+    else
+        _worker.reset();
+}
+
+bool StrokePipeline::drawFrame(bool wait)
+{
+    if (_worker)
+        return acquireFrame(wait);
+
+    //! the two points kept from the last frame aren't new
+    if (_points.size() <= 2) {
+        predict();
+        return false;
+    }
+
+    if (_profiler)
+        _profiler->current().rawPoints += _points.size();
+
+    if (_enableLineSmoothing) {
+        begin(FrameStats::Smoothing);
+        _smoother.smoothLinePoints(_points.data(), _points.size(), _smoothPoints);
+        end(FrameStats::Smoothing);
+
+        _framePoints = _smoothPoints.data();
+        _framePointCount = _smoothPoints.size();
+    }
+    else {
+        //! only valid until the next input point, the window storage may move then
+        _framePoints = _points.data();
+        _framePointCount = _points.size();
+    }
+
+    begin(FrameStats::Tessellation);
+    _tessellator.drawLines(_framePoints, _framePointCount);
+    //! the piece continues from the last cross section of the stroke mesh, so it is the same geometry as
+    //! tessellating the whole stroke again
+    if (_retainStroke)
+        _strokeMesh.append(_tessellator.getMesh());
+    end(FrameStats::Tessellation);
+
+    if (_profiler)
+        _profiler->current().smoothedPoints += _framePointCount;
+    countGeometry(_tessellator.getMesh());
+
+    _inkEnd = _framePoints[_framePointCount - 1];
+    _hasInkEnd = true;
+    _points.keepLast(2);
+    predict();
+    return true;
+}
+
+//! The smoothed ink ends halfway to the last input point, the wet ink picks up from there. Its own
+//! tessellator caps both ends, the start cap lies over the drawn ink.
+void StrokePipeline::predict()
+{
+    _predictionPoints.clear();
+    if (_stroking && _hasLastPoint && _predictor.getHorizon() > 0) {
+        _predictor.predict(_lastPoint.width, _predictedPoints);
+        if (_hasInkEnd)
+            _predictionPoints.push_back(_inkEnd);
+        _predictionPoints.push_back(_lastPoint);
+        _predictionPoints.insert(_predictionPoints.end(), _predictedPoints.begin(), _predictedPoints.end());
+    }
+
+    if (_predictionPoints.size() < 2) {
+        _predictionPoints.clear();
+        _predictionTessellator.drawLines(nullptr, 0);
+        return;
+    }
+    begin(FrameStats::Tessellation);
+    _predictionTessellator.setCapTolerance(_tessellator.getCapTolerance());
+    _predictionTessellator.startNewLine();
+    _predictionTessellator.finishLine();
+    _predictionTessellator.drawLines(_predictionPoints.data(), _predictionPoints.size());
+    end(FrameStats::Tessellation);
+}
+
+bool StrokePipeline::acquireFrame(bool wait)
+{
+    _worker->submit();
+    StrokeMesh *mesh = _worker->acquireMesh();
+
+    //! the rest of the points may come in several worker meshes: the frame draws them joined. The wait is
+    //! the main thread's share of the tessellation, and is timed as that.
+    if (wait && !_worker->isIdle()) {
+        begin(FrameStats::Tessellation);
+        _waitMesh.clear();
+        if (mesh)
+            _waitMesh.append(*mesh);
+        while (!_worker->isIdle()) {
+            _worker->waitForMesh();
+            if (StrokeMesh *next = _worker->acquireMesh())
+                _waitMesh.append(*next);
+        }
+        mesh = _waitMesh.empty() ? nullptr : &_waitMesh;
+        end(FrameStats::Tessellation);
+    }
+
+    if (mesh == nullptr)
+        return false;
+    _workerMesh = mesh;
+    countGeometry(*mesh);
+    return true;
+}
+
+//! added to the frame's counts, which sum the pipelines of every finger down
+void StrokePipeline::countGeometry(const StrokeMesh &mesh)
+{
+    if (_profiler) {
+        auto &stats = _profiler->current();
+        stats.vertices += mesh.getVertices().size();
+        stats.indices += mesh.getIndices().size();
+        stats.batches += mesh.getBatches().size();
+        stats.dirtyArea += mesh.getBounds().getArea();
+    }
+}
+
+}
@@ -0,0 +1,274 @@
+//
+//  StrokePipeline.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef StrokePipeline_hpp
+#define StrokePipeline_hpp
+
+#include <memory>
+#include <vector>
+#include "FrameProfiler.hpp"
+#include "InkPredictor.hpp"
+#include "PanTracker.hpp"
+#include "PointWindow.hpp"
+#include "StrokeLog.hpp"
+#include "StrokeModel.hpp"
+#include "StrokeSmoother.hpp"
+#include "StrokeTessellator.hpp"
+#include "TessellationWorker.hpp"
+
+namespace stroke {
+
+//! Everything between a pan gesture and a stroke mesh: pan events become width carrying line points,
+//! and every frame the points that arrived since the last one are smoothed and tessellated. LineDrawer
+//! feeds it from the gesture recognizer and draws the mesh; the headless benchmarks drive it directly.
+//!
+//! Threaded, the smoothing and tessellation move to a TessellationWorker: the pan events and the model
+//! recording stay on the calling thread, the points are queued to the worker, and drawFrame() only picks up
+//! the latest mesh the worker has finished.
+//!
+//! With a prediction horizon, every frame also builds a prediction mesh: the wet ink from the end of the
+//! drawn ink through the input the smoother holds back to where the InkPredictor expects the pen to be. It is
+//! drawn over the canvas for one frame, never into it, and rebuilt from the real points on the next.
+class StrokePipeline {
+
+public:
+    //! input points closer than this to the previous one are dropped
+    static constexpr float MinPointDistance = 1.5f;
+    //! stroke width follows pan speed: one point of width per SpeedPerWidth points per second, clamped
+    static constexpr float SpeedPerWidth = 166.0f;
+    static constexpr float MinWidth = 1.0f;
+    static constexpr float MaxWidth = 40.0f;
+
+public:
+    StrokePipeline () : _framePoints(nullptr), _framePointCount(0), _hasLastPoint(false), _enableLineSmoothing(true), _retainStroke(false), _lastSize(0.0f), _workerMesh(nullptr), _profiler(nullptr), _model(nullptr), _modelScale(1), _modelStroke(NoStroke), _stroking(false), _hasInkEnd(false), _log(nullptr), _logSlot(NoLogSlot)
+    {
+        _predictor.setHorizon(0);
+    }
+
+    using time_point = InkPredictor::time_point;
+
+    //! the pan gesture states, with the recognizer's location, velocity and touch timestamp at the time
+    void panBegan(Vec2 location, Vec2 velocity, time_point timestamp);
+    void panChanged(Vec2 location, Vec2 velocity, time_point timestamp);
+    void panCompleted(Vec2 location, Vec2 velocity);
+    //! Every sample of a pan event at once, oldest first, as PanTracker::getSamples() has them; the stroke
+    //! begins at the first sample.
+    void panBegan(const PanSample *samples, size_t count);
+    void panChanged(const PanSample *samples, size_t count);
+
+    //! drops the points not drawn yet, including the two the last frame kept to continue from.
+    void clearPoints()
+    {
+        _hasLastPoint = false;
+        if (_worker)
+            _worker->clearPoints();
+        else
+            _points.clear();
+    }
+
+    void startNewLine(Vec2 point, float size)
+    {
+        //! a stroke of its own, other pipelines may be recording theirs into the same model
+        if (_model) {
+            _model->endStroke(_modelStroke);
+            _modelStroke = _model->openStroke();
+        }
+        _stroking = true;
+        _hasInkEnd = false;
+        if (_worker) {
+            _worker->startNewLine(record(point, size));
+            return;
+        }
+        _tessellator.startNewLine();
+        _strokeMesh.clear();
+        push(record(point, size));
+    }
+    void addPoint(Vec2 point, float size)
+    {
+        if (_worker)
+            _worker->addPoint(record(point, size));
+        else
+            push(record(point, size));
+    }
+    //! a batch of points of the line, in one pass
+    void addPoints(const LinePoint *points, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i) {
+            if (_worker)
+                _worker->addPoint(record(points[i].pos, points[i].width));
+            else
+                push(record(points[i].pos, points[i].width));
+        }
+    }
+    void endLine(Vec2 point, float size)
+    {
+        if (_worker) {
+            _worker->endLine(record(point, size));
+        }
+        else {
+            push(record(point, size));
+            _tessellator.finishLine();
+        }
+        if (_model)
+            _model->endStroke(_modelStroke);
+        _modelStroke = NoStroke;
+        _stroking = false;
+        _predictor.reset();
+    }
+
+    //! stroke width for a pan velocity, low pass filtered against the previous width of the stroke.
+    float extractSize(Vec2 velocity);
+
+    //! Smooths and tessellates the points added since the last frame, keeping the last two to continue from.
+    //! Returns false, leaving the previous mesh, when there is nothing new to draw.
+    //!
+    //! Threaded, takes whatever the worker has built since the last frame instead, which may lag the input
+    //! by a frame. With wait it first waits for the worker to build every point queued so far, for a frame
+    //! that must have all of a stroke's ink, such as the one a stroke ends on.
+    bool drawFrame(bool wait = false);
+
+    //! the geometry of the last drawFrame() that returned true, the whole stroke so far if retained.
+    StrokeMesh &getMesh() { return _workerMesh ? *_workerMesh : _retainStroke ? _strokeMesh : _tessellator.getMesh(); }
+    //! the polyline that mesh was built from; not kept when threaded.
+    const LinePoint *getFramePoints() const { return _framePoints; }
+    size_t getFramePointCount() const { return _framePointCount; }
+
+    //! How far ahead of the input to predict the ink, in seconds; 0, the default, predicts nothing. Not
+    //! predicted when threaded, where the drawn ink lags the input by a frame anyway.
+    void setPredictionHorizon(float seconds) { _predictor.setHorizon(seconds); }
+    float getPredictionHorizon() const { return _predictor.getHorizon(); }
+    //! The wet ink of the last drawFrame(), whether or not it returned true; empty between strokes. Drawn
+    //! over the canvas, it stays unchanged until the next drawFrame().
+    const StrokeMesh &getPredictionMesh() { return _predictionTessellator.getMesh(); }
+    //! the polyline of the prediction mesh, its last point is the predicted pen tip
+    const std::vector<LinePoint> &getPredictionPoints() const { return _predictionPoints; }
+
+    //! Moves smoothing and tessellation to a worker thread, or back. The worker starts with copies of the
+    //! smoother's and tessellator's settings; switch between strokes, points not drawn yet are dropped.
+    void setThreaded(bool threaded);
+    bool isThreaded() const { return _worker != nullptr; }
+    //! nullptr unless threaded.
+    const TessellationWorker *getWorker() const { return _worker.get(); }
+
+    //! true unless a threaded pipeline has points queued whose mesh drawFrame() hasn't returned yet.
+    bool isIdle() const { return !_worker || _worker->isIdle(); }
+
+    //! With retain, the mesh is the whole stroke so far rather than the frame's piece of it: a live stroke
+    //! that is drawn over the canvas every frame and into it once, when it ends. Each frame still smooths and
+    //! tessellates only its new points and appends their piece, so a frame costs its points, not the
+    //! stroke's. Switch between strokes; ignored when threaded.
+    void setRetainStroke(bool retain) { _retainStroke = retain; }
+    bool isRetainStroke() const { return _retainStroke; }
+
+    void setLineSmoothing(bool enable) { _enableLineSmoothing = enable; }
+    bool isLineSmoothing() const { return _enableLineSmoothing; }
+
+    //! drawFrame() measures its phases and adds to the geometry counts of the profiler's current frame.
+    //! Beginning and ending frames is up to the caller, which may have phases of its own.
+    void setProfiler(FrameProfiler *profiler) { _profiler = profiler; }
+
+    //! Every line point queued from now on is also recorded into model, nullptr to stop. scale maps the
+    //! input coordinates to the model's, when the input is drawn zoomed. Switching models ends the stroke
+    //! being recorded in the old one, and a stroke in progress carries on as a new stroke of model.
+    void setModel(StrokeModel *model, float scale = 1)
+    {
+        if (model != _model) {
+            if (_model)
+                _model->endStroke(_modelStroke);
+            _modelStroke = NoStroke;
+        }
+        _model = model;
+        _modelScale = scale;
+    }
+    StrokeModel *getModel() { return _model; }
+
+    //! Every pan sample from now on is also recorded into log, with the width extracted for it, nullptr to
+    //! stop. Samples too close to draw are recorded too, at the last width. Switching logs ends the stroke in
+    //! progress in the old one at its last sample, and it carries on as a new stroke of log.
+    void setLog(StrokeLogWriter *log);
+    StrokeLogWriter *getLog() { return _log; }
+
+    StrokeSmoother &getSmoother() { return _smoother; }
+    StrokeTessellator &getTessellator() { return _tessellator; }
+    const PointWindow &getPendingPoints() const { return _points; }
+
+private:
+    void begin(FrameStats::Phase phase) { if (_profiler) _profiler->begin(phase); }
+    void end(FrameStats::Phase phase) { if (_profiler) _profiler->end(phase); }
+
+    //! the point as queued, recorded into the model on the way
+    LinePoint record(Vec2 point, float size)
+    {
+        _lastPoint = LinePoint {point, size};
+        _hasLastPoint = true;
+        if (_model) {
+            if (!_model->isStrokeOpen(_modelStroke))
+                _modelStroke = _model->openStroke();
+            _model->addPoint(_modelStroke, LinePoint {point * _modelScale, size * _modelScale});
+        }
+        return _lastPoint;
+    }
+
+    void push(const LinePoint &point) { _points.push_back(point); }
+
+    bool acquireFrame(bool wait);
+    void countGeometry(const StrokeMesh &mesh);
+    void predict();
+    void logSample(StrokeLogRecord::Kind kind, Vec2 location, float width, time_point timestamp);
+
+private:
+    //! both persist across frames, a stroke in progress doesn't allocate once they have grown
+    PointWindow _points;
+    std::vector<LinePoint> _smoothPoints;
+    const LinePoint *_framePoints;
+    size_t _framePointCount;
+    //! the last point queued since the points were cleared
+    LinePoint _lastPoint;
+    bool _hasLastPoint;
+
+    StrokeSmoother _smoother;
+    StrokeTessellator _tessellator;
+    bool _enableLineSmoothing;
+    bool _retainStroke;
+    //! retained, every frame's piece of the stroke so far; keeps its storage across strokes
+    StrokeMesh _strokeMesh;
+    float _lastSize;
+
+    std::unique_ptr<TessellationWorker> _worker;
+    StrokeMesh *_workerMesh;
+    //! the worker meshes of a frame that waited for the worker, joined
+    StrokeMesh _waitMesh;
+
+    FrameProfiler *_profiler;
+    StrokeModel *_model;
+    float _modelScale;
+    //! the index of the stroke being recorded in _model
+    size_t _modelStroke;
+    static constexpr size_t NoStroke = (size_t)-1;
+
+    InkPredictor _predictor;
+    StrokeTessellator _predictionTessellator;
+    std::vector<LinePoint> _predictionPoints, _predictedPoints;
+    //! between startNewLine() and endLine()
+    bool _stroking;
+    //! the last point of the ink drawn so far in the stroke
+    LinePoint _inkEnd;
+    bool _hasInkEnd;
+
+    StrokeLogWriter *_log;
+    //! the slot of the stroke being recorded in _log, and its last sample
+    uint32_t _logSlot;
+    static constexpr uint32_t NoLogSlot = UINT32_MAX;
+    LinePoint _logPoint;
+    time_point _logTime;
+
+};
+
+}
+
+#endif /* StrokePipeline_hpp */
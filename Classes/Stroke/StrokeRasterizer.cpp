@@ -0,0 +1,61 @@
+//
+//  StrokeRasterizer.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "StrokeRasterizer.hpp"
+
+namespace stroke {
+
+static bool overlaps(const Bounds &a, const Bounds &b)
+{
+    return !a.isEmpty() && !b.isEmpty() && a.minX <= b.maxX && b.minX <= a.maxX && a.minY <= b.maxY && b.minY <= a.maxY;
+}
+
+void StrokeRasterizer::rasterize(const StrokeModel &model, const Bounds &region, float scale, StrokeMesh &mesh)
+{
+    mesh.clear();
+    _strokeCount = 0;
+
+    //! the fringe is a fixed width at the output scale
+    const float fringe = StrokeTessellator::Overdraw / scale;
+
+    for (size_t i = 0; i < model.getStrokeCount(); ++i) {
+        auto &stroke = model.getStroke(i);
+        if (!overlaps(stroke.bounds.expanded(fringe), region))
+            continue;
+
+        appendStroke(model, i, scale, mesh);
+        _strokeCount++;
+    }
+}
+
+void StrokeRasterizer::rasterizeStroke(const StrokeModel &model, size_t index, float scale, StrokeMesh &mesh)
+{
+    mesh.clear();
+    appendStroke(model, index, scale, mesh);
+    _strokeCount = 1;
+}
+
+void StrokeRasterizer::appendStroke(const StrokeModel &model, size_t index, float scale, StrokeMesh &mesh)
+{
+    model.decode(index, _points);
+    for (auto &point : _points) {
+        point.pos *= scale;
+        point.width *= scale;
+    }
+
+    _smoother.smoothLinePoints(_points, _smoothPoints);
+
+    _tessellator.startNewLine();
+    if (model.getStroke(index).finished)
+        _tessellator.finishLine();
+    _tessellator.drawLines(_smoothPoints);
+
+    mesh.append(_tessellator.getMesh());
+}
+
+}
@@ -0,0 +1,54 @@
+//
+//  StrokeRasterizer.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef StrokeRasterizer_hpp
+#define StrokeRasterizer_hpp
+
+#include <vector>
+#include "StrokeModel.hpp"
+#include "StrokeSmoother.hpp"
+#include "StrokeTessellator.hpp"
+
+namespace stroke {
+
+//! Tessellates the retained strokes of a StrokeModel again, at any scale. Each stroke is smoothed and
+//! tessellated whole with its widths scaled, so curve flattening, cap segments and the antialiasing fringe
+//! are all chosen for the output resolution rather than magnified from the one it was drawn at.
+class StrokeRasterizer {
+
+public:
+    StrokeRasterizer () : _strokeCount(0) {}
+
+    //! Replaces mesh with the strokes whose bounds overlap region, in model coordinates, tessellated with
+    //! every position and width multiplied by scale.
+    void rasterize(const StrokeModel &model, const Bounds &region, float scale, StrokeMesh &mesh);
+
+    //! replaces mesh with the model's stroke at index alone, at scale.
+    void rasterizeStroke(const StrokeModel &model, size_t index, float scale, StrokeMesh &mesh);
+
+    //! strokes the last rasterize() drew
+    size_t getStrokeCount() const { return _strokeCount; }
+
+    StrokeSmoother &getSmoother() { return _smoother; }
+    StrokeTessellator &getTessellator() { return _tessellator; }
+
+private:
+    void appendStroke(const StrokeModel &model, size_t index, float scale, StrokeMesh &mesh);
+
+private:
+    StrokeSmoother _smoother;
+    StrokeTessellator _tessellator;
+
+    std::vector<LinePoint> _points, _smoothPoints;
+    size_t _strokeCount;
+
+};
+
+}
+
+#endif /* StrokeRasterizer_hpp */
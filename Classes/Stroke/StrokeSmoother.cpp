@@ -0,0 +1,92 @@
+//
+//  StrokeSmoother.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "StrokeSmoother.hpp"
+
+#include <algorithm>
+#include "QuadraticEvaluator.hpp"
+
+namespace stroke {
+
+constexpr float StrokeSmoother::DefaultFlatteningTolerance;
+constexpr int StrokeSmoother::MaxSegments;
+
+namespace {
+
+int fixedSegments(const LinePoint &start, const LinePoint &end)
+{
+    int segmentDistance = 2;
+    float distance = (start.pos - end.pos).getLength();
+    return std::min(StrokeSmoother::MaxSegments, std::max((int)floorf(distance / segmentDistance), 32));
+}
+
+//! Splitting a quadratic into n uniform steps in t keeps every chord within |B''| / (8 n^2) of the curve,
+//! with B'' = 2 (start - 2 control + end). The stroke edges sit at +-width/2 from the centre line, so the
+//! width curve contributes half of its own second difference to the edge deviation.
+int adaptiveSegments(const LinePoint &start, const LinePoint &control, const LinePoint &end, float tolerance)
+{
+    Vec2 secondDifference = start.pos - control.pos * 2 + end.pos;
+    float widthSecondDifference = start.width - 2 * control.width + end.width;
+
+    float deviation = secondDifference.getLength() + 0.5f * fabsf(widthSecondDifference);
+    int segments = (int)ceilf(sqrtf(deviation / (4 * tolerance)));
+    return std::min(StrokeSmoother::MaxSegments, std::max(segments, 1));
+}
+
+}
+
+int StrokeSmoother::numberOfSegments(const LinePoint &start, const LinePoint &control, const LinePoint &end) const
+{
+    if (_flattening == Flattening::Adaptive)
+        return adaptiveSegments(start, control, end, _tolerance);
+
+    return fixedSegments(start, end);
+}
+
+void StrokeSmoother::smoothLinePoints(const LinePoint *linePoints, size_t count, std::vector<LinePoint> &result)
+{
+    result.clear();
+
+    if (count <= 2)
+        return;
+
+    auto startOf = [&] (size_t i) {
+        return LinePoint {(linePoints[i - 1].pos + linePoints[i - 2].pos) * .5, (linePoints[i - 1].width + linePoints[i - 2].width) * 0.5f};
+    };
+    auto endOf = [&] (size_t i) {
+        return LinePoint {(linePoints[i].pos + linePoints[i - 1].pos) * .5, (linePoints[i].width + linePoints[i - 1].width) * 0.5f};
+    };
+
+    //! size the output once, every curve is then written in place by the evaluator
+    size_t total = 0;
+    size_t fixedTotal = 0;
+    for (size_t i = 2; i < count; ++i) {
+        LinePoint start = startOf(i), end = endOf(i);
+        total += numberOfSegments(start, linePoints[i - 1], end) + 1;
+        fixedTotal += fixedSegments(start, end) + 1;
+    }
+    result.resize(total);
+
+    LinePoint *out = result.data();
+    for (size_t i = 2; i < count; ++i) {
+        LinePoint start = startOf(i), end = endOf(i);
+        const LinePoint &control = linePoints[i - 1];
+
+        int segments = numberOfSegments(start, control, end);
+        QuadraticEvaluator::evaluate(QuadraticCurve::fromControlPoints(start, control, end), segments, out);
+        out += segments;
+
+        *out++ = end;
+    }
+
+    _stats.curves += count - 2;
+    _stats.fixedSamples += fixedTotal;
+    _stats.emittedSamples += total;
+}
+
+}
@@ -0,0 +1,75 @@
+//
+//  StrokeSmoother.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef StrokeSmoother_hpp
+#define StrokeSmoother_hpp
+
+#include <stddef.h>
+#include <vector>
+#include "StrokeTypes.hpp"
+
+namespace stroke {
+
+//! Turns raw input points into a smooth polyline by running a quadratic curve from the midpoint of each
+//! pair of input segments to the next, with the input point in between as the control point.
+class StrokeSmoother {
+
+public:
+    enum class Flattening {
+        //! one sample every 2 points of chord length, clamped to 32...128 samples per curve
+        Fixed,
+        //! as few samples as keep the polyline within the flattening tolerance of the curve
+        Adaptive
+    };
+
+    static constexpr float DefaultFlatteningTolerance = 0.1f;
+    static constexpr int MaxSegments = 128;
+
+    struct Stats {
+        size_t curves;
+        //! samples the Fixed mode would have emitted for the same curves
+        size_t fixedSamples;
+        size_t emittedSamples;
+
+        size_t getSavedSamples() const { return fixedSamples > emittedSamples ? fixedSamples - emittedSamples : 0; }
+    };
+
+public:
+    StrokeSmoother () : _flattening(Flattening::Adaptive), _tolerance(DefaultFlatteningTolerance), _stats {0, 0, 0} {}
+
+    void setFlattening(Flattening flattening) { _flattening = flattening; }
+    Flattening getFlattening() const { return _flattening; }
+
+    //! largest distance, in points, the stroke edges may deviate from the true curve in Adaptive mode.
+    void setFlatteningTolerance(float tolerance) { _tolerance = tolerance > 0.001f ? tolerance : 0.001f; }
+    float getFlatteningTolerance() const { return _tolerance; }
+
+    //! result is cleared and refilled, so a result kept across frames stops allocating once it has grown to the largest frame.
+    void smoothLinePoints(const LinePoint *linePoints, size_t count, std::vector<LinePoint> &result);
+    void smoothLinePoints(const std::vector<LinePoint> &linePoints, std::vector<LinePoint> &result)
+    {
+        smoothLinePoints(linePoints.data(), linePoints.size(), result);
+    }
+
+    //! number of segments the curve from start to end around control is split into under the current mode.
+    int numberOfSegments(const LinePoint &start, const LinePoint &control, const LinePoint &end) const;
+
+    //! accumulated since the last resetStats().
+    const Stats &getStats() const { return _stats; }
+    void resetStats() { _stats = Stats {0, 0, 0}; }
+
+private:
+    Flattening _flattening;
+    float _tolerance;
+    Stats _stats;
+
+};
+
+}
+
+#endif /* StrokeSmoother_hpp */
@@ -0,0 +1,160 @@
+//
+//  StrokeTessellator.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "StrokeTessellator.hpp"
+
+namespace stroke {
+
+constexpr float StrokeTessellator::Overdraw;
+constexpr int StrokeTessellator::VerticesPerSegment;
+constexpr float StrokeTessellator::DefaultCapTolerance;
+
+void StrokeTessellator::drawLines(const LinePoint *linePoints, size_t count)
+{
+    const float solid = 1, fadeOut = 0;
+
+    _mesh.clear();
+    _sectionInBatch = false;
+    _capIndexStart = 0;
+
+    if (count == 0)
+        return;
+
+    LinePoint prevPoint = linePoints[0];
+
+    //! at most a start and an end cap per frame
+    CirclePoint caps[2];
+    int capCount = 0;
+
+    for (size_t i = 1; i < count; i++) {
+        auto curPoint = linePoints[i];
+
+        if (curPoint.pos.fuzzyEquals(prevPoint.pos, 0.0001f)) {
+            continue;
+        }
+
+        Vec2 dir = curPoint.pos - prevPoint.pos;
+        Vec2 perp = dir.getPerp().getNormalized();
+        Vec2 A = prevPoint.pos + perp * prevPoint.width / 2;
+        Vec2 B = prevPoint.pos - perp * prevPoint.width / 2;
+        Vec2 C = curPoint.pos + perp * curPoint.width / 2;
+        Vec2 D = curPoint.pos - perp * curPoint.width / 2;
+
+        //! Add overdraw
+        Vec2 F = A + perp * Overdraw;
+        Vec2 G = C + perp * Overdraw;
+        Vec2 H = B - perp * Overdraw;
+        Vec2 I = D - perp * Overdraw;
+
+        if (_connectingLine || !_mesh.empty()) {
+            //! the segment starts on the cross section the previous one ended with
+            A = _prevC;
+            B = _prevD;
+            F = _prevG;
+            H = _prevI;
+        } else {
+            caps[capCount++] = CirclePoint {curPoint.pos, curPoint.width, (linePoints[i - 1].pos - curPoint.pos).getNormalized()};
+        }
+
+        //! Only the end cross section G C D I is new. The start one is reused from the previous segment,
+        //! unless this is the first segment of the frame or the mesh just opened a new batch.
+        if (_mesh.beginPrimitive(8, 18) == 0) {
+            _sectionInBatch = false;
+        }
+        if (!_sectionInBatch) {
+            _section[0] = _mesh.addVertex(Vertex {F.x, F.y, fadeOut});
+            _section[1] = _mesh.addVertex(Vertex {A.x, A.y, solid});
+            _section[2] = _mesh.addVertex(Vertex {B.x, B.y, solid});
+            _section[3] = _mesh.addVertex(Vertex {H.x, H.y, fadeOut});
+        }
+        const unsigned short iF = _section[0], iA = _section[1], iB = _section[2], iH = _section[3];
+
+        const unsigned short iG = _mesh.addVertex(Vertex {G.x, G.y, fadeOut});
+        const unsigned short iC = _mesh.addVertex(Vertex {C.x, C.y, solid});
+        const unsigned short iD = _mesh.addVertex(Vertex {D.x, D.y, solid});
+        const unsigned short iI = _mesh.addVertex(Vertex {I.x, I.y, fadeOut});
+
+        _mesh.addTriangle(iA, iB, iC);
+        _mesh.addTriangle(iB, iC, iD);
+
+        _mesh.addTriangle(iF, iA, iG);
+        _mesh.addTriangle(iA, iG, iC);
+
+        _mesh.addTriangle(iB, iH, iD);
+        _mesh.addTriangle(iH, iD, iI);
+
+        _section[0] = iG;
+        _section[1] = iC;
+        _section[2] = iD;
+        _section[3] = iI;
+        _sectionInBatch = true;
+
+        _prevC = C;
+        _prevD = D;
+        _prevG = G;
+        _prevI = I;
+
+        if (_finishingLine && (i == count - 1)) {
+            caps[capCount++] = CirclePoint {curPoint.pos, curPoint.width, (curPoint.pos - linePoints[i - 1].pos).getNormalized()};
+            _finishingLine = false;
+        }
+
+        prevPoint = curPoint;
+    }
+
+    _capIndexStart = _mesh.getIndices().size();
+    for (int i = 0; i < capCount; ++i) {
+        triangulateCircle(caps[i], Overdraw, _capTolerance, _mesh);
+    }
+
+    if (!_mesh.empty()) {
+        _connectingLine = true;
+    }
+}
+
+void StrokeTessellator::triangulateCircle(CirclePoint circle, float overdraw, float tolerance, StrokeMesh &mesh)
+{
+    const float solid = 1, fadeOut = 0;
+
+    const float radius = circle.width * .5;
+    const auto halfCircle = UnitCircle::halfCircleFor(radius, tolerance);
+    const int numberOfSegments = halfCircle.segments;
+
+    //! the rim starts at dir's counter clockwise perpendicular and turns clockwise through PI
+    Vec2 start = circle.dir.getPerp();
+    if (start.getLengthSq() < 1e-12f) {
+        start = Vec2 {1, 0};
+    }
+
+    //! the whole cap goes into one batch: the center, then a rim and an overdraw vertex per table entry
+    mesh.beginPrimitive(1 + (numberOfSegments + 1) * 2, numberOfSegments * 9);
+    const unsigned short centerIndex = mesh.addVertex(Vertex {circle.pos.x, circle.pos.y, solid});
+
+    unsigned short prevIndex = 0, prevOverdrawIndex = 0;
+    for (int i = 0; i <= numberOfSegments; ++i) {
+        Vec2 dir = UnitCircle::rotate(start, halfCircle.points[i]);
+        Vec2 curPoint = circle.pos + dir * radius;
+        Vec2 overdrawnPoint = curPoint + dir * overdraw;
+
+        unsigned short currentIndex = mesh.addVertex(Vertex {curPoint.x, curPoint.y, solid});
+        unsigned short overdrawIndex = mesh.addVertex(Vertex {overdrawnPoint.x, overdrawnPoint.y, fadeOut});
+
+        if (i > 0) {
+            mesh.addTriangle(centerIndex, prevIndex, currentIndex);
+
+            // triangulate a overdrawn rect
+            mesh.addTriangle(prevIndex, overdrawIndex, prevOverdrawIndex);
+            mesh.addTriangle(prevIndex, currentIndex, overdrawIndex);
+        }
+
+        prevIndex = currentIndex;
+        prevOverdrawIndex = overdrawIndex;
+    }
+}
+
+}
@@ -0,0 +1,76 @@
+//
+//  StrokeTessellator.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef StrokeTessellator_hpp
+#define StrokeTessellator_hpp
+
+#include <algorithm>
+#include <vector>
+#include "StrokeTypes.hpp"
+#include "StrokeMesh.hpp"
+#include "UnitCircle.hpp"
+
+namespace stroke {
+
+//! Builds the triangle mesh for a stroke: a solid quad per line segment with a faded overdraw quad on each
+//! side for antialiasing, and round caps at both ends. Consecutive segments share the cross section between
+//! them (outer fringe, edge, edge, outer fringe), so each segment adds 4 vertices rather than 12.
+//! A stroke is tessellated incrementally, one batch of points per frame, so the tessellator remembers the
+//! last cross section to connect the next batch to it.
+class StrokeTessellator {
+
+public:
+    static constexpr float Overdraw = .5f;
+    //! the end cross section of every segment of the polyline
+    static constexpr int VerticesPerSegment = 4;
+    //! how far a cap's rim chords may stray from the true circle, in points
+    static constexpr float DefaultCapTolerance = 0.1f;
+
+public:
+    StrokeTessellator () : _connectingLine(false), _finishingLine(false), _sectionInBatch(false), _section {},
+    _capTolerance(DefaultCapTolerance), _capIndexStart(0) {}
+
+    void startNewLine() { _connectingLine = false; }
+    void finishLine() { _finishingLine = true; }
+
+    //! replaces the current mesh with the geometry for linePoints, continuing from the previous batch.
+    //! the mesh is colorless, vertices carry coverage and the renderer supplies the color.
+    //! the mesh keeps its storage across calls, so steady state strokes don't allocate.
+    void drawLines(const LinePoint *linePoints, size_t count);
+    void drawLines(const std::vector<LinePoint> &linePoints) { drawLines(linePoints.data(), linePoints.size()); }
+
+    //! the geometry of the last drawLines call, split into batches of at most 65535 vertices.
+    StrokeMesh &getMesh() { return _mesh; }
+
+    //! the caps follow the segments in the mesh, starting at this offset into its index list.
+    size_t getCapIndexStart() const { return _capIndexStart; }
+
+    void setCapTolerance(float tolerance) { _capTolerance = std::max(tolerance, 0.001f); }
+    float getCapTolerance() const { return _capTolerance; }
+
+    //! a half disc over circle.dir's side with an overdraw fringe, with as few rim segments as the tolerance allows.
+    static void triangulateCircle(CirclePoint circle, float overdraw, float tolerance, StrokeMesh &mesh);
+
+private:
+    bool _connectingLine, _finishingLine;
+    Vec2 _prevC, _prevD, _prevG, _prevI;
+
+    //! batch relative indices of the last cross section, valid while _sectionInBatch
+    bool _sectionInBatch;
+    unsigned short _section[4];
+
+    float _capTolerance;
+    size_t _capIndexStart;
+
+    StrokeMesh _mesh;
+
+};
+
+}
+
+#endif /* StrokeTessellator_hpp */
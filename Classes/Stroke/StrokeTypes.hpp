@@ -0,0 +1,138 @@
+//
+//  StrokeTypes.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef StrokeTypes_hpp
+#define StrokeTypes_hpp
+
+#include <cmath>
+#include <cstdint>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+//! Plain value types shared by the stroke geometry pipeline. Nothing in the stroke namespace depends on cocos2d,
+//! so the smoothing and tessellation code can be built and profiled without a GL context.
+namespace stroke {
+
+struct Vec2 {
+    float x, y;
+
+    Vec2() : x(0), y(0) {}
+    Vec2(float xx, float yy) : x(xx), y(yy) {}
+
+    Vec2 operator+(const Vec2 &v) const { return Vec2 {x + v.x, y + v.y}; }
+    Vec2 operator-(const Vec2 &v) const { return Vec2 {x - v.x, y - v.y}; }
+    Vec2 operator-() const { return Vec2 {-x, -y}; }
+    Vec2 operator*(float s) const { return Vec2 {x * s, y * s}; }
+    Vec2 operator/(float s) const { return Vec2 {x / s, y / s}; }
+    Vec2 &operator+=(const Vec2 &v) { x += v.x; y += v.y; return *this; }
+    Vec2 &operator-=(const Vec2 &v) { x -= v.x; y -= v.y; return *this; }
+    Vec2 &operator*=(float s) { x *= s; y *= s; return *this; }
+    bool operator==(const Vec2 &v) const { return x == v.x && y == v.y; }
+    bool operator!=(const Vec2 &v) const { return !(*this == v); }
+
+    float dot(const Vec2 &v) const { return x * v.x + y * v.y; }
+    float cross(const Vec2 &v) const { return x * v.y - y * v.x; }
+    float getLengthSq() const { return x * x + y * y; }
+    float getLength() const { return sqrtf(x * x + y * y); }
+
+    //! counter clockwise perpendicular, same as cocos2d::Vec2::getPerp()
+    Vec2 getPerp() const { return Vec2 {-y, x}; }
+
+    Vec2 getNormalized() const
+    {
+        float n = x * x + y * y;
+        if (n == 1.0f)
+            return *this;
+
+        n = sqrtf(n);
+        if (n < 2e-37f)
+            return *this;
+
+        n = 1.0f / n;
+        return Vec2 {x * n, y * n};
+    }
+
+    bool fuzzyEquals(const Vec2 &b, float var) const
+    {
+        return x - var <= b.x && b.x <= x + var && y - var <= b.y && b.y <= y + var;
+    }
+};
+
+inline Vec2 operator*(float s, const Vec2 &v) { return v * s; }
+
+//! Axis aligned bounding box, empty until the first point is added.
+struct Bounds {
+    float minX, minY, maxX, maxY;
+
+    Bounds() : minX(INFINITY), minY(INFINITY), maxX(-INFINITY), maxY(-INFINITY) {}
+    Bounds(float x0, float y0, float x1, float y1) : minX(x0), minY(y0), maxX(x1), maxY(y1) {}
+
+    bool isEmpty() const { return !(minX <= maxX && minY <= maxY); }
+    float getWidth() const { return isEmpty() ? 0 : maxX - minX; }
+    float getHeight() const { return isEmpty() ? 0 : maxY - minY; }
+    float getArea() const { return getWidth() * getHeight(); }
+
+    void add(float x, float y)
+    {
+        minX = fminf(minX, x);
+        minY = fminf(minY, y);
+        maxX = fmaxf(maxX, x);
+        maxY = fmaxf(maxY, y);
+    }
+
+    void add(const Bounds &b)
+    {
+        if (b.isEmpty())
+            return;
+        add(b.minX, b.minY);
+        add(b.maxX, b.maxY);
+    }
+
+    bool contains(float x, float y) const { return minX <= x && x <= maxX && minY <= y && y <= maxY; }
+    bool overlaps(const Bounds &b) const { return minX <= b.maxX && b.minX <= maxX && minY <= b.maxY && b.minY <= maxY; }
+
+    Bounds expanded(float margin) const
+    {
+        return isEmpty() ? *this : Bounds {minX - margin, minY - margin, maxX + margin, maxY + margin};
+    }
+};
+
+struct Color4F {
+    float r, g, b, a;
+};
+
+//! 12 bytes: z was always 0 and no texture is sampled, and the stroke color is a shader uniform, so a vertex
+//! only carries its coverage, 1 on the stroke body fading to 0 at the outer edge of the overdraw fringe.
+struct Vertex {
+    float x, y;
+    float coverage;
+};
+
+static constexpr float DefaultLineWidth = 1.0f;
+
+struct LinePoint {
+    Vec2 pos;
+    float width;
+
+    LinePoint (Vec2 p, float w) : pos(p), width(w) {}
+    LinePoint() : pos {0, 0}, width {DefaultLineWidth} {}
+};
+
+struct CirclePoint {
+    Vec2 pos;
+    float width;
+    Vec2 dir;
+    CirclePoint (Vec2 p, float w, Vec2 d) : pos(p), width(w), dir(d) {}
+    CirclePoint() : width(0) {}
+};
+
+}
+
+#endif /* StrokeTypes_hpp */
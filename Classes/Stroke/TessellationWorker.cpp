@@ -0,0 +1,185 @@
+//
+//  TessellationWorker.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "TessellationWorker.hpp"
+
+#include <chrono>
+#include "StrokePipeline.hpp"
+
+namespace stroke {
+
+constexpr size_t TessellationWorker::QueueCapacity;
+constexpr uint8_t TessellationWorker::IndexMask;
+constexpr uint8_t TessellationWorker::Fresh;
+
+TessellationWorker::TessellationWorker(const StrokeSmoother &smoother, const StrokeTessellator &tessellator, bool lineSmoothing)
+: _queue(QueueCapacity), _middle(1), _back(0), _consumed(0), _front(2), _pushed(0), _submitted(0), _published(0), _holding(false), _sleeping(false), _waiting(false), _stopping(false), _pipeline(new StrokePipeline)
+{
+    _pipeline->getSmoother() = smoother;
+    _pipeline->getTessellator() = tessellator;
+    _pipeline->setLineSmoothing(lineSmoothing);
+    _thread = std::thread(&TessellationWorker::work, this);
+}
+
+TessellationWorker::~TessellationWorker()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _wake.notify_one();
+    _thread.join();
+}
+
+void TessellationWorker::push(const Command &command)
+{
+    //! only when thousands of points come in a frame, or the worker is that far behind
+    while (!_queue.tryPush(command)) {
+        submit();
+        std::this_thread::yield();
+    }
+    _pushed++;
+}
+
+void TessellationWorker::submit()
+{
+    if (_submitted == _pushed)
+        return;
+    _submitted = _pushed;
+    wake();
+}
+
+StrokeMesh *TessellationWorker::acquireMesh()
+{
+    if (!(_middle.load(std::memory_order_acquire) & Fresh))
+        return nullptr;
+
+    //! only the worker sets Fresh, so the middle mesh can't change between the load and the exchange
+    _front = _middle.exchange(_front, std::memory_order_acq_rel) & IndexMask;
+    //! the worker may be holding built geometry until this mesh was taken. The fence pairs with the
+    //! worker's before it sleeps: either this sees it holding, or it sees the mesh taken and publishes.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_holding.load(std::memory_order_relaxed))
+        wake();
+    return &_meshes[_front];
+}
+
+bool TessellationWorker::isIdle() const
+{
+    return _published.load(std::memory_order_acquire) == _pushed && !(_middle.load(std::memory_order_acquire) & Fresh);
+}
+
+bool TessellationWorker::isReady() const
+{
+    return (_middle.load(std::memory_order_acquire) & Fresh) || isIdle();
+}
+
+//! the same handshake as wake(), the other way round
+void TessellationWorker::waitForMesh()
+{
+    if (isReady())
+        return;
+    std::unique_lock<std::mutex> lock(_mutex);
+    _waiting.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    _ready.wait(lock, [this] { return isReady(); });
+    _waiting.store(false, std::memory_order_relaxed);
+}
+
+//! Lock-free unless the worker is asleep. The fences pair with the worker's before it checks for work, so
+//! either the worker sees what was just pushed or this sees it asleep and wakes it under the mutex.
+void TessellationWorker::wake()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_sleeping.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _wake.notify_one();
+    }
+}
+
+void TessellationWorker::work()
+{
+    Command command;
+    for (;;) {
+        bool queued = false;
+        while (_queue.tryPop(command)) {
+            queued = true;
+            _consumed++;
+            switch (command.kind) {
+                case Command::Clear:
+                    _pipeline->clearPoints();
+                    break;
+                case Command::StartLine:
+                    _pipeline->startNewLine(command.point.pos, command.point.width);
+                    break;
+                case Command::Point:
+                    _pipeline->addPoint(command.point.pos, command.point.width);
+                    _stats.points++;
+                    break;
+                case Command::EndLine:
+                    //! built right away, so the next stroke's clear doesn't drop the end of this one
+                    _pipeline->endLine(command.point.pos, command.point.width);
+                    _stats.points++;
+                    build();
+                    break;
+            }
+        }
+        if (queued)
+            build();
+        publish();
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_waiting.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _ready.notify_one();
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        _wake.wait(lock, [this] { return _stopping || !_queue.empty() || canPublish(); });
+        _sleeping.store(false, std::memory_order_relaxed);
+        if (_stopping)
+            return;
+    }
+}
+
+void TessellationWorker::build()
+{
+    auto start = std::chrono::steady_clock::now();
+    if (!_pipeline->drawFrame())
+        return;
+    _meshes[_back].append(_pipeline->getMesh());
+
+    _stats.builds++;
+    _stats.buildMicros += (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool TessellationWorker::canPublish() const
+{
+    return !_meshes[_back].empty() && !(_middle.load(std::memory_order_acquire) & Fresh);
+}
+
+//! An empty back mesh means everything built so far has been handed over. Otherwise it goes to the main
+//! thread if the middle mesh has been taken; if not, it keeps growing until it has.
+void TessellationWorker::publish()
+{
+    if (!_meshes[_back].empty()) {
+        if (_middle.load(std::memory_order_acquire) & Fresh) {
+            _holding.store(true, std::memory_order_release);
+            return;
+        }
+        //! only the main thread clears Fresh, so the middle mesh is the front one it gave back
+        _back = _middle.exchange(_back | Fresh, std::memory_order_acq_rel) & IndexMask;
+        _meshes[_back].clear();
+        _holding.store(false, std::memory_order_relaxed);
+    }
+    _published.store(_consumed, std::memory_order_release);
+}
+
+}
@@ -0,0 +1,135 @@
+//
+//  TessellationWorker.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef TessellationWorker_hpp
+#define TessellationWorker_hpp
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "SpscQueue.hpp"
+#include "StrokeMesh.hpp"
+#include "StrokeSmoother.hpp"
+#include "StrokeTessellator.hpp"
+
+namespace stroke {
+
+class StrokePipeline;
+
+//! Smooths and tessellates line points on a thread of its own, for a StrokePipeline in threaded mode.
+//!
+//! The main thread queues the points through a lock-free single producer queue and never waits for them to
+//! be drawn; it wakes the worker once a frame, not for every point, which would cost a system call each.
+//! The worker runs a synchronous StrokePipeline of its own over whatever has arrived and appends
+//! the geometry to its back mesh. Meshes are triple buffered: the back one the worker builds into, the front
+//! one the main thread is drawing, and a middle one exchanged between them through a single atomic. The
+//! worker hands its back mesh over only once the main thread has taken the previous one, and otherwise keeps
+//! appending to it, so taking the latest mesh never skips geometry: each one holds everything built since
+//! the one before.
+class TessellationWorker {
+
+public:
+    //! line points and stroke boundaries the main thread can run ahead of the worker
+    static constexpr size_t QueueCapacity = 4096;
+
+    //! Time the worker spent building meshes, and how many it built. Written by the worker, read by anyone.
+    struct Stats {
+        Stats () : builds(0), buildMicros(0), points(0) {}
+
+        std::atomic<uint64_t> builds;
+        std::atomic<uint64_t> buildMicros;
+        std::atomic<uint64_t> points;
+    };
+
+public:
+    //! starts the thread, drawing with copies of the smoother's and tessellator's settings.
+    TessellationWorker (const StrokeSmoother &smoother, const StrokeTessellator &tessellator, bool lineSmoothing);
+    //! Stops the thread once it is done with the pass it is in, if any. Points it hasn't built yet, and
+    //! geometry it hasn't handed over, are dropped, as StrokePipeline::setThreaded() documents.
+    ~TessellationWorker();
+
+    TessellationWorker (const TessellationWorker &) = delete;
+    TessellationWorker &operator=(const TessellationWorker &) = delete;
+
+    //! the StrokePipeline calls of the same names, queued for the worker until submit(). Main thread only.
+    void clearPoints() { push(Command {Command::Clear, {}}); }
+    void startNewLine(const LinePoint &point) { push(Command {Command::StartLine, point}); }
+    void addPoint(const LinePoint &point) { push(Command {Command::Point, point}); }
+    void endLine(const LinePoint &point) { push(Command {Command::EndLine, point}); }
+
+    //! has the worker build the points queued since the last call. Main thread only.
+    void submit();
+
+    //! The geometry built since the last call, or nullptr if there is none yet. The mesh stays the main
+    //! thread's, unchanged, until the next call. Main thread only.
+    StrokeMesh *acquireMesh();
+
+    //! true once every point queued so far has been built and its mesh acquired. Main thread only.
+    bool isIdle() const;
+
+    //! Waits for the worker to have a mesh ready or to be idle, whichever comes first. Main thread only.
+    void waitForMesh();
+
+    const Stats &getStats() const { return _stats; }
+
+private:
+    struct Command {
+        enum Kind { Clear, StartLine, Point, EndLine };
+
+        Kind kind;
+        LinePoint point;
+    };
+
+    //! the middle mesh index, with Fresh set while the worker has published it and the main thread not taken it
+    static constexpr uint8_t IndexMask = 3;
+    static constexpr uint8_t Fresh = 4;
+
+    void push(const Command &command);
+    void work();
+    //! runs the worker pipeline over the points it has, appending to the back mesh
+    void build();
+    void publish();
+    bool canPublish() const;
+    bool isReady() const;
+    //! wakes the worker if it is waiting for something to do
+    void wake();
+
+private:
+    SpscQueue<Command> _queue;
+    StrokeMesh _meshes[3];
+    std::atomic<uint8_t> _middle;
+    //! the worker's
+    uint8_t _back;
+    uint64_t _consumed;
+    //! the main thread's
+    uint8_t _front;
+    uint64_t _pushed, _submitted;
+    //! commands whose geometry is in a published mesh
+    std::atomic<uint64_t> _published;
+    //! the worker has geometry it couldn't publish because the main thread hadn't taken the last mesh
+    std::atomic<bool> _holding;
+
+    Stats _stats;
+
+    std::mutex _mutex;
+    std::condition_variable _wake, _ready;
+    std::atomic<bool> _sleeping, _waiting;
+    bool _stopping;
+
+    //! owned by the worker thread, and last so that everything above is ready when it starts
+    std::unique_ptr<StrokePipeline> _pipeline;
+    std::thread _thread;
+
+};
+
+}
+
+#endif /* TessellationWorker_hpp */
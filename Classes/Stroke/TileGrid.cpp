@@ -0,0 +1,148 @@
+//
+//  TileGrid.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "TileGrid.hpp"
+
+#include <algorithm>
+
+namespace stroke {
+
+namespace {
+
+//! whether the triangle abc overlaps box, given that their bounds do: separated only along one of its edges' normals.
+bool triangleOverlaps(const Vertex &a, const Vertex &b, const Vertex &c, const Bounds &box)
+{
+    const Vertex *corners[3] = {&a, &b, &c};
+    for (int i = 0; i < 3; ++i) {
+        const Vertex &p = *corners[i], &q = *corners[(i + 1) % 3], &r = *corners[(i + 2) % 3];
+        float nx = p.y - q.y, ny = q.x - p.x;
+        float edge = nx * p.x + ny * p.y;
+        float apex = nx * r.x + ny * r.y;
+        float x0 = nx * box.minX, x1 = nx * box.maxX;
+        float y0 = ny * box.minY, y1 = ny * box.maxY;
+        float boxMin = std::min(x0, x1) + std::min(y0, y1);
+        float boxMax = std::max(x0, x1) + std::max(y0, y1);
+        if (boxMax < std::min(edge, apex) || std::max(edge, apex) < boxMin)
+            return false;
+    }
+    return true;
+}
+
+}
+
+constexpr float TileGrid::DefaultTileSize;
+constexpr size_t TileGrid::DefaultMemoryBudget;
+constexpr size_t TileGrid::BytesPerPixel;
+constexpr int TileGrid::NoTile;
+
+TileCoord TileGrid::tileAt(float x, float y) const
+{
+    //! floor, so negative coordinates land in negative tiles
+    return TileCoord {(int)floorf(x / _tileSize), (int)floorf(y / _tileSize)};
+}
+
+Bounds TileGrid::getTileBounds(TileCoord tile) const
+{
+    return Bounds {tile.x * _tileSize, tile.y * _tileSize, (tile.x + 1) * _tileSize, (tile.y + 1) * _tileSize};
+}
+
+void TileGrid::getOverlappingTiles(const Bounds &bounds, std::vector<TileCoord> &result) const
+{
+    if (bounds.isEmpty())
+        return;
+
+    TileCoord first = tileAt(bounds.minX, bounds.minY);
+    TileCoord last = tileAt(bounds.maxX, bounds.maxY);
+    for (int y = first.y; y <= last.y; ++y) {
+        for (int x = first.x; x <= last.x; ++x) {
+            result.push_back(TileCoord {x, y});
+        }
+    }
+}
+
+void TileGrid::getMeshTiles(const StrokeMesh &mesh, std::vector<TileCover> &result) const
+{
+    size_t first = result.size();
+    auto &vertices = mesh.getVertices();
+    auto &indices = mesh.getIndices();
+    for (auto &batch : mesh.getBatches()) {
+        const Vertex *v = vertices.data() + batch.vertexStart;
+        const unsigned short *index = indices.data() + batch.indexStart;
+        for (size_t i = 0; i < batch.indexCount; i += 3) {
+            const Vertex &a = v[index[i]], &b = v[index[i + 1]], &c = v[index[i + 2]];
+            Bounds triangle;
+            triangle.add(a.x, a.y);
+            triangle.add(b.x, b.y);
+            triangle.add(c.x, c.y);
+
+            TileCoord lo = tileAt(triangle.minX, triangle.minY);
+            TileCoord hi = tileAt(triangle.maxX, triangle.maxY);
+            bool spans = !(lo == hi);
+            for (int y = lo.y; y <= hi.y; ++y) {
+                for (int x = lo.x; x <= hi.x; ++x) {
+                    TileCoord tile {x, y};
+                    if (spans && !triangleOverlaps(a, b, c, getTileBounds(tile)))
+                        continue;
+                    //! a stroke's triangles come in order along it, mostly in the tile of the one before
+                    if (result.size() > first && result.back().tile == tile)
+                        result.back().bounds.add(triangle);
+                    else
+                        result.push_back(TileCover {tile, triangle});
+                }
+            }
+        }
+    }
+
+    std::sort(result.begin() + first, result.end(), [] (const TileCover &a, const TileCover &b) {
+        return a.tile.y != b.tile.y ? a.tile.y < b.tile.y : a.tile.x < b.tile.x;
+    });
+    size_t last = first;
+    for (size_t i = first + 1; i < result.size(); ++i) {
+        if (result[i].tile == result[last].tile)
+            result[last].bounds.add(result[i].bounds);
+        else
+            result[++last] = result[i];
+    }
+    if (result.size() > first)
+        result.resize(last + 1);
+}
+
+int TileGrid::find(TileCoord tile) const
+{
+    auto found = _slots.find(keyOf(tile));
+    return found != _slots.end() ? found->second : NoTile;
+}
+
+int TileGrid::acquire(TileCoord tile, bool &created)
+{
+    created = false;
+
+    int slot = find(tile);
+    if (slot != NoTile)
+        return slot;
+
+    if (getMemoryUsage() + getTileBytes() > _memoryBudget) {
+        _rejectedCount++;
+        return NoTile;
+    }
+
+    slot = (int)_tiles.size();
+    _tiles.push_back(tile);
+    _slots[keyOf(tile)] = slot;
+    created = true;
+    return slot;
+}
+
+void TileGrid::clear()
+{
+    _tiles.clear();
+    _slots.clear();
+    _rejectedCount = 0;
+}
+
+}
@@ -0,0 +1,102 @@
+//
+//  TileGrid.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef TileGrid_hpp
+#define TileGrid_hpp
+
+#include <stddef.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+#include "StrokeMesh.hpp"
+#include "StrokeTypes.hpp"
+
+namespace stroke {
+
+struct TileCoord {
+    int x, y;
+
+    bool operator==(const TileCoord &c) const { return x == c.x && y == c.y; }
+};
+
+//! A tile a mesh draws into, with the bounds of the triangles that reach it.
+struct TileCover {
+    TileCoord tile;
+    Bounds bounds;
+};
+
+//! Bookkeeping of a sparse canvas split into square tiles of tileSize points. A tile gets a slot the first
+//! time ink touches it and keeps it until clear(); the canvas keeps its backing texture at the same slot.
+//! Memory is charged per allocated tile against a budget, so a document costs what its ink covers rather
+//! than its area, and a tile that would go over the budget is refused instead of allocated.
+class TileGrid {
+
+public:
+    static constexpr float DefaultTileSize = 256;
+    static constexpr size_t DefaultMemoryBudget = 256 << 20;
+    //! RGBA8888 backing store
+    static constexpr size_t BytesPerPixel = 4;
+
+    static constexpr int NoTile = -1;
+
+public:
+    TileGrid (float tileSize = DefaultTileSize, float pixelScale = 1)
+    : _tileSize(tileSize), _pixelScale(pixelScale), _memoryBudget(DefaultMemoryBudget), _rejectedCount(0) {}
+
+    float getTileSize() const { return _tileSize; }
+    //! backing store pixels per point
+    float getPixelScale() const { return _pixelScale; }
+    int getTilePixels() const { return (int)ceilf(_tileSize * _pixelScale); }
+    size_t getTileBytes() const { return (size_t)getTilePixels() * getTilePixels() * BytesPerPixel; }
+
+    void setMemoryBudget(size_t bytes) { _memoryBudget = bytes; }
+    size_t getMemoryBudget() const { return _memoryBudget; }
+    size_t getMemoryUsage() const { return _tiles.size() * getTileBytes(); }
+
+    size_t getTileCount() const { return _tiles.size(); }
+    TileCoord getTile(int slot) const { return _tiles[slot]; }
+    //! tiles acquire() refused because of the budget, since the last clear.
+    size_t getRejectedCount() const { return _rejectedCount; }
+
+    TileCoord tileAt(float x, float y) const;
+    Bounds getTileBounds(TileCoord tile) const;
+
+    //! appends the tiles bounds overlaps to result, row by row. A mesh's bounds take in every tile between its
+    //! ends, so a mesh is routed with getMeshTiles() instead.
+    void getOverlappingTiles(const Bounds &bounds, std::vector<TileCoord> &result) const;
+    //! appends the tiles a triangle of mesh overlaps to result, row by row, each once, with the bounds of
+    //! the triangles in it. A diagonal stroke gets the tiles along it rather than the square it spans.
+    void getMeshTiles(const StrokeMesh &mesh, std::vector<TileCover> &result) const;
+
+    //! the slot of tile, or NoTile if ink never touched it.
+    int find(TileCoord tile) const;
+
+    //! The slot of tile, allocating it if needed, with created telling whether it is new. Returns NoTile
+    //! when allocating it would take the memory usage over the budget.
+    int acquire(TileCoord tile, bool &created);
+
+    //! forgets every tile, back to a blank canvas.
+    void clear();
+
+private:
+    static uint64_t keyOf(TileCoord tile) { return ((uint64_t)(uint32_t)tile.x << 32) | (uint32_t)tile.y; }
+
+private:
+    float _tileSize;
+    float _pixelScale;
+    size_t _memoryBudget;
+    size_t _rejectedCount;
+
+    std::vector<TileCoord> _tiles;
+    std::unordered_map<uint64_t, int> _slots;
+
+};
+
+}
+
+#endif /* TileGrid_hpp */
@@ -0,0 +1,183 @@
+//
+//  TileHistory.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "TileHistory.hpp"
+
+#include <string.h>
+#include <algorithm>
+
+namespace stroke {
+
+constexpr size_t TileHistory::DefaultMemoryBudget;
+
+void TileHistory::beginEntry()
+{
+    endEntry();
+
+    for (auto &entry : _redo) {
+        _memoryUsage -= entry.bytes;
+    }
+    _redo.clear();
+
+    _undo.push_back(HistoryEntry {{}, sizeof(HistoryEntry), 0});
+    _memoryUsage += sizeof(HistoryEntry);
+    _open = true;
+}
+
+void TileHistory::addStroke()
+{
+    if (_open)
+        _undo.back().strokes++;
+}
+
+void TileHistory::endEntry()
+{
+    if (!_open)
+        return;
+
+    cropTiles();
+    _open = false;
+    evict();
+}
+
+void TileHistory::cropTiles()
+{
+    auto &entry = _undo.back();
+    size_t kept = 0;
+    for (size_t i = 0; i < entry.tiles.size(); ++i) {
+        auto &tile = entry.tiles[i];
+        auto &open = _openTiles[i];
+        //! a created tile is cleared whole, it has no copy to crop
+        if (open.pixels.empty()) {
+            entry.tiles[kept++] = tile;
+            continue;
+        }
+
+        //! copied but never drawn into: nothing to undo
+        if (open.x1 <= open.x0 || open.y1 <= open.y0) {
+            entry.bytes -= sizeof(HistoryEntry::Tile);
+            _memoryUsage -= sizeof(HistoryEntry::Tile);
+            continue;
+        }
+
+        tile.x = open.x0;
+        tile.y = open.y0;
+        tile.width = open.x1 - open.x0;
+        tile.height = open.y1 - open.y0;
+
+        _crop.resize(tile.width * tile.height);
+        for (int row = 0; row < tile.height; ++row) {
+            memcpy(&_crop[row * tile.width], &open.pixels[(tile.y + row) * open.size + tile.x], tile.width * sizeof(uint32_t));
+        }
+        tile.before = TileSnapshot::create(_crop.data(), _crop.size(), _compress);
+        entry.bytes += tile.before->getByteSize();
+        _memoryUsage += tile.before->getByteSize();
+        entry.tiles[kept++] = tile;
+    }
+    entry.tiles.resize(kept);
+    _openTiles.clear();
+}
+
+bool TileHistory::needsSnapshot(TileCoord tile) const
+{
+    if (!_open)
+        return false;
+
+    for (auto &t : _undo.back().tiles) {
+        if (t.coord == tile)
+            return false;
+    }
+    return true;
+}
+
+void TileHistory::addTile(TileCoord tile, const uint32_t *pixels, int size)
+{
+    auto &entry = _undo.back();
+    entry.tiles.push_back(HistoryEntry::Tile {tile, 0, 0, 0, 0, nullptr});
+    entry.bytes += sizeof(HistoryEntry::Tile);
+    _memoryUsage += sizeof(HistoryEntry::Tile);
+
+    OpenTile open {{}, size, size, size, 0, 0};
+    if (pixels)
+        open.pixels.assign(pixels, pixels + size * size);
+    _openTiles.push_back(std::move(open));
+}
+
+void TileHistory::addSnapshot(TileCoord tile, const uint32_t *pixels, int size)
+{
+    if (needsSnapshot(tile))
+        addTile(tile, pixels, size);
+}
+
+void TileHistory::addNewTile(TileCoord tile)
+{
+    if (needsSnapshot(tile))
+        addTile(tile, nullptr, 0);
+}
+
+void TileHistory::addDirtyRect(TileCoord tile, int x, int y, int width, int height)
+{
+    if (!_open)
+        return;
+
+    auto &tiles = _undo.back().tiles;
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        if (!(tiles[i].coord == tile))
+            continue;
+
+        auto &open = _openTiles[i];
+        open.x0 = std::max(0, std::min(open.x0, x));
+        open.y0 = std::max(0, std::min(open.y0, y));
+        open.x1 = std::min(open.size, std::max(open.x1, x + width));
+        open.y1 = std::min(open.size, std::max(open.y1, y + height));
+        return;
+    }
+}
+
+const HistoryEntry &TileHistory::undo()
+{
+    _redo.push_back(std::move(_undo.back()));
+    _undo.pop_back();
+    return _redo.back();
+}
+
+const HistoryEntry &TileHistory::redo()
+{
+    _undo.push_back(std::move(_redo.back()));
+    _redo.pop_back();
+    return _undo.back();
+}
+
+void TileHistory::setMemoryBudget(size_t bytes)
+{
+    _memoryBudget = bytes;
+    if (!_open)
+        evict();
+}
+
+//! redo entries are newer than any undo entry, so the oldest undo entries go first
+void TileHistory::evict()
+{
+    while (_memoryUsage > _memoryBudget && !_undo.empty()) {
+        _memoryUsage -= _undo.front().bytes;
+        _undo.pop_front();
+        _evictedCount++;
+    }
+}
+
+void TileHistory::clear()
+{
+    _undo.clear();
+    _redo.clear();
+    _openTiles.clear();
+    _open = false;
+    _memoryUsage = 0;
+    _evictedCount = 0;
+}
+
+}
@@ -0,0 +1,118 @@
+//
+//  TileHistory.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef TileHistory_hpp
+#define TileHistory_hpp
+
+#include <deque>
+#include <vector>
+#include "TileGrid.hpp"
+#include "TileSnapshot.hpp"
+
+namespace stroke {
+
+//! What a stroke overwrote: for every tile it drew into, the rectangle it drew in and a snapshot of that
+//! rectangle as it was before the stroke. A tile the stroke created has no snapshot, undoing the stroke
+//! clears it back to the background.
+struct HistoryEntry {
+    struct Tile {
+        TileCoord coord;
+        //! in tile pixels, rows from the bottom as GL reads them; empty for a created tile
+        int x, y, width, height;
+        std::shared_ptr<const TileSnapshot> before;
+    };
+
+    std::vector<Tile> tiles;
+    size_t bytes;
+    //! strokes drawn while the entry was open, undone and redone together: fingers drawing at once share one
+    size_t strokes;
+};
+
+//! Copy on write undo history of a tiled canvas. Each entry is opened when a stroke begins, and a tile is
+//! copied only the first time the stroke writes to it. The stroke's extent isn't known until it ends, so
+//! the open entry holds whole tiles; closing it keeps only the rectangle of each tile the stroke wrote to,
+//! compressed, so an entry costs about the area the stroke touched rather than the whole canvas. Undo hands back the entry to restore; redo hands it back to
+//! draw the stroke again over, keeping it for the next undo. The oldest entries are dropped to stay within
+//! a byte budget.
+class TileHistory {
+
+public:
+    static constexpr size_t DefaultMemoryBudget = 64 << 20;
+
+public:
+    TileHistory () : _open(false), _compress(true), _memoryBudget(DefaultMemoryBudget), _memoryUsage(0), _evictedCount(0) {}
+
+    //! opens an entry for a new stroke, dropping whatever could be redone.
+    void beginEntry();
+    //! closes the open entry, cropping its tile copies, and drops the oldest entries if the history is over
+    //! its budget.
+    void endEntry();
+    bool isEntryOpen() const { return _open; }
+    //! counts one more stroke into the open entry.
+    void addStroke();
+
+    //! whether the open entry still needs tile as it was before the stroke.
+    bool needsSnapshot(TileCoord tile) const;
+    //! the open entry's copy of tile, size by size pixels, before the stroke writes to it.
+    void addSnapshot(TileCoord tile, const uint32_t *pixels, int size);
+    //! a tile the open entry's stroke created, blank before it.
+    void addNewTile(TileCoord tile);
+    //! grows the rectangle of a tile in the open entry that the stroke wrote to, in tile pixels.
+    void addDirtyRect(TileCoord tile, int x, int y, int width, int height);
+
+    bool canUndo() const { return !_undo.empty() && !_open; }
+    bool canRedo() const { return !_redo.empty() && !_open; }
+    size_t getUndoCount() const { return _undo.size(); }
+    size_t getRedoCount() const { return _redo.size(); }
+
+    //! moves the newest entry to the redo stack: restore its tiles to undo the stroke.
+    const HistoryEntry &undo();
+    //! moves the last undone entry back: draw its stroke again to redo it.
+    const HistoryEntry &redo();
+
+    //! store snapshots raw rather than run length encoded, for pixels that don't compress
+    void setCompression(bool compress) { _compress = compress; }
+    void setMemoryBudget(size_t bytes);
+    size_t getMemoryBudget() const { return _memoryBudget; }
+    size_t getMemoryUsage() const { return _memoryUsage; }
+    //! entries dropped for the budget since the last clear
+    size_t getEvictedCount() const { return _evictedCount; }
+
+    void clear();
+
+private:
+    //! the open entry's copy of a tile, until endEntry() crops it
+    struct OpenTile {
+        std::vector<uint32_t> pixels;
+        int size;
+        int x0, y0, x1, y1;
+    };
+
+    void addTile(TileCoord tile, const uint32_t *pixels, int size);
+    void cropTiles();
+    void evict();
+
+private:
+    //! oldest first, the open entry is the last one
+    std::deque<HistoryEntry> _undo;
+    std::vector<HistoryEntry> _redo;
+    //! parallel to the open entry's tiles
+    std::vector<OpenTile> _openTiles;
+    std::vector<uint32_t> _crop;
+    bool _open;
+    bool _compress;
+
+    size_t _memoryBudget;
+    size_t _memoryUsage;
+    size_t _evictedCount;
+
+};
+
+}
+
+#endif /* TileHistory_hpp */
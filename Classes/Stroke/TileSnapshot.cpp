@@ -0,0 +1,70 @@
+//
+//  TileSnapshot.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "TileSnapshot.hpp"
+
+#include <string.h>
+#include <algorithm>
+#include "Varint.hpp"
+
+namespace stroke {
+
+std::shared_ptr<const TileSnapshot> TileSnapshot::create(const uint32_t *pixels, size_t count, bool compress)
+{
+    std::shared_ptr<TileSnapshot> snapshot {new TileSnapshot()};
+    snapshot->_pixelCount = count;
+
+    const size_t rawSize = count * sizeof(uint32_t);
+    if (compress) {
+        auto &data = snapshot->_data;
+        for (size_t i = 0; i < count && data.size() < rawSize; ) {
+            uint32_t pixel = pixels[i];
+            size_t run = 1;
+            while (i + run < count && pixels[i + run] == pixel)
+                run++;
+
+            varint::write(data, (uint32_t)run);
+            const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&pixel);
+            data.insert(data.end(), bytes, bytes + sizeof(pixel));
+            i += run;
+        }
+        snapshot->_compressed = data.size() < rawSize;
+    }
+
+    if (!snapshot->_compressed) {
+        snapshot->_data.resize(rawSize);
+        memcpy(snapshot->_data.data(), pixels, rawSize);
+    }
+    snapshot->_data.shrink_to_fit();
+    return snapshot;
+}
+
+void TileSnapshot::restore(uint32_t *pixels) const
+{
+    if (!_compressed) {
+        memcpy(pixels, _data.data(), _pixelCount * sizeof(uint32_t));
+        return;
+    }
+
+    const uint8_t *p = _data.data();
+    const uint8_t *end = p + _data.size();
+    size_t written = 0;
+    while (p < end && written < _pixelCount) {
+        uint32_t run, pixel;
+        if (!varint::read(p, end, run) || end - p < (ptrdiff_t)sizeof(pixel))
+            break;
+        memcpy(&pixel, p, sizeof(pixel));
+        p += sizeof(pixel);
+
+        run = (uint32_t)std::min<size_t>(run, _pixelCount - written);
+        std::fill(pixels + written, pixels + written + run, pixel);
+        written += run;
+    }
+}
+
+}
@@ -0,0 +1,47 @@
+//
+//  TileSnapshot.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef TileSnapshot_hpp
+#define TileSnapshot_hpp
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <vector>
+
+namespace stroke {
+
+//! An immutable copy of a tile's RGBA8888 pixels. Line art is mostly long runs of background or solid ink,
+//! so the pixels are run length encoded (a varint run length and the 4 byte pixel per run); a tile that
+//! would come out larger than raw is kept raw. Snapshots are shared, never modified, once made.
+class TileSnapshot {
+
+public:
+    static std::shared_ptr<const TileSnapshot> create(const uint32_t *pixels, size_t count, bool compress = true);
+
+    size_t getPixelCount() const { return _pixelCount; }
+    //! what the snapshot takes in memory
+    size_t getByteSize() const { return sizeof(TileSnapshot) + _data.size(); }
+    bool isCompressed() const { return _compressed; }
+
+    //! writes the pixels back to pixels, which holds getPixelCount().
+    void restore(uint32_t *pixels) const;
+
+private:
+    TileSnapshot () : _pixelCount(0), _compressed(false) {}
+
+private:
+    std::vector<uint8_t> _data;
+    size_t _pixelCount;
+    bool _compressed;
+
+};
+
+}
+
+#endif /* TileSnapshot_hpp */
@@ -0,0 +1,66 @@
+//
+//  TraceWriter.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "TraceWriter.hpp"
+
+namespace stroke {
+
+bool TraceWriter::open(const char *path)
+{
+    close();
+
+    _file = fopen(path, "w");
+    if (_file == nullptr)
+        return false;
+
+    _epoch = Clock::now();
+    _events = 0;
+    fputs("[\n", _file);
+    return true;
+}
+
+void TraceWriter::close()
+{
+    if (_file == nullptr)
+        return;
+
+    fputs("\n]\n", _file);
+    fclose(_file);
+    _file = nullptr;
+}
+
+void TraceWriter::separator()
+{
+    if (_events++ > 0)
+        fputs(",\n", _file);
+}
+
+void TraceWriter::complete(const char *name, Clock::time_point start, Clock::time_point end, int tid)
+{
+    if (_file == nullptr)
+        return;
+
+    separator();
+    fprintf(_file, "{\"name\":\"%s\",\"cat\":\"stroke\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+            name, toMicros(start), std::chrono::duration<double, std::micro>(end - start).count(), tid);
+}
+
+void TraceWriter::counter(const char *name, Clock::time_point t, const char *const *keys, const double *values, int count)
+{
+    if (_file == nullptr)
+        return;
+
+    separator();
+    fprintf(_file, "{\"name\":\"%s\",\"cat\":\"stroke\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"args\":{", name, toMicros(t));
+    for (int i = 0; i < count; ++i) {
+        fprintf(_file, "%s\"%s\":%.17g", i > 0 ? "," : "", keys[i], values[i]);
+    }
+    fputs("}}", _file);
+}
+
+}
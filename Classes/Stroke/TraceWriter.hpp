@@ -0,0 +1,60 @@
+//
+//  TraceWriter.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef TraceWriter_hpp
+#define TraceWriter_hpp
+
+#include <chrono>
+#include <cstdio>
+
+namespace stroke {
+
+//! Writes Chrome trace event JSON (the array form), which about://tracing and ui.perfetto.dev open directly.
+//! Events go straight to a buffered FILE, so tracing adds no allocations per event. Timestamps are
+//! microseconds since open().
+class TraceWriter {
+
+public:
+    using Clock = std::chrono::steady_clock;
+
+public:
+    TraceWriter () : _file(nullptr), _events(0) {}
+    ~TraceWriter() { close(); }
+
+    TraceWriter(const TraceWriter &) = delete;
+    TraceWriter &operator=(const TraceWriter &) = delete;
+
+    //! starts a new trace at path, closing any trace in progress. Returns false if the file can't be created.
+    bool open(const char *path);
+    //! terminates the JSON array and closes the file.
+    void close();
+    bool isOpen() const { return _file != nullptr; }
+
+    size_t getEventCount() const { return _events; }
+
+    double toMicros(Clock::time_point t) const { return std::chrono::duration<double, std::micro>(t - _epoch).count(); }
+
+    //! a "complete" event: a slice named name from start to end on thread tid.
+    void complete(const char *name, Clock::time_point start, Clock::time_point end, int tid = 1);
+
+    //! a "counter" event, drawn as a stacked graph named name with one series per key.
+    void counter(const char *name, Clock::time_point t, const char *const *keys, const double *values, int count);
+
+private:
+    void separator();
+
+private:
+    FILE *_file;
+    Clock::time_point _epoch;
+    size_t _events;
+
+};
+
+}
+
+#endif /* TraceWriter_hpp */
@@ -0,0 +1,113 @@
+//
+//  UnitCircle.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "UnitCircle.hpp"
+
+namespace stroke {
+
+constexpr int UnitCircle::MinSegments;
+constexpr int UnitCircle::MaxSegments;
+
+namespace {
+
+//! C++11 constexpr functions are a single return statement, so the Taylor series are written as recursions.
+//! 20 terms are far beyond float precision for angles in [0, PI].
+constexpr double sinSeries(double x2, double term, int n, double sum)
+{
+    return n > 20 ? sum : sinSeries(x2, -term * x2 / ((2.0 * n) * (2.0 * n + 1)), n + 1, sum + term);
+}
+
+constexpr double cosSeries(double x2, double term, int n, double sum)
+{
+    return n > 20 ? sum : cosSeries(x2, -term * x2 / ((2.0 * n - 1) * (2.0 * n)), n + 1, sum + term);
+}
+
+constexpr double constexprSin(double x) { return sinSeries(x * x, x, 1, 0.0); }
+constexpr double constexprCos(double x) { return cosSeries(x * x, 1.0, 1, 0.0); }
+
+template <int... I> struct IndexList {};
+template <int N, int... I> struct MakeIndexList : MakeIndexList<N - 1, N - 1, I...> {};
+template <int... I> struct MakeIndexList<0, I...> { using type = IndexList<I...>; };
+
+template <int Segments>
+struct Table {
+    UnitCircle::Point points[Segments + 1];
+};
+
+template <int Segments, int... I>
+constexpr Table<Segments> makeTable(IndexList<I...>)
+{
+    return Table<Segments> {{ UnitCircle::Point {(float)constexprCos(M_PI * I / Segments), (float)constexprSin(M_PI * I / Segments)}... }};
+}
+
+template <int Segments>
+constexpr Table<Segments> makeTable()
+{
+    return makeTable<Segments>(typename MakeIndexList<Segments + 1>::type {});
+}
+
+constexpr Table<2> table2 = makeTable<2>();
+constexpr Table<3> table3 = makeTable<3>();
+constexpr Table<4> table4 = makeTable<4>();
+constexpr Table<6> table6 = makeTable<6>();
+constexpr Table<8> table8 = makeTable<8>();
+constexpr Table<12> table12 = makeTable<12>();
+constexpr Table<16> table16 = makeTable<16>();
+constexpr Table<24> table24 = makeTable<24>();
+constexpr Table<32> table32 = makeTable<32>();
+constexpr Table<48> table48 = makeTable<48>();
+constexpr Table<64> table64 = makeTable<64>();
+
+static_assert(table4.points[2].cos < 1e-6f && table4.points[2].cos > -1e-6f && table4.points[2].sin > 1 - 1e-6f, "cos/sin of PI/2");
+static_assert(table64.points[64].cos < -1 + 1e-6f && table64.points[64].sin < 1e-6f, "cos/sin of PI");
+
+const UnitCircle::HalfCircle HalfCircles[] = {
+    {2, table2.points},
+    {3, table3.points},
+    {4, table4.points},
+    {6, table6.points},
+    {8, table8.points},
+    {12, table12.points},
+    {16, table16.points},
+    {24, table24.points},
+    {32, table32.points},
+    {48, table48.points},
+    {64, table64.points},
+};
+
+}
+
+UnitCircle::HalfCircle UnitCircle::halfCircleFor(float radius, float tolerance)
+{
+    //! acos(1 - x) >= sqrt(2 x), so sqrt underestimates the chord angle allowed and never picks too few segments.
+    float ratio = tolerance / radius;
+    if (ratio >= 1.0f)
+        return HalfCircles[0];
+
+    float maxAngle = 2 * sqrtf(2 * ratio);
+    float needed = (float)M_PI / maxAngle;
+
+    for (auto &halfCircle : HalfCircles) {
+        if (halfCircle.segments >= needed)
+            return halfCircle;
+    }
+    return HalfCircles[sizeof(HalfCircles) / sizeof(HalfCircles[0]) - 1];
+}
+
+bool UnitCircle::halfCircleWith(int segments, HalfCircle &result)
+{
+    for (auto &halfCircle : HalfCircles) {
+        if (halfCircle.segments == segments) {
+            result = halfCircle;
+            return true;
+        }
+    }
+    return false;
+}
+
+}
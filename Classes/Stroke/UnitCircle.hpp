@@ -0,0 +1,53 @@
+//
+//  UnitCircle.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef UnitCircle_hpp
+#define UnitCircle_hpp
+
+#include "StrokeTypes.hpp"
+
+namespace stroke {
+
+//! Half circle tables of cos and sin at k * PI / segments, k = 0...segments, computed at compile time
+//! for a fixed ladder of segment counts. Round caps rotate a table onto their direction instead of
+//! calling trig functions per rim point.
+class UnitCircle {
+
+public:
+    struct Point {
+        float cos, sin;
+    };
+
+    struct HalfCircle {
+        int segments;
+        //! segments + 1 entries
+        const Point *points;
+    };
+
+    static constexpr int MinSegments = 2;
+    static constexpr int MaxSegments = 64;
+
+public:
+    //! The smallest table whose chords stay within tolerance of a circle of the given radius: a chord
+    //! spanning angle a deviates r (1 - cos(a / 2)) from the arc. Radii too large for MaxSegments get the MaxSegments table.
+    static HalfCircle halfCircleFor(float radius, float tolerance);
+
+    //! the table with exactly the given number of segments, if it is one of the precomputed ones.
+    static bool halfCircleWith(int segments, HalfCircle &result);
+
+    //! rotates unit vector start clockwise by the angle of point, in the same sense as (sin, cos)(a + t).
+    static Vec2 rotate(const Vec2 &start, const Point &point)
+    {
+        return Vec2 {start.x * point.cos + start.y * point.sin, start.y * point.cos - start.x * point.sin};
+    }
+
+};
+
+}
+
+#endif /* UnitCircle_hpp */
@@ -0,0 +1,138 @@
+//
+//  Varint.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef Varint_hpp
+#define Varint_hpp
+
+#include <stdint.h>
+#include <vector>
+
+namespace stroke {
+
+//! LEB128 style variable length integers: 7 bits per byte, low bits first, the high bit set on every byte
+//! but the last. Signed values are zigzag mapped first so small deltas of either sign take one byte.
+namespace varint {
+
+static constexpr size_t MaxBytes32 = 5;
+static constexpr size_t MaxBytes64 = 10;
+
+inline uint32_t zigzag(int32_t value) { return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31); }
+inline int32_t unzigzag(uint32_t value) { return (int32_t)(value >> 1) ^ -(int32_t)(value & 1); }
+inline uint64_t zigzag64(int64_t value) { return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63); }
+inline int64_t unzigzag64(uint64_t value) { return (int64_t)(value >> 1) ^ -(int64_t)(value & 1); }
+
+//! Two values as one, their bits alternating from a's lowest, so a pair of small values takes as few bytes
+//! as the larger of them alone: both zigzagged deltas under 8 still fit one byte.
+inline uint64_t interleave(uint32_t a, uint32_t b)
+{
+    auto spread = [] (uint64_t x) {
+        x = (x | x << 16) & 0x0000ffff0000ffffull;
+        x = (x | x << 8) & 0x00ff00ff00ff00ffull;
+        x = (x | x << 4) & 0x0f0f0f0f0f0f0f0full;
+        x = (x | x << 2) & 0x3333333333333333ull;
+        return (x | x << 1) & 0x5555555555555555ull;
+    };
+    return spread(a) | spread(b) << 1;
+}
+
+inline void deinterleave(uint64_t value, uint32_t &a, uint32_t &b)
+{
+    auto gather = [] (uint64_t x) {
+        x &= 0x5555555555555555ull;
+        x = (x | x >> 1) & 0x3333333333333333ull;
+        x = (x | x >> 2) & 0x0f0f0f0f0f0f0f0full;
+        x = (x | x >> 4) & 0x00ff00ff00ff00ffull;
+        x = (x | x >> 8) & 0x0000ffff0000ffffull;
+        return (uint32_t)(x | x >> 16);
+    };
+    a = gather(value);
+    b = gather(value >> 1);
+}
+
+inline void write(std::vector<uint8_t> &out, uint32_t value)
+{
+    while (value >= 0x80) {
+        out.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((uint8_t)value);
+}
+
+inline void writeSigned(std::vector<uint8_t> &out, int32_t value) { write(out, zigzag(value)); }
+
+inline void write64(std::vector<uint8_t> &out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((uint8_t)value);
+}
+
+inline void writeSigned64(std::vector<uint8_t> &out, int64_t value) { write64(out, zigzag64(value)); }
+
+//! reads a value at p, advancing it. Returns false, leaving p, if the value runs past end or is too long.
+inline bool read(const uint8_t *&p, const uint8_t *end, uint32_t &value)
+{
+    uint32_t result = 0;
+    const uint8_t *q = p;
+    for (int shift = 0; shift < 7 * (int)MaxBytes32; shift += 7) {
+        if (q == end)
+            return false;
+        uint8_t byte = *q++;
+        result |= (uint32_t)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            value = result;
+            p = q;
+            return true;
+        }
+    }
+    return false;
+}
+
+inline bool readSigned(const uint8_t *&p, const uint8_t *end, int32_t &value)
+{
+    uint32_t raw;
+    if (!read(p, end, raw))
+        return false;
+    value = unzigzag(raw);
+    return true;
+}
+
+inline bool read64(const uint8_t *&p, const uint8_t *end, uint64_t &value)
+{
+    uint64_t result = 0;
+    const uint8_t *q = p;
+    for (int shift = 0; shift < 7 * (int)MaxBytes64; shift += 7) {
+        if (q == end)
+            return false;
+        uint8_t byte = *q++;
+        result |= (uint64_t)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            value = result;
+            p = q;
+            return true;
+        }
+    }
+    return false;
+}
+
+inline bool readSigned64(const uint8_t *&p, const uint8_t *end, int64_t &value)
+{
+    uint64_t raw;
+    if (!read64(p, end, raw))
+        return false;
+    value = unzigzag64(raw);
+    return true;
+}
+
+}
+
+}
+
+#endif /* Varint_hpp */
@@ -0,0 +1,16 @@
+//
+//  VelocityCalculator.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "VelocityCalculator.hpp"
+
+namespace stroke {
+
+//! the calculator PanTracker uses, compiled once here
+template class BasicVelocityCalculator<DefaultVelocityEstimator>;
+
+}
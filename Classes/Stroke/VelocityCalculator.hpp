@@ -0,0 +1,92 @@
+//
+//  VelocityCalculator.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef VelocityCalculator_hpp
+#define VelocityCalculator_hpp
+
+#include <stdio.h>
+#include <chrono>
+#include "StrokeTypes.hpp"
+#include "VelocityEstimators.hpp"
+
+namespace stroke {
+
+//! Velocity of the input locations of a touch, in points per second, by the Estimator policy in
+//! VelocityEstimators.hpp, with no virtual calls per sample. Velocities are taken over the input's own
+//! timestamps, in floating point seconds. Locations closer in time than MinSampleInterval, as coalesced
+//! events stamped alike, are taken as one: the later ones are dropped until one is far enough apart.
+template <class Estimator>
+class BasicVelocityCalculator {
+
+public:
+    using time_point = std::chrono::steady_clock::time_point;
+    static constexpr float MinSampleInterval = 0.0002f;
+    static constexpr bool Debug = false;
+
+public:
+    BasicVelocityCalculator () : _first(true), _sampleCount(0) {}
+
+    void reset()
+    {
+        _estimator.reset();
+        _sampleCount = 0;
+        _first = true;
+    }
+
+    void addLocation(Vec2 location)
+    {
+        addLocation(location, std::chrono::steady_clock::now());
+    }
+
+    void addLocation(Vec2 location, time_point timestamp)
+    {
+        using namespace std::chrono;
+
+        if (Debug)
+            printf("adding location %.2f %.2f timestamp %.3f ms\n", location.x, location.y, duration<double, std::milli>(timestamp.time_since_epoch()).count());
+
+        if (_first) {
+            _firstTimestamp = _prevTimestamp = timestamp;
+            _first = false;
+        }
+        else {
+            float seconds = duration<float>(timestamp - _prevTimestamp).count();
+
+            if (Debug)
+                printf("time since last update %.3f ms\n", seconds * 1000);
+
+            if (seconds < MinSampleInterval)
+                return;
+            _prevTimestamp = timestamp;
+            _sampleCount++;
+        }
+        _estimator.addSample(location, duration<double>(timestamp - _firstTimestamp).count());
+    }
+
+    //! velocities estimated so far, one for each location after the first
+    int getSampleCount() const { return _sampleCount; }
+
+    //! zero until two locations far enough apart in time have been added
+    Vec2 getVelocity() const { return _estimator.getVelocity(); }
+
+private:
+    Estimator _estimator;
+    bool _first;
+    time_point _firstTimestamp, _prevTimestamp;
+    int _sampleCount;
+
+};
+
+template <class Estimator>
+constexpr float BasicVelocityCalculator<Estimator>::MinSampleInterval;
+
+using VelocityCalculator = BasicVelocityCalculator<DefaultVelocityEstimator>;
+
+}
+
+#endif /* VelocityCalculator_hpp */
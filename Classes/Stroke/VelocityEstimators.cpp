@@ -0,0 +1,165 @@
+//
+//  VelocityEstimators.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "VelocityEstimators.hpp"
+
+#include <math.h>
+#include <algorithm>
+#include <initializer_list>
+#include <utility>
+
+namespace stroke {
+
+constexpr int BoxcarEstimator::MaxSamples;
+constexpr int LeastSquaresEstimator::Window;
+constexpr double LeastSquaresEstimator::MaxAge;
+constexpr double KalmanEstimator::ProcessNoise;
+constexpr double KalmanEstimator::MeasurementNoise;
+
+void BoxcarEstimator::reset()
+{
+    _velocities = {};
+    _count = 0;
+    _sum = Vec2 {0, 0};
+    _first = true;
+}
+
+void BoxcarEstimator::addSample(Vec2 location, double seconds)
+{
+    if (!_first) {
+        float interval = (float)(seconds - _seconds);
+        Vec2 velocity = (location - _location) * (1 / interval);
+
+        int index = _count % MaxSamples;
+        _sum -= _velocities[index];
+        _sum += velocity;
+        _velocities[index] = velocity;
+        _count++;
+    }
+    _first = false;
+    _location = location;
+    _seconds = seconds;
+}
+
+Vec2 BoxcarEstimator::getVelocity() const
+{
+    if (_count == 0)
+        return Vec2 {0, 0};
+    return _sum * (1.0f / std::min(_count, MaxSamples));
+}
+
+void LeastSquaresEstimator::addSample(Vec2 location, double seconds)
+{
+    _samples[_next] = Sample {location, seconds};
+    _next = (_next + 1) % Window;
+    if (_count < Window)
+        _count++;
+
+    //! sums of the normal equations, in time relative to the newest sample so the fit is well conditioned
+    double s[5] = {}, sx[3] = {}, sy[3] = {};
+    int used = 0;
+    for (int i = 0; i < _count; ++i) {
+        auto &sample = _samples[(_next - 1 - i + Window) % Window];
+        double t = sample.seconds - seconds;
+        if (-t > MaxAge)
+            break;
+        double power = 1;
+        for (int k = 0; k < 5; ++k, power *= t) {
+            s[k] += power;
+            if (k < 3) {
+                sx[k] += power * sample.location.x;
+                sy[k] += power * sample.location.y;
+            }
+        }
+        used++;
+    }
+    if (used < 2)
+        return;
+
+    //! a line through two samples, a quadratic through more
+    if (used == 2) {
+        double determinant = s[0] * s[2] - s[1] * s[1];
+        if (fabs(determinant) < 1e-18)
+            return;
+        _velocity = Vec2 {(float)((s[0] * sx[1] - s[1] * sx[0]) / determinant), (float)((s[0] * sy[1] - s[1] * sy[0]) / determinant)};
+        return;
+    }
+
+    //! Cramer's rule for the slope of [s0 s1 s2; s1 s2 s3; s2 s3 s4] c = b
+    auto det3 = [] (double a, double b, double c, double d, double e, double f, double g, double h, double i) {
+        return a * (e * i - f * h) - b * (d * i - f * g) + c * (d * h - e * g);
+    };
+    double determinant = det3(s[0], s[1], s[2], s[1], s[2], s[3], s[2], s[3], s[4]);
+    if (fabs(determinant) < 1e-30)
+        return;
+    double vx = det3(s[0], sx[0], s[2], s[1], sx[1], s[3], s[2], sx[2], s[4]) / determinant;
+    double vy = det3(s[0], sy[0], s[2], s[1], sy[1], s[3], s[2], sy[2], s[4]) / determinant;
+    _velocity = Vec2 {(float)vx, (float)vy};
+}
+
+void KalmanEstimator::addSample(Vec2 location, double seconds)
+{
+    if (_first) {
+        _x = State {location.x, 0, 0};
+        _y = State {location.y, 0, 0};
+        //! nothing is known of the velocity and acceleration yet
+        const double initial[3] = {MeasurementNoise, 1e8, 1e12};
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                _covariance[i][j] = i == j ? initial[i] : 0;
+            }
+        }
+        _seconds = seconds;
+        _first = false;
+        return;
+    }
+
+    //! predict: x = F x, P = F P F' + Q
+    double dt = seconds - _seconds;
+    _seconds = seconds;
+    const double F[3][3] = {{1, dt, dt * dt / 2}, {0, 1, dt}, {0, 0, 1}};
+    for (auto state : {&_x, &_y}) {
+        *state = State {state->p + dt * state->v + dt * dt / 2 * state->a, state->v + dt * state->a, state->a};
+    }
+    double FP[3][3], P[3][3];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            FP[i][j] = F[i][0] * _covariance[0][j] + F[i][1] * _covariance[1][j] + F[i][2] * _covariance[2][j];
+        }
+    }
+    double dt2 = dt * dt, dt3 = dt2 * dt;
+    const double Q[3][3] = {
+        {dt3 * dt2 / 20, dt2 * dt2 / 8, dt3 / 6},
+        {dt2 * dt2 / 8, dt3 / 3, dt2 / 2},
+        {dt3 / 6, dt2 / 2, dt}
+    };
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            P[i][j] = FP[i][0] * F[j][0] + FP[i][1] * F[j][1] + FP[i][2] * F[j][2] + ProcessNoise * Q[i][j];
+        }
+    }
+
+    //! update with the location: K = P H' / (H P H' + R), H = [1 0 0]
+    double innovation = P[0][0] + MeasurementNoise;
+    double K[3] = {P[0][0] / innovation, P[1][0] / innovation, P[2][0] / innovation};
+    for (auto axis : {std::make_pair(&_x, location.x), std::make_pair(&_y, location.y)}) {
+        State &state = *axis.first;
+        double residual = axis.second - state.p;
+        state.p += K[0] * residual;
+        state.v += K[1] * residual;
+        state.a += K[2] * residual;
+    }
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            _covariance[i][j] = P[i][j] - K[i] * P[0][j];
+        }
+    }
+    _velocity = Vec2 {(float)_x.v, (float)_y.v};
+}
+
+}
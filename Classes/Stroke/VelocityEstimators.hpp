@@ -0,0 +1,111 @@
+//
+//  VelocityEstimators.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef VelocityEstimators_hpp
+#define VelocityEstimators_hpp
+
+#include <array>
+#include "StrokeTypes.hpp"
+
+namespace stroke {
+
+//! Velocity estimators for BasicVelocityCalculator, which picks one at compile time: each has reset(),
+//! addSample(location, seconds) with the time in seconds since the first sample of the touch, and
+//! getVelocity() in points per second, zero until it has two samples.
+
+//! The average of the last MaxSamples velocities between consecutive samples. Lags by half its window and
+//! takes an outlier's full swing, once in and once out.
+class BoxcarEstimator {
+
+public:
+    static constexpr int MaxSamples = 10;
+
+public:
+    BoxcarEstimator () { reset(); }
+
+    void reset();
+    void addSample(Vec2 location, double seconds);
+    Vec2 getVelocity() const;
+
+private:
+    std::array<Vec2, MaxSamples> _velocities;
+    int _count;
+    Vec2 _sum;
+    Vec2 _location;
+    double _seconds;
+    bool _first;
+
+};
+
+//! Fits a quadratic through the last Window samples, or those within MaxAge of the newest, by least
+//! squares, and takes its slope at the newest sample. Follows acceleration without the boxcar's lag and
+//! spreads an outlier over the fit.
+class LeastSquaresEstimator {
+
+public:
+    static constexpr int Window = 8;
+    static constexpr double MaxAge = 0.1;
+
+public:
+    LeastSquaresEstimator () { reset(); }
+
+    void reset() { _count = 0; _next = 0; _velocity = Vec2 {0, 0}; }
+    void addSample(Vec2 location, double seconds);
+    Vec2 getVelocity() const { return _velocity; }
+
+private:
+    struct Sample {
+        Vec2 location;
+        double seconds;
+    };
+
+    std::array<Sample, Window> _samples;
+    int _count, _next;
+    Vec2 _velocity;
+
+};
+
+//! A Kalman filter of position, velocity and acceleration, with the jerk as white noise of ProcessNoise
+//! and the touch location off by MeasurementNoise. Weighs each sample by how much it is trusted, so uneven
+//! sample intervals and bursts are taken in their stride.
+class KalmanEstimator {
+
+public:
+    //! spectral density of the jerk, (points per second cubed)^2 per hertz
+    static constexpr double ProcessNoise = 1e9;
+    //! variance of a touch location, points^2
+    static constexpr double MeasurementNoise = 1;
+
+public:
+    KalmanEstimator () { reset(); }
+
+    void reset() { _first = true; _velocity = Vec2 {0, 0}; }
+    void addSample(Vec2 location, double seconds);
+    Vec2 getVelocity() const { return _velocity; }
+
+private:
+    //! position, velocity and acceleration of one axis; both axes share the covariance
+    struct State {
+        double p, v, a;
+    };
+
+    State _x, _y;
+    //! covariance, symmetric, row major
+    double _covariance[3][3];
+    double _seconds;
+    bool _first;
+    Vec2 _velocity;
+
+};
+
+//! what VelocityCalculator, and so PanTracker, estimates with
+using DefaultVelocityEstimator = KalmanEstimator;
+
+}
+
+#endif /* VelocityEstimators_hpp */
@@ -0,0 +1,91 @@
+//
+//  WorkerPool.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "WorkerPool.hpp"
+
+#include <algorithm>
+
+namespace stroke {
+
+WorkerPool::WorkerPool(unsigned threadCount)
+: _task(nullptr), _count(0), _next(0), _busy(0), _generation(0), _stopping(false)
+{
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    for (unsigned i = 1; i < threadCount; ++i) {
+        _threads.emplace_back(&WorkerPool::work, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _wake.notify_all();
+    for (auto &thread : _threads) {
+        thread.join();
+    }
+}
+
+void WorkerPool::run(size_t count, const std::function<void(size_t)> &task)
+{
+    if (_threads.empty() || count <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _task = &task;
+        _count = count;
+        _next = 0;
+        _busy = _threads.size();
+        _generation++;
+    }
+    _wake.notify_all();
+
+    drain();
+
+    //! every worker takes part in every run, so a run never starts while one is still in the last
+    std::unique_lock<std::mutex> lock(_mutex);
+    _done.wait(lock, [this] { return _busy == 0; });
+    _task = nullptr;
+}
+
+void WorkerPool::drain()
+{
+    for (size_t i = _next++; i < _count; i = _next++) {
+        (*_task)(i);
+    }
+}
+
+void WorkerPool::work()
+{
+    uint64_t generation = 0;
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (;;) {
+        _wake.wait(lock, [&] { return _stopping || _generation != generation; });
+        if (_stopping)
+            return;
+        generation = _generation;
+
+        lock.unlock();
+        drain();
+        lock.lock();
+
+        if (--_busy == 0)
+            _done.notify_all();
+    }
+}
+
+}
@@ -0,0 +1,62 @@
+//
+//  WorkerPool.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef WorkerPool_hpp
+#define WorkerPool_hpp
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace stroke {
+
+//! A fixed set of threads that run the items of a parallel for. The calling thread works through the items
+//! too, so a pool of one thread has no workers and runs everything inline. Items are handed out one at a
+//! time in index order, so a caller wanting deterministic output makes each item write its own data.
+class WorkerPool {
+
+public:
+    //! threadCount includes the calling thread; 0 is one per hardware thread.
+    explicit WorkerPool (unsigned threadCount = 0);
+    ~WorkerPool();
+
+    WorkerPool (const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    unsigned getThreadCount() const { return (unsigned)_threads.size() + 1; }
+
+    //! calls task(i) for every i below count across the pool, returning once every call has.
+    void run(size_t count, const std::function<void(size_t)> &task);
+
+private:
+    void work();
+    void drain();
+
+private:
+    std::vector<std::thread> _threads;
+    std::mutex _mutex;
+    std::condition_variable _wake, _done;
+
+    const std::function<void(size_t)> *_task;
+    size_t _count;
+    std::atomic<size_t> _next;
+    //! workers yet to finish the current run
+    size_t _busy;
+    uint64_t _generation;
+    bool _stopping;
+
+};
+
+}
+
+#endif /* WorkerPool_hpp */
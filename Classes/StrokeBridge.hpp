@@ -0,0 +1,27 @@
+//
+//  StrokeBridge.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef StrokeBridge_hpp
+#define StrokeBridge_hpp
+
+#include <cstddef>
+#include "cocos2d.h"
+#include "Stroke/StrokeTypes.hpp"
+
+//! conversions between cocos2d types and the stroke geometry library types.
+
+//! StrokeRenderer uploads meshes as is and points 2 position floats and 1 coverage float at them.
+static_assert(sizeof(stroke::Vertex) == 3 * sizeof(GLfloat), "stroke::Vertex must be tightly packed floats");
+static_assert(offsetof(stroke::Vertex, coverage) == 2 * sizeof(GLfloat), "stroke::Vertex coverage must follow the position");
+
+inline stroke::Vec2 toStroke(const cocos2d::Vec2 &v) { return stroke::Vec2 {v.x, v.y}; }
+inline cocos2d::Vec2 toCocos(const stroke::Vec2 &v) { return cocos2d::Vec2 {v.x, v.y}; }
+
+inline stroke::Color4F toStroke(const cocos2d::Color4F &c) { return stroke::Color4F {c.r, c.g, c.b, c.a}; }
+
+#endif /* StrokeBridge_hpp */
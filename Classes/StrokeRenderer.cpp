@@ -0,0 +1,140 @@
+//
+//  StrokeRenderer.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "StrokeRenderer.hpp"
+
+const char *StrokeRenderer::ProgramName = "StrokeRenderer_PositionCoverage";
+
+//! the coverage goes through the texture coordinate attribute slot, nothing in a stroke is textured.
+static const char *PositionCoverageVert = R"(
+attribute vec4 a_position;
+attribute float a_coverage;
+
+uniform vec4 u_color;
+
+#ifdef GL_ES
+varying lowp vec4 v_fragmentColor;
+#else
+varying vec4 v_fragmentColor;
+#endif
+
+void main()
+{
+    gl_Position = CC_MVPMatrix * a_position;
+    v_fragmentColor = u_color * a_coverage;
+}
+)";
+
+static const char *PositionCoverageFrag = R"(
+#ifdef GL_ES
+precision lowp float;
+#endif
+
+varying vec4 v_fragmentColor;
+
+void main()
+{
+    gl_FragColor = v_fragmentColor;
+}
+)";
+
+StrokeRenderer::~StrokeRenderer()
+{
+    if (_buffers[0] != 0) {
+        glDeleteBuffers(2, _buffers);
+    }
+}
+
+GLProgram *StrokeRenderer::getOrCreateProgram()
+{
+    auto cache = GLProgramCache::getInstance();
+    auto program = cache->getGLProgram(ProgramName);
+    if (program == nullptr) {
+        program = new (std::nothrow) GLProgram();
+        program->initWithByteArrays(PositionCoverageVert, PositionCoverageFrag);
+        program->bindAttribLocation("a_coverage", GLProgram::VERTEX_ATTRIB_TEX_COORD);
+        program->link();
+        program->updateUniforms();
+        cache->addGLProgram(program, ProgramName);
+        program->release();
+    }
+    return program;
+}
+
+void StrokeRenderer::setup()
+{
+    _program = getOrCreateProgram();
+    _colorLocation = _program->getUniformLocation("u_color");
+    glGenBuffers(2, _buffers);
+}
+
+void StrokeRenderer::draw(Renderer *renderer, const Mat4 &transform, uint32_t flags, float globalZOrder, const stroke::StrokeMesh &mesh, const Color4F &color)
+{
+    if (mesh.empty())
+        return;
+
+    _mesh = &mesh;
+    _color = color;
+    _transform = transform;
+
+    _customCommand.init(globalZOrder, transform, flags);
+    renderer->addCommand(&_customCommand);
+}
+
+//! reallocates the bound buffer at capacity elements if it had to grow, then fills range of it from data.
+static void uploadRange(GLenum target, bool resized, size_t capacity, const stroke::MeshUpload::Range &range, const void *data, size_t elementSize)
+{
+    if (resized)
+        glBufferData(target, capacity * elementSize, nullptr, GL_DYNAMIC_DRAW);
+    if (range.count > 0)
+        glBufferSubData(target, range.start * elementSize, range.count * elementSize, (const char *)data + range.start * elementSize);
+}
+
+//! leaves both buffers bound
+void StrokeRenderer::upload()
+{
+    _upload.update(*_mesh);
+
+    glBindBuffer(GL_ARRAY_BUFFER, _buffers[0]);
+    uploadRange(GL_ARRAY_BUFFER, _upload.isVertexBufferResized(), _upload.getVertexCapacity(), _upload.getVertexRange(), _mesh->getVertices().data(), sizeof(stroke::Vertex));
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffers[1]);
+    uploadRange(GL_ELEMENT_ARRAY_BUFFER, _upload.isIndexBufferResized(), _upload.getIndexCapacity(), _upload.getIndexRange(), _mesh->getIndices().data(), sizeof(unsigned short));
+}
+
+void StrokeRenderer::onDraw()
+{
+    if (_program == nullptr) {
+        setup();
+    }
+
+    auto &vertices = _mesh->getVertices();
+
+    _program->use();
+    _program->setUniformsForBuiltins(_transform);
+    _program->setUniformLocationWith4f(_colorLocation, _color.r * _color.a, _color.g * _color.a, _color.b * _color.a, _color.a);
+
+    GL::blendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    upload();
+
+    GL::enableVertexAttribs(GL::VERTEX_ATTRIB_FLAG_POSITION | GL::VERTEX_ATTRIB_FLAG_TEX_COORD);
+
+    //! indices are batch relative, so every batch points the attributes at its own first vertex
+    for (auto &batch : _mesh->getBatches()) {
+        size_t vertexOffset = batch.vertexStart * sizeof(stroke::Vertex);
+        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 2, GL_FLOAT, GL_FALSE, sizeof(stroke::Vertex), (GLvoid *)(vertexOffset + offsetof(stroke::Vertex, x)));
+        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORD, 1, GL_FLOAT, GL_FALSE, sizeof(stroke::Vertex), (GLvoid *)(vertexOffset + offsetof(stroke::Vertex, coverage)));
+        glDrawElements(GL_TRIANGLES, (GLsizei)batch.indexCount, GL_UNSIGNED_SHORT, (GLvoid *)(batch.indexStart * sizeof(unsigned short)));
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    CC_INCREMENT_GL_DRAWN_BATCHES_AND_VERTICES(_mesh->getBatches().size(), vertices.size());
+    CHECK_GL_ERROR_DEBUG();
+}
@@ -0,0 +1,61 @@
+//
+//  StrokeRenderer.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef StrokeRenderer_hpp
+#define StrokeRenderer_hpp
+
+#include "StrokeBridge.hpp"
+#include "Stroke/MeshUpload.hpp"
+#include "Stroke/StrokeMesh.hpp"
+
+using namespace cocos2d;
+
+//! Draws a stroke::StrokeMesh with its own vertex and index buffers and a position + coverage shader.
+//! The compact 12 byte vertices don't fit TrianglesCommand, which only takes V3F_C4B_T2F, so the mesh is
+//! submitted through a CustomCommand and one glDrawElements per mesh batch. The buffers are kept across frames
+//! and a frame uploads only what stroke::MeshUpload finds new, so a live stroke that grows each frame sends
+//! its new piece rather than all of itself again.
+//! The stroke color is a uniform, premultiplied to match the ALPHA_PREMULTIPLIED blending of the canvas.
+class StrokeRenderer {
+
+public:
+    static const char *ProgramName;
+
+public:
+    StrokeRenderer () : _mesh(nullptr), _program(nullptr), _colorLocation(-1), _buffers {0, 0}
+    {
+        //! bound once: a callback re-created every frame with the transform in it would allocate
+        _customCommand.func = CC_CALLBACK_0(StrokeRenderer::onDraw, this);
+    }
+    ~StrokeRenderer();
+
+    //! queues mesh for drawing. mesh has to stay unchanged until the renderer has drawn the frame.
+    void draw(Renderer *renderer, const Mat4 &transform, uint32_t flags, float globalZOrder, const stroke::StrokeMesh &mesh, const Color4F &color);
+
+private:
+    void onDraw();
+    void setup();
+    void upload();
+
+    static GLProgram *getOrCreateProgram();
+
+private:
+    CustomCommand _customCommand;
+    const stroke::StrokeMesh *_mesh;
+    Color4F _color;
+    Mat4 _transform;
+
+    GLProgram *_program;
+    GLint _colorLocation;
+    //! vertex and index buffer
+    GLuint _buffers[2];
+    stroke::MeshUpload _upload;
+
+};
+
+#endif /* StrokeRenderer_hpp */
@@ -0,0 +1,231 @@
+//
+//  TiledCanvas.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "TiledCanvas.hpp"
+
+constexpr float TiledCanvas::DefaultTileSize;
+
+TiledCanvas::~TiledCanvas()
+{
+    for (auto tile : _tiles) {
+        tile->release();
+    }
+}
+
+bool TiledCanvas::init(float tileSize)
+{
+    if (!Node::init())
+        return false;
+
+    _grid = stroke::TileGrid {tileSize, Director::getInstance()->getContentScaleFactor()};
+    _historyEndCommand.func = [this] { _history.endEntry(); };
+    return true;
+}
+
+RenderTexture *TiledCanvas::createTile(stroke::TileCoord tile)
+{
+    float size = _grid.getTileSize();
+    auto texture = RenderTexture::create(size, size, Texture2D::PixelFormat::RGBA8888);
+    texture->retain();
+
+    texture->clear(_backgroundColor.r, _backgroundColor.g, _backgroundColor.b, _backgroundColor.a);
+    //! opaque, so compositing needs no blending
+    texture->getSprite()->setBlendFunc(BlendFunc::DISABLE);
+    //! the render texture's sprite is centered on the node
+    texture->setAnchorPoint(Vec2 {0, 0});
+    texture->setPosition(Vec2 {(tile.x + .5f) * size, (tile.y + .5f) * size});
+    this->addChild(texture);
+    return texture;
+}
+
+TiledCanvas::TilePass &TiledCanvas::nextPass()
+{
+    if (_passes.size() <= _passCount) {
+        std::unique_ptr<TilePass> pass {new TilePass()};
+        TilePass *p = pass.get();
+        //! the tile's render texture is bound while its pass runs, so this reads the tile as it was before the stroke
+        p->snapshotCommand.func = [this, p] {
+            int size = _grid.getTilePixels();
+            _pixels.resize(size * size);
+            glReadPixels(0, 0, size, size, GL_RGBA, GL_UNSIGNED_BYTE, _pixels.data());
+            _history.addSnapshot(p->tile, _pixels.data(), size);
+        };
+        //! the scissor box is all the pass can write, so it is what the history keeps of the tile
+        p->scissorBeginCommand.func = [this, p] {
+            glEnable(GL_SCISSOR_TEST);
+            glScissor(p->scissorBox[0], p->scissorBox[1], p->scissorBox[2], p->scissorBox[3]);
+            _history.addDirtyRect(p->tile, p->scissorBox[0], p->scissorBox[1], p->scissorBox[2], p->scissorBox[3]);
+        };
+        p->scissorEndCommand.func = [] { glDisable(GL_SCISSOR_TEST); };
+        _passes.push_back(std::move(pass));
+    }
+    return *_passes[_passCount++];
+}
+
+//! the part of bounds inside the tile, in tile pixels, rounded out by a pixel so the fringe is never clipped.
+void TiledCanvas::setScissorBox(TilePass &pass, const stroke::Bounds &bounds, const stroke::Bounds &tileBounds)
+{
+    float scale = _grid.getPixelScale();
+    float pixels = (float)_grid.getTilePixels();
+
+    float x0 = std::max(0.0f, floorf((bounds.minX - tileBounds.minX) * scale) - 1);
+    float y0 = std::max(0.0f, floorf((bounds.minY - tileBounds.minY) * scale) - 1);
+    float x1 = std::min(pixels, ceilf((bounds.maxX - tileBounds.minX) * scale) + 1);
+    float y1 = std::min(pixels, ceilf((bounds.maxY - tileBounds.minY) * scale) + 1);
+
+    pass.scissorBox[0] = (GLint)x0;
+    pass.scissorBox[1] = (GLint)y0;
+    pass.scissorBox[2] = (GLint)std::max(0.0f, x1 - x0);
+    pass.scissorBox[3] = (GLint)std::max(0.0f, y1 - y0);
+}
+
+int TiledCanvas::acquireTile(stroke::TileCoord tile, bool &created)
+{
+    int slot = _grid.acquire(tile, created);
+    if (created)
+        _tiles.push_back(createTile(tile));
+    return slot;
+}
+
+void TiledCanvas::drawTile(Renderer *renderer, float globalZOrder, int slot, TilePass &pass, const stroke::StrokeMesh &mesh, const stroke::Bounds &bounds, const Color4F &color, bool snapshot)
+{
+    auto tileBounds = _grid.getTileBounds(_grid.getTile(slot));
+    setScissorBox(pass, bounds, tileBounds);
+
+    //! a render texture maps points to its pixels from its own origin, so the tile is drawn with the
+    //! mesh moved by the tile's origin, whatever this node's transform
+    Mat4 transform;
+    Mat4::createTranslation(-tileBounds.minX, -tileBounds.minY, 0, &transform);
+
+    auto texture = _tiles[slot];
+    pass.tile = _grid.getTile(slot);
+    texture->begin();
+    if (snapshot) {
+        pass.snapshotCommand.init(globalZOrder);
+        renderer->addCommand(&pass.snapshotCommand);
+    }
+    pass.scissorBeginCommand.init(globalZOrder);
+    renderer->addCommand(&pass.scissorBeginCommand);
+    pass.renderer.draw(renderer, transform, 0, globalZOrder, mesh, color);
+    pass.scissorEndCommand.init(globalZOrder);
+    renderer->addCommand(&pass.scissorEndCommand);
+    texture->end();
+}
+
+void TiledCanvas::drawMesh(Renderer *renderer, float globalZOrder, const stroke::StrokeMesh &mesh, const Color4F &color)
+{
+    _covers.clear();
+    _grid.getMeshTiles(mesh, _covers);
+
+    for (auto &cover : _covers) {
+        bool created;
+        int slot = acquireTile(cover.tile, created);
+        if (slot == stroke::TileGrid::NoTile)
+            continue;
+
+        //! copy on write: an open history entry gets each tile as it was before the stroke's first write to it
+        bool snapshot = false;
+        if (_history.needsSnapshot(cover.tile)) {
+            if (created)
+                _history.addNewTile(cover.tile);
+            else
+                snapshot = true;
+        }
+        auto &pass = nextPass();
+        pass.mesh.clear();
+        pass.mesh.appendOverlapping(mesh, _grid.getTileBounds(cover.tile));
+        drawTile(renderer, globalZOrder, slot, pass, pass.mesh, cover.bounds, color, snapshot);
+    }
+}
+
+void TiledCanvas::rasterize(Renderer *renderer, float globalZOrder, const stroke::StrokeModel &model, float zoom, const Color4F &color)
+{
+    clear();
+    _zoom = zoom;
+
+    auto &modelBounds = model.getBounds();
+    if (modelBounds.isEmpty())
+        return;
+
+    const float fringe = stroke::StrokeTessellator::Overdraw;
+    stroke::Bounds bounds = stroke::Bounds {modelBounds.minX * zoom, modelBounds.minY * zoom, modelBounds.maxX * zoom, modelBounds.maxY * zoom}.expanded(fringe);
+    _overlapping.clear();
+    _grid.getOverlappingTiles(bounds, _overlapping);
+
+    for (auto tile : _overlapping) {
+        auto tileBounds = _grid.getTileBounds(tile);
+        stroke::Bounds region {tileBounds.minX / zoom, tileBounds.minY / zoom, tileBounds.maxX / zoom, tileBounds.maxY / zoom};
+
+        //! tessellated straight into canvas coordinates, so the tile is drawn without scaling
+        auto &pass = nextPass();
+        _rasterizer.rasterize(model, region, zoom, pass.mesh);
+        bool created;
+        int slot = pass.mesh.empty() ? stroke::TileGrid::NoTile : acquireTile(tile, created);
+        if (slot == stroke::TileGrid::NoTile) {
+            _passCount--;
+            continue;
+        }
+        drawTile(renderer, globalZOrder, slot, pass, pass.mesh, tileBounds, color, false);
+    }
+}
+
+void TiledCanvas::beginHistoryEntry()
+{
+    _history.beginEntry();
+}
+
+void TiledCanvas::endHistoryEntry(Renderer *renderer, float globalZOrder)
+{
+    _historyEndCommand.init(globalZOrder);
+    renderer->addCommand(&_historyEndCommand);
+}
+
+void TiledCanvas::restore(const stroke::HistoryEntry &entry)
+{
+    for (auto &tile : entry.tiles) {
+        int slot = _grid.find(tile.coord);
+        if (slot == stroke::TileGrid::NoTile)
+            continue;
+
+        auto texture = _tiles[slot];
+        if (tile.before == nullptr) {
+            texture->clear(_backgroundColor.r, _backgroundColor.g, _backgroundColor.b, _backgroundColor.a);
+            continue;
+        }
+        _pixels.resize(tile.width * tile.height);
+        tile.before->restore(_pixels.data());
+        texture->getSprite()->getTexture()->updateWithData(_pixels.data(), tile.x, tile.y, tile.width, tile.height);
+    }
+}
+
+size_t TiledCanvas::undo()
+{
+    if (!_history.canUndo())
+        return 0;
+    auto &entry = _history.undo();
+    restore(entry);
+    return entry.strokes;
+}
+
+size_t TiledCanvas::redo()
+{
+    if (!_history.canRedo())
+        return 0;
+    return _history.redo().strokes;
+}
+
+void TiledCanvas::clear()
+{
+    for (auto tile : _tiles) {
+        this->removeChild(tile);
+        tile->release();
+    }
+    _tiles.clear();
+    _grid.clear();
+    _history.clear();
+}
@@ -0,0 +1,138 @@
+//
+//  TiledCanvas.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef TiledCanvas_hpp
+#define TiledCanvas_hpp
+
+#include <memory>
+#include <vector>
+#include "StrokeRenderer.hpp"
+#include "Stroke/StrokeRasterizer.hpp"
+#include "Stroke/TileGrid.hpp"
+#include "Stroke/TileHistory.hpp"
+
+using namespace cocos2d;
+
+//! The drawing's backing store: a RenderTexture per stroke::TileGrid tile, created the first time ink
+//! touches the tile and composited as a child sprite. Canvas coordinates are this node's, and a stroke mesh
+//! is drawn only into the tiles its triangles overlap, each getting the triangles that reach it, scissored
+//! to their bounds.
+//! Blank tiles cost nothing; the Director's clear color shows through them.
+//! The canvas shows the document at a zoom: canvas points per document point. The live strokes are drawn in
+//! canvas coordinates as they come, and a new zoom rasterizes the document again from its stroke::StrokeModel.
+class TiledCanvas : public Node {
+
+public:
+    static constexpr float DefaultTileSize = stroke::TileGrid::DefaultTileSize;
+
+public:
+    static TiledCanvas *create(float tileSize = DefaultTileSize)
+    {
+        TiledCanvas *node = new (std::nothrow) TiledCanvas();
+        if (node && node->init(tileSize))
+        {
+            node->autorelease();
+        }
+        else
+        {
+            CC_SAFE_DELETE(node);
+        }
+        return node;
+    }
+
+    TiledCanvas () : _backgroundColor {1, 1, 1, 1}, _zoom(1), _passCount(0) {}
+    ~TiledCanvas();
+
+    bool init(float tileSize);
+
+    //! what new tiles are cleared to; the ink is premultiplied over it so it has to be opaque.
+    void setBackgroundColor(const Color4F &color) { _backgroundColor = color; }
+
+    //! Tiles that would take the backing store over the budget are not created, and ink falling on them
+    //! is dropped. Lowering the budget does not free tiles that already exist.
+    void setMemoryBudget(size_t bytes) { _grid.setMemoryBudget(bytes); }
+    size_t getMemoryBudget() const { return _grid.getMemoryBudget(); }
+    size_t getMemoryUsage() const { return _grid.getMemoryUsage(); }
+    size_t getTileCount() const { return _grid.getTileCount(); }
+    size_t getRejectedTileCount() const { return _grid.getRejectedCount(); }
+
+    //! the zoom of the last rasterize()
+    float getZoom() const { return _zoom; }
+
+    //! the render passes queued in a frame are reused from the next frame on: call before queueing any.
+    void beginFrame() { _passCount = 0; }
+
+    //! queues mesh, in canvas coordinates, into every tile its triangles overlap, creating tiles as needed.
+    //! Each tile draws a copy of the triangles that reach it, so mesh can change once this returns.
+    void drawMesh(Renderer *renderer, float globalZOrder, const stroke::StrokeMesh &mesh, const Color4F &color);
+
+    //! Replaces every tile with model tessellated again at zoom, so the ink is as sharp as at zoom 1.
+    //! Only tiles with ink are created. The undo history is cleared, its tile copies are of the old zoom.
+    void rasterize(Renderer *renderer, float globalZOrder, const stroke::StrokeModel &model, float zoom, const Color4F &color);
+
+    //! Undo history of the tiles: between beginHistoryEntry() and endHistoryEntry() every tile drawMesh()
+    //! writes to is copied, once, before the write, and the history keeps the scissored part of it. The entry is closed by a render command, after the
+    //! tile copies of the frame queueing it have been read back.
+    void beginHistoryEntry();
+    void endHistoryEntry(Renderer *renderer, float globalZOrder);
+    //! counts a stroke into the open entry, for undo() and redo() to report.
+    void addHistoryStroke() { _history.addStroke(); }
+
+    //! Puts the tiles of the last entry back as they were before its strokes. Returns how many strokes the
+    //! caller removes from its model, 0 if there was nothing to undo.
+    size_t undo();
+    //! Takes the last undone entry back into the history. Returns how many strokes the caller draws again
+    //! with drawMesh(), 0 if there was nothing to redo.
+    size_t redo();
+
+    stroke::TileHistory &getHistory() { return _history; }
+
+    //! releases every tile and the history, back to a blank canvas.
+    void clear();
+
+private:
+    //! what one tile needs to draw a mesh in a frame, kept across frames so drawing doesn't allocate
+    struct TilePass {
+        StrokeRenderer renderer;
+        //! the triangles drawn into the tile, in canvas coordinates
+        stroke::StrokeMesh mesh;
+        CustomCommand snapshotCommand, scissorBeginCommand, scissorEndCommand;
+        stroke::TileCoord tile;
+        //! x, y, width, height in tile pixels, read when the scissor command executes
+        GLint scissorBox[4];
+    };
+
+    RenderTexture *createTile(stroke::TileCoord tile);
+    TilePass &nextPass();
+    void setScissorBox(TilePass &pass, const stroke::Bounds &bounds, const stroke::Bounds &tileBounds);
+    //! queues mesh into the tile at slot, clipped to bounds, reading the tile back first for the history if snapshot
+    void drawTile(Renderer *renderer, float globalZOrder, int slot, TilePass &pass, const stroke::StrokeMesh &mesh, const stroke::Bounds &bounds, const Color4F &color, bool snapshot);
+    int acquireTile(stroke::TileCoord tile, bool &created);
+    void restore(const stroke::HistoryEntry &entry);
+
+private:
+    stroke::TileGrid _grid;
+    Color4F _backgroundColor;
+    float _zoom;
+    stroke::StrokeRasterizer _rasterizer;
+
+    //! indexed by TileGrid slot
+    std::vector<RenderTexture *> _tiles;
+    std::vector<std::unique_ptr<TilePass>> _passes;
+    size_t _passCount;
+    std::vector<stroke::TileCoord> _overlapping;
+    std::vector<stroke::TileCover> _covers;
+
+    stroke::TileHistory _history;
+    CustomCommand _historyEndCommand;
+    //! a tile's pixels on their way to or from the history
+    std::vector<uint32_t> _pixels;
+
+};
+
+#endif /* TiledCanvas_hpp */
@@ -12,7 +12,35 @@ LOCAL_MODULE_FILENAME := libcocos2dcpp
 
 LOCAL_SRC_FILES := hellocpp/main.cpp \
                    ../../Classes/AppDelegate.cpp \
-                   ../../Classes/HelloWorldScene.cpp
+                   ../../Classes/HelloWorldScene.cpp \
+                   ../../Classes/LineDrawer.cpp \
+                   ../../Classes/GestureRecognizers.cpp \
+                   ../../Classes/Stroke/StrokeSmoother.cpp \
+                   ../../Classes/Stroke/StrokeTessellator.cpp \
+                   ../../Classes/Stroke/VelocityCalculator.cpp \
+                   ../../Classes/Stroke/QuadraticEvaluator.cpp \
+                   ../../Classes/Stroke/StrokeMesh.cpp \
+                   ../../Classes/Stroke/UnitCircle.cpp \
+                   ../../Classes/StrokeRenderer.cpp \
+                   ../../Classes/Stroke/FrameProfiler.cpp \
+                   ../../Classes/Stroke/TraceWriter.cpp \
+                   ../../Classes/Stroke/PanTracker.cpp \
+                   ../../Classes/Stroke/StrokePipeline.cpp \
+                   ../../Classes/Stroke/TileGrid.cpp \
+                   ../../Classes/TiledCanvas.cpp \
+                   ../../Classes/Stroke/StrokeModel.cpp \
+                   ../../Classes/Stroke/StrokeRasterizer.cpp \
+                   ../../Classes/Stroke/TileHistory.cpp \
+                   ../../Classes/Stroke/TileSnapshot.cpp \
+                   ../../Classes/Stroke/SoftwareRenderer.cpp \
+                   ../../Classes/Stroke/WorkerPool.cpp \
+                   ../../Classes/Stroke/TessellationWorker.cpp \
+                   ../../Classes/Stroke/InkPredictor.cpp \
+                   ../../Classes/InkOverlay.cpp \
+                   ../../Classes/Stroke/RedrawPolicy.cpp \
+                   ../../Classes/Stroke/InputClock.cpp \
+                   ../../Classes/Stroke/VelocityEstimators.cpp \
+                   ../../Classes/Stroke/StrokeLog.cpp
 
 LOCAL_C_INCLUDES := $(LOCAL_PATH)/../../Classes
 
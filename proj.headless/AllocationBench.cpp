@@ -0,0 +1,83 @@
+//
+//  AllocationBench.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "Benchmarks.hpp"
+
+#include <algorithm>
+#include "FrameDriver.hpp"
+#include "SyntheticStrokes.hpp"
+
+namespace {
+
+struct AllocationTotals {
+    size_t frames = 0;
+    size_t allocations = 0;
+    size_t worstFrame = 0;
+};
+
+void drawStroke(FrameDriver &driver, const std::vector<stroke::LinePoint> &points, int pointsPerFrame, AllocationTotals &totals)
+{
+    size_t start = bench::allocationCount();
+    driver.startNewLine(points[0]);
+    for (size_t i = 1; i < points.size(); ++i) {
+        if (i == points.size() - 1)
+            driver.endLine(points[i]);
+        else
+            driver.addPoint(points[i]);
+
+        if (i % pointsPerFrame == 0 || i == points.size() - 1) {
+            driver.drawFrame();
+
+            size_t now = bench::allocationCount();
+            totals.frames++;
+            totals.allocations += now - start;
+            totals.worstFrame = std::max(totals.worstFrame, now - start);
+            start = now;
+        }
+    }
+}
+
+//! The first stroke grows the persistent buffers to the largest frame of the stroke, or retained to the
+//! whole stroke. Drawing it again is the steady state: every buffer is reused, so not a single allocation
+//! is allowed.
+int runStroke(const char *name, const std::vector<stroke::LinePoint> &points, int pointsPerFrame, bool retain = false)
+{
+    FrameDriver driver;
+    driver.getPipeline().setRetainStroke(retain);
+
+    AllocationTotals warmUp;
+    drawStroke(driver, points, pointsPerFrame, warmUp);
+
+    AllocationTotals steady;
+    drawStroke(driver, points, pointsPerFrame, steady);
+
+    bench::report(name, "warm up allocations", warmUp.allocations, "");
+    bench::report(name, "steady allocations", (double)steady.allocations / steady.frames, "/frame");
+    bench::report(name, "worst frame", steady.worstFrame, "allocations");
+
+    if (steady.allocations != 0) {
+        printf("  %-32s FAILED %zu allocations in %zu steady state frames\n", name, steady.allocations, steady.frames);
+        return 1;
+    }
+    return 0;
+}
+
+}
+
+int benchAllocations(const bench::Options &options)
+{
+    int count = options.quick ? 200 : 2000;
+    int failures = 0;
+    failures += runStroke("spiral, 1 point/frame", synthetic::spiral(count), 1);
+    failures += runStroke("spiral, 4 points/frame", synthetic::spiral(count), 4);
+    failures += runStroke("scribble, 4 points/frame", synthetic::scribble(count), 4);
+    failures += runStroke("scribble, 16 points/frame", synthetic::scribble(count), 16);
+    failures += runStroke("retained spiral, 1 point/frame", synthetic::spiral(count), 1, true);
+    failures += runStroke("retained scribble, 4 pts/frame", synthetic::scribble(count), 4, true);
+    return failures;
+}
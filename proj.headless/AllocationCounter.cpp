@@ -0,0 +1,54 @@
+//
+//  AllocationCounter.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "Bench.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+//! Replaces the global allocation functions of the StrokeBench executable to count heap allocations.
+//! Only the count is tracked, so the overhead is one relaxed atomic increment per allocation.
+
+namespace {
+
+std::atomic<size_t> allocations(0);
+
+void *countedAllocate(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    void *p = malloc(size ? size : 1);
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+void *countedAllocate(size_t size, const std::nothrow_t &) noexcept
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return malloc(size ? size : 1);
+}
+
+}
+
+size_t bench::allocationCount()
+{
+    return allocations.load(std::memory_order_relaxed);
+}
+
+void *operator new(size_t size) { return countedAllocate(size); }
+void *operator new[](size_t size) { return countedAllocate(size); }
+void *operator new(size_t size, const std::nothrow_t &tag) noexcept { return countedAllocate(size, tag); }
+void *operator new[](size_t size, const std::nothrow_t &tag) noexcept { return countedAllocate(size, tag); }
+
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { free(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
@@ -0,0 +1,94 @@
+//
+//  Bench.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef Bench_hpp
+#define Bench_hpp
+
+#include <stdio.h>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+//! Minimal timing helpers for the headless stroke benchmarks.
+namespace bench {
+
+using clock = std::chrono::steady_clock;
+
+#ifndef STROKE_GESTURE_DIR
+#define STROKE_GESTURE_DIR "gestures"
+#endif
+
+struct Options {
+    double minSeconds = 0.5;
+    bool quick = false;
+    //! where the replay benchmark finds the recorded gesture corpus
+    std::string gestureDir = STROKE_GESTURE_DIR;
+};
+
+struct Timing {
+    long long iterations;
+    double seconds;
+
+    double perSecond(double itemsPerIteration) const { return iterations * itemsPerIteration / seconds; }
+    double microsPerIteration() const { return seconds * 1e6 / iterations; }
+};
+
+//! runs fn repeatedly until at least minSeconds have elapsed, doubling the batch size each round.
+inline Timing measure(const Options &options, const std::function<void()> &fn)
+{
+    long long batch = 1;
+    long long iterations = 0;
+    auto start = clock::now();
+    double elapsed = 0;
+
+    while (elapsed < options.minSeconds) {
+        for (long long i = 0; i < batch; ++i) {
+            fn();
+        }
+        iterations += batch;
+        batch *= 2;
+        elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    }
+    return Timing {iterations, elapsed};
+}
+
+inline double secondsSince(clock::time_point start)
+{
+    return std::chrono::duration<double>(clock::now() - start).count();
+}
+
+//! prevents the optimizer from discarding a computed value.
+template <typename T>
+inline void doNotOptimize(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &value;
+#endif
+}
+
+inline void report(const char *name, const char *metric, double value, const char *unit)
+{
+    printf("  %-32s %-20s %14.2f %s\n", name, metric, value, unit);
+}
+
+//! number of global operator new calls so far, counted by AllocationCounter.cpp.
+size_t allocationCount();
+
+struct Benchmark {
+    const char *name;
+    const char *description;
+    std::function<int(const Options &)> run;
+};
+
+}
+
+#endif /* Bench_hpp */
@@ -0,0 +1,39 @@
+//
+//  Benchmarks.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef Benchmarks_hpp
+#define Benchmarks_hpp
+
+#include "Bench.hpp"
+
+//! each benchmark returns the number of failed checks, zero when everything passed.
+
+int benchTessellation(const bench::Options &options);
+int benchSmoothing(const bench::Options &options);
+int benchFlattening(const bench::Options &options);
+int benchStress(const bench::Options &options);
+int benchMesh(const bench::Options &options);
+int benchCaps(const bench::Options &options);
+int benchAllocations(const bench::Options &options);
+int benchTrace(const bench::Options &options);
+int benchReplay(const bench::Options &options);
+int benchTiles(const bench::Options &options);
+int benchModel(const bench::Options &options);
+int benchHistory(const bench::Options &options);
+int benchSoftware(const bench::Options &options);
+int benchThreaded(const bench::Options &options);
+int benchMultiTouch(const bench::Options &options);
+int benchPrediction(const bench::Options &options);
+int benchOverlay(const bench::Options &options);
+int benchRedraw(const bench::Options &options);
+int benchTimestamps(const bench::Options &options);
+int benchVelocity(const bench::Options &options);
+int benchCoalesced(const bench::Options &options);
+int benchStrokeLog(const bench::Options &options);
+
+#endif /* Benchmarks_hpp */
@@ -0,0 +1,123 @@
+//
+//  CapBench.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "Benchmarks.hpp"
+
+#include <algorithm>
+
+#include "MeshValidation.hpp"
+#include "Reference.hpp"
+#include "Stroke/StrokeTessellator.hpp"
+
+namespace {
+
+//! largest distance between a chord of the rim and the arc it replaces, measured at the chord midpoints.
+float maxRimError(const stroke::StrokeMesh &mesh, stroke::Vec2 center, float radius)
+{
+    //! vertex 0 is the center, then rim and overdraw vertices alternate
+    auto &vertices = mesh.getVertices();
+    float maxError = 0;
+    for (size_t i = 3; i < vertices.size(); i += 2) {
+        stroke::Vec2 a {vertices[i - 2].x, vertices[i - 2].y};
+        stroke::Vec2 b {vertices[i].x, vertices[i].y};
+        float onRim = std::max(fabsf((a - center).getLength() - radius), fabsf((b - center).getLength() - radius));
+        float chord = radius - ((a + b) * .5f - center).getLength();
+        maxError = std::max(maxError, std::max(onRim, chord));
+    }
+    return maxError;
+}
+
+int runRadius(float radius, float tolerance, const bench::Options &options)
+{
+    const stroke::Color4F black {0, 0, 0, 1};
+    int failures = 0;
+
+    char name[32];
+    snprintf(name, sizeof(name), "radius %g", radius);
+
+    //! caps in every direction, including the axes the original angle sign test special cased
+    std::vector<stroke::CirclePoint> circles;
+    for (int i = 0; i < 64; ++i) {
+        float angle = (float)(2 * M_PI * i / 64);
+        circles.push_back(stroke::CirclePoint {stroke::Vec2 {100, 100}, radius * 2, stroke::Vec2 {cosf(angle), sinf(angle)}});
+    }
+
+    float maxError = 0, maxEndError = 0;
+    size_t vertices = 0, indices = 0;
+    bool valid = true;
+    stroke::StrokeMesh mesh;
+    for (auto &circle : circles) {
+        mesh.clear();
+        stroke::StrokeTessellator::triangulateCircle(circle, stroke::StrokeTessellator::Overdraw, tolerance, mesh);
+        vertices = mesh.getVertices().size();
+        indices = mesh.getIndices().size();
+        valid = valid && validateMesh(mesh);
+        maxError = std::max(maxError, maxRimError(mesh, circle.pos, radius));
+
+        //! the rim has to sweep the same half circle as the original caps: perp to the opposite side
+        std::vector<reference::Vertex> refVertices;
+        std::vector<unsigned short> refIndices;
+        reference::LineTessellator::triangulateCircle(circle, black, stroke::StrokeTessellator::Overdraw, refVertices, refIndices);
+        auto &v = mesh.getVertices();
+        stroke::Vec2 first {v[1].x, v[1].y}, last {v[v.size() - 2].x, v[v.size() - 2].y};
+        stroke::Vec2 refFirst {refVertices[1].x, refVertices[1].y}, refLast {refVertices[refVertices.size() - 3].x, refVertices[refVertices.size() - 3].y};
+        maxEndError = std::max(maxEndError, std::max((first - refFirst).getLength(), (last - refLast).getLength()));
+    }
+
+    auto beforeTiming = bench::measure(options, [&] {
+        std::vector<reference::Vertex> refVertices;
+        std::vector<unsigned short> refIndices;
+        for (auto &circle : circles) {
+            refVertices.clear();
+            refIndices.clear();
+            reference::LineTessellator::triangulateCircle(circle, black, stroke::StrokeTessellator::Overdraw, refVertices, refIndices);
+        }
+        bench::doNotOptimize(refVertices.data());
+    });
+    auto afterTiming = bench::measure(options, [&] {
+        for (auto &circle : circles) {
+            mesh.clear();
+            stroke::StrokeTessellator::triangulateCircle(circle, stroke::StrokeTessellator::Overdraw, tolerance, mesh);
+        }
+        bench::doNotOptimize(mesh.getVertices().data());
+    });
+
+    bench::report(name, "segments", (vertices - 3) / 2, "");
+    bench::report(name, "vertices", vertices, "/cap");
+    bench::report(name, "indices", indices, "/cap");
+    bench::report(name, "max rim error", maxError, "pt");
+    bench::report(name, "before time", beforeTiming.seconds * 1e9 / (beforeTiming.iterations * circles.size()), "ns/cap");
+    bench::report(name, "after time", afterTiming.seconds * 1e9 / (afterTiming.iterations * circles.size()), "ns/cap");
+
+    //! float rounding of the rotated table entries is allowed on top of the tolerance
+    if (maxError > tolerance + radius * 1e-5f) {
+        printf("  %-32s FAILED rim error %g exceeds tolerance %g\n", name, maxError, tolerance);
+        failures++;
+    }
+    if (maxEndError > 1e-3f * std::max(radius, 1.0f)) {
+        printf("  %-32s FAILED cap does not cover the original half circle (%g)\n", name, maxEndError);
+        failures++;
+    }
+    if (!valid) {
+        printf("  %-32s FAILED mesh validation\n", name);
+        failures++;
+    }
+    return failures;
+}
+
+}
+
+int benchCaps(const bench::Options &options)
+{
+    const float tolerance = stroke::StrokeTessellator::DefaultCapTolerance;
+    int failures = 0;
+    for (float radius : {0.5f, 1.0f, 2.0f, 4.0f, 8.0f, 20.0f, 50.0f, 200.0f}) {
+        failures += runRadius(radius, tolerance, options);
+    }
+    return failures;
+}
@@ -0,0 +1,123 @@
+//
+//  CoalescedBench.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "Benchmarks.hpp"
+
+#include <math.h>
+#include "GestureTrace.hpp"
+
+namespace {
+
+//! a display frame's moves delivered as one event, as platforms coalescing their touch samples do
+const double FrameInterval = GesturePlayer::DefaultFrameInterval;
+
+using Strokes = std::vector<std::vector<stroke::LinePoint>>;
+
+struct Delivered {
+    Strokes strokes;
+    size_t points = 0;
+    double micros = 0;
+};
+
+Delivered play(const GestureTrace &trace, GesturePlayer::Delivery delivery, const bench::Options &options)
+{
+    Delivered result;
+    size_t frames = 0;
+    auto start = bench::clock::now();
+    do {
+        stroke::StrokeModel model;
+        stroke::PanTracker tracker;
+        stroke::StrokePipeline pipeline;
+        pipeline.setModel(&model);
+        GesturePlayer player {trace, tracker, pipeline, FrameInterval};
+        player.setDelivery(delivery);
+        while (player.feedFrame()) {
+            pipeline.drawFrame();
+            frames++;
+        }
+
+        if (result.strokes.empty()) {
+            for (size_t s = 0; s < model.getStrokeCount(); ++s) {
+                result.strokes.emplace_back();
+                model.decode(s, result.strokes.back());
+                result.points += result.strokes.back().size();
+            }
+        }
+    } while (bench::secondsSince(start) < options.minSeconds);
+    result.micros = bench::secondsSince(start) * 1e6 / frames;
+    return result;
+}
+
+float distanceToSegment(stroke::Vec2 p, stroke::Vec2 a, stroke::Vec2 b)
+{
+    stroke::Vec2 segment = b - a;
+    float lengthSq = segment.getLengthSq();
+    float t = lengthSq > 0 ? std::min(1.0f, std::max(0.0f, (p - a).dot(segment) / lengthSq)) : 0;
+    return (a + segment * t - p).getLength();
+}
+
+//! how far the points of every stroke of a are off the polyline of the same stroke of b, at most
+float maxDeviation(const Strokes &a, const Strokes &b)
+{
+    float deviation = 0;
+    for (size_t s = 0; s < std::min(a.size(), b.size()); ++s) {
+        auto &line = b[s];
+        for (auto &point : a[s]) {
+            float nearest = line.empty() ? 0 : (point.pos - line.front().pos).getLength();
+            for (size_t i = 1; i < line.size(); ++i) {
+                nearest = std::min(nearest, distanceToSegment(point.pos, line[i - 1].pos, line[i].pos));
+            }
+            deviation = std::max(deviation, nearest);
+        }
+    }
+    return deviation;
+}
+
+bool samePoints(const Strokes &a, const Strokes &b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t s = 0; s < a.size(); ++s) {
+        if (a[s].size() != b[s].size())
+            return false;
+        for (size_t i = 0; i < a[s].size(); ++i) {
+            if (a[s][i].pos.x != b[s][i].pos.x || a[s][i].pos.y != b[s][i].pos.y || a[s][i].width != b[s][i].width)
+                return false;
+        }
+    }
+    return true;
+}
+
+int runGesture(const GestureTrace &trace, const bench::Options &options)
+{
+    const char *name = trace.name.c_str();
+    Delivered each = play(trace, GesturePlayer::EachSample, options);
+    Delivered coalesced = play(trace, GesturePlayer::Coalesced, options);
+    Delivered latest = play(trace, GesturePlayer::LatestOnly, options);
+
+    bench::report(name, "points each sample", each.points, "");
+    bench::report(name, "points coalesced", coalesced.points, "");
+    bench::report(name, "points latest only", latest.points, "");
+    bench::report(name, "latest only off path", maxDeviation(each.strokes, latest.strokes), "pt");
+    bench::report(name, "frame each sample", each.micros, "us");
+    bench::report(name, "frame coalesced", coalesced.micros, "us");
+
+    //! a batch of samples draws exactly what the samples one at a time do
+    if (!samePoints(each.strokes, coalesced.strokes)) {
+        printf("  %-32s FAILED coalesced batches record %zu points, one at a time %zu\n", name, coalesced.points, each.points);
+        return 1;
+    }
+    return 0;
+}
+
+}
+
+int benchCoalesced(const bench::Options &options)
+{
+    return forEachGesture(options, [&] (const GestureTrace &trace) { return runGesture(trace, options); });
+}
@@ -0,0 +1,136 @@
+//
+//  FlatteningBench.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "Benchmarks.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include "FrameDriver.hpp"
+#include "SyntheticStrokes.hpp"
+#include "Stroke/QuadraticEvaluator.hpp"
+
+using stroke::StrokeSmoother;
+
+namespace {
+
+stroke::LinePoint evaluateAt(const stroke::QuadraticCurve &q, float t)
+{
+    return stroke::LinePoint {
+        stroke::Vec2 {(q.ax * t + q.bx) * t + q.cx, (q.ay * t + q.by) * t + q.cy},
+        (q.aw * t + q.bw) * t + q.cw
+    };
+}
+
+//! densely samples every curve of the stroke and returns the largest distance between the stroke edge
+//! on the true curve and on the flattened polyline.
+float measureDeviation(const StrokeSmoother &smoother, const std::vector<stroke::LinePoint> &points)
+{
+    float worst = 0;
+    for (size_t i = 2; i < points.size(); ++i) {
+        stroke::LinePoint start {(points[i - 1].pos + points[i - 2].pos) * .5, (points[i - 1].width + points[i - 2].width) * 0.5f};
+        stroke::LinePoint end {(points[i].pos + points[i - 1].pos) * .5, (points[i].width + points[i - 1].width) * 0.5f};
+        auto curve = stroke::QuadraticCurve::fromControlPoints(start, points[i - 1], end);
+
+        int segments = smoother.numberOfSegments(start, points[i - 1], end);
+        for (int k = 0; k < segments; ++k) {
+            float t0 = (float)k / segments, t1 = (float)(k + 1) / segments;
+            auto p0 = evaluateAt(curve, t0), p1 = evaluateAt(curve, t1);
+
+            const int probes = 8;
+            for (int j = 1; j < probes; ++j) {
+                float f = (float)j / probes;
+                auto exact = evaluateAt(curve, t0 + (t1 - t0) * f);
+                stroke::Vec2 chord = p0.pos + (p1.pos - p0.pos) * f;
+                float chordWidth = p0.width + (p1.width - p0.width) * f;
+
+                float deviation = (exact.pos - chord).getLength() + 0.5f * fabsf(exact.width - chordWidth);
+                worst = std::max(worst, deviation);
+            }
+        }
+    }
+    return worst;
+}
+
+struct ModeResult {
+    size_t samples;
+    size_t vertices;
+    double microsPerStroke;
+};
+
+ModeResult drawStroke(FrameDriver &driver, const std::vector<stroke::LinePoint> &points, const bench::Options &options)
+{
+    auto draw = [&] (size_t &vertices) {
+        driver.startNewLine(points[0]);
+        for (size_t i = 1; i < points.size(); ++i) {
+            if (i == points.size() - 1)
+                driver.endLine(points[i]);
+            else
+                driver.addPoint(points[i]);
+            if (i % 4 == 0 || i == points.size() - 1)
+                vertices += driver.drawFrame().vertices;
+        }
+    };
+
+    ModeResult result {0, 0, 0};
+    driver.getSmoother().resetStats();
+    draw(result.vertices);
+    result.samples = driver.getSmoother().getStats().emittedSamples;
+
+    size_t ignored = 0;
+    auto timing = bench::measure(options, [&] { draw(ignored); });
+    result.microsPerStroke = timing.microsPerIteration();
+    return result;
+}
+
+int runStroke(const char *name, const std::vector<stroke::LinePoint> &points, const bench::Options &options)
+{
+    int failures = 0;
+
+    FrameDriver driver;
+    driver.getSmoother().setFlattening(StrokeSmoother::Flattening::Fixed);
+    auto fixed = drawStroke(driver, points, options);
+    bench::report(name, "fixed samples", fixed.samples, "");
+    bench::report(name, "fixed vertices", fixed.vertices, "");
+    bench::report(name, "fixed time", fixed.microsPerStroke, "us/stroke");
+
+    driver.getSmoother().setFlattening(StrokeSmoother::Flattening::Adaptive);
+    for (float tolerance : {0.05f, 0.1f, 0.25f, 0.5f}) {
+        driver.getSmoother().setFlatteningTolerance(tolerance);
+        auto adaptive = drawStroke(driver, points, options);
+        float deviation = measureDeviation(driver.getSmoother(), points);
+
+        char label[64];
+        snprintf(label, sizeof(label), "tol %.2f vertices", tolerance);
+        bench::report(name, label, adaptive.vertices, "");
+        snprintf(label, sizeof(label), "tol %.2f reduction", tolerance);
+        bench::report(name, label, (double)fixed.vertices / adaptive.vertices, "x");
+        snprintf(label, sizeof(label), "tol %.2f max error", tolerance);
+        bench::report(name, label, deviation, "pt");
+        snprintf(label, sizeof(label), "tol %.2f time", tolerance);
+        bench::report(name, label, adaptive.microsPerStroke, "us/stroke");
+
+        //! the bound is exact for uniform steps in t; allow for float rounding in the evaluation
+        if (deviation > tolerance * 1.01f + 1e-3f) {
+            printf("  %-32s FAILED deviation %g exceeds tolerance %g\n", name, deviation, tolerance);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+}
+
+int benchFlattening(const bench::Options &options)
+{
+    int count = options.quick ? 200 : 2000;
+    int failures = 0;
+    failures += runStroke("slow spiral", synthetic::spiral(count, 3.0f), options);
+    failures += runStroke("spiral", synthetic::spiral(count), options);
+    failures += runStroke("scribble", synthetic::scribble(count), options);
+    return failures;
+}
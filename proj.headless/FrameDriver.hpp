@@ -0,0 +1,77 @@
+//
+//  FrameDriver.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef FrameDriver_hpp
+#define FrameDriver_hpp
+
+#include <vector>
+#include "Stroke/StrokePipeline.hpp"
+
+//! Drives the same StrokePipeline LineDrawer draws from, without the render texture and GL submission,
+//! so the geometry pipeline can be driven from a recorded or synthetic point stream.
+class FrameDriver {
+
+public:
+    struct FrameResult {
+        size_t smoothedPoints;
+        size_t vertices;
+        size_t indices;
+    };
+
+public:
+    FrameDriver () : _profiler(nullptr) {}
+
+    void setLineSmoothing(bool enable) { _pipeline.setLineSmoothing(enable); }
+
+    //! profiles every drawFrame() with the same phases and counters as LineDrawer, nullptr to stop.
+    void setProfiler(stroke::FrameProfiler *profiler)
+    {
+        _profiler = profiler;
+        _pipeline.setProfiler(profiler);
+    }
+
+    //! the first point is added three times, as LineDrawer does when a pan begins.
+    void startNewLine(stroke::LinePoint point)
+    {
+        _pipeline.clearPoints();
+        _pipeline.startNewLine(point.pos, point.width);
+        _pipeline.addPoint(point.pos, point.width);
+        _pipeline.addPoint(point.pos, point.width);
+    }
+
+    void addPoint(stroke::LinePoint point) { _pipeline.addPoint(point.pos, point.width); }
+    void endLine(stroke::LinePoint point) { _pipeline.endLine(point.pos, point.width); }
+
+    FrameResult drawFrame()
+    {
+        FrameResult result {0, 0, 0};
+        if (_profiler)
+            _profiler->beginFrame();
+
+        if (_pipeline.drawFrame()) {
+            result.smoothedPoints = _pipeline.getFramePointCount();
+            result.vertices = _pipeline.getMesh().getVertices().size();
+            result.indices = _pipeline.getMesh().getIndices().size();
+        }
+
+        if (_profiler)
+            _profiler->endFrame();
+        return result;
+    }
+
+    stroke::StrokePipeline &getPipeline() { return _pipeline; }
+    stroke::StrokeSmoother &getSmoother() { return _pipeline.getSmoother(); }
+    stroke::StrokeTessellator &getTessellator() { return _pipeline.getTessellator(); }
+
+private:
+    stroke::StrokePipeline _pipeline;
+    stroke::FrameProfiler *_profiler;
+
+};
+
+#endif /* FrameDriver_hpp */
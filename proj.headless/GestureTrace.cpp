@@ -0,0 +1,182 @@
+//
+//  GestureTrace.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "GestureTrace.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include "Bench.hpp"
+
+size_t GestureTrace::getStrokeCount() const
+{
+    size_t strokes = 0;
+    for (auto &sample : samples) {
+        if (sample.event == TouchSample::Down)
+            strokes++;
+    }
+    return strokes;
+}
+
+int forEachGesture(const bench::Options &options, const std::function<int (const GestureTrace &)> &fn)
+{
+    int failures = 0;
+    for (auto gesture : GestureCorpus) {
+        GestureTrace trace;
+        std::string error;
+        if (!loadGestureTrace(options.gestureDir + "/" + gesture + ".txt", trace, error)) {
+            printf("  %-32s FAILED %s\n", gesture, error.c_str());
+            failures++;
+            continue;
+        }
+        failures += fn(trace);
+    }
+    return failures;
+}
+
+bool loadGestureCorpus(const bench::Options &options, std::vector<GestureTrace> &traces)
+{
+    traces.clear();
+    for (auto gesture : GestureCorpus) {
+        traces.emplace_back();
+        std::string error;
+        if (!loadGestureTrace(options.gestureDir + "/" + gesture + ".txt", traces.back(), error)) {
+            printf("  %-32s FAILED %s\n", gesture, error.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+bool loadGestureTrace(const std::string &path, GestureTrace &trace, std::string &error)
+{
+    FILE *file = fopen(path.c_str(), "r");
+    if (file == nullptr) {
+        error = "can't open " + path;
+        return false;
+    }
+
+    auto slash = path.find_last_of('/');
+    trace.name = path.substr(slash == std::string::npos ? 0 : slash + 1);
+    auto dot = trace.name.rfind('.');
+    if (dot != std::string::npos)
+        trace.name.erase(dot);
+    trace.samples.clear();
+
+    char line[256];
+    int lineNumber = 0;
+    bool down = false;
+    while (fgets(line, sizeof(line), file)) {
+        lineNumber++;
+        if (line[0] == '#' || line[0] == '\n')
+            continue;
+
+        char event[8];
+        TouchSample sample;
+        if (sscanf(line, "%7s %lf %f %f", event, &sample.time, &sample.location.x, &sample.location.y) != 4) {
+            error = path + ":" + std::to_string(lineNumber) + ": expected 'event time x y'";
+            fclose(file);
+            return false;
+        }
+
+        if (strcmp(event, "down") == 0)
+            sample.event = TouchSample::Down;
+        else if (strcmp(event, "move") == 0)
+            sample.event = TouchSample::Move;
+        else if (strcmp(event, "up") == 0)
+            sample.event = TouchSample::Up;
+        else {
+            error = path + ":" + std::to_string(lineNumber) + ": unknown event " + event;
+            fclose(file);
+            return false;
+        }
+
+        //! every move and up has to belong to a touch that went down
+        if ((sample.event == TouchSample::Down) == down) {
+            error = path + ":" + std::to_string(lineNumber) + ": " + event + (down ? " while the touch is down" : " without a touch down");
+            fclose(file);
+            return false;
+        }
+        if (sample.event != TouchSample::Move)
+            down = sample.event == TouchSample::Down;
+
+        trace.samples.push_back(sample);
+    }
+    fclose(file);
+
+    if (trace.samples.empty() || down) {
+        error = path + ": " + (down ? "the last touch never goes up" : "no samples");
+        return false;
+    }
+    return true;
+}
+
+constexpr double GesturePlayer::DefaultFrameInterval;
+constexpr double GesturePlayer::CallbackInterval;
+
+bool GesturePlayer::feedFrame()
+{
+    auto &samples = _trace.samples;
+    if (_next >= samples.size())
+        return false;
+
+    const auto epoch = stroke::PanTracker::time_point {};
+    auto timestampOf = [&] (double seconds) {
+        return epoch + std::chrono::duration_cast<stroke::PanTracker::time_point::duration>(std::chrono::duration<double>(seconds));
+    };
+
+    for (int delivered = 0; _next < samples.size() && samples[_next].time < _frameEnd; ++_next, ++delivered) {
+        auto &sample = samples[_next];
+        auto timestamp = timestampOf(_deliveryTimestamps ? _frameEnd + delivered * CallbackInterval : sample.time);
+        if (sample.event == TouchSample::Move) {
+            _moves.push_back(stroke::InputSample {sample.location, timestamp});
+            continue;
+        }
+        deliverMoves();
+
+        if (sample.event == TouchSample::Down)
+            _tracker.touchBegan(sample.location, timestamp);
+        else if (_tracker.touchEnded(sample.location))
+            _pipeline.panCompleted(_tracker.getLocation(), _tracker.getVelocity());
+    }
+    deliverMoves();
+    _frameEnd += _frameInterval;
+    return true;
+}
+
+void GesturePlayer::deliverMoves()
+{
+    if (_moves.empty())
+        return;
+    switch (_delivery) {
+        case EachSample:
+            for (auto &move : _moves) {
+                moveTracker(&move, 1);
+            }
+            break;
+
+        case Coalesced:
+            moveTracker(_moves.data(), _moves.size());
+            break;
+
+        case LatestOnly:
+            moveTracker(&_moves.back(), 1);
+            break;
+    }
+    _moves.clear();
+}
+
+void GesturePlayer::moveTracker(const stroke::InputSample *samples, size_t count)
+{
+    if (!_tracker.touchMoved(samples, count))
+        return;
+    auto &panSamples = _tracker.getSamples();
+    if (_tracker.getState() == stroke::PanTracker::Began)
+        _pipeline.panBegan(panSamples.data(), panSamples.size());
+    else
+        _pipeline.panChanged(panSamples.data(), panSamples.size());
+}
@@ -0,0 +1,99 @@
+//
+//  GestureTrace.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef GestureTrace_hpp
+#define GestureTrace_hpp
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "Stroke/PanTracker.hpp"
+#include "Stroke/StrokePipeline.hpp"
+
+//! A recorded touch trace: one touch sample per line, "down", "move" or "up" followed by the time in
+//! seconds and the location in points. Lines starting with # are comments.
+struct TouchSample {
+    enum Event { Down, Move, Up };
+
+    Event event;
+    double time;
+    stroke::Vec2 location;
+};
+
+//! the traces in proj.headless/gestures
+static const char *const GestureCorpus[] = {"slow-signature", "fast-scribble", "long-spiral", "dense-hatching"};
+
+struct GestureTrace {
+    std::string name;
+    std::vector<TouchSample> samples;
+
+    size_t getStrokeCount() const;
+    double getDuration() const { return samples.empty() ? 0 : samples.back().time - samples.front().time; }
+};
+
+//! reads path into trace, returning false with a message in error if the file is missing or malformed.
+bool loadGestureTrace(const std::string &path, GestureTrace &trace, std::string &error);
+
+namespace bench {
+struct Options;
+}
+
+//! Runs fn on each trace of the corpus in options.gestureDir, returning the failures fn counted plus one for
+//! each trace that didn't load, reported as it failed.
+int forEachGesture(const bench::Options &options, const std::function<int (const GestureTrace &)> &fn);
+//! The whole corpus into traces, for benchmarks that play the traces together. Returns false, having
+//! reported the trace that didn't load, if any didn't.
+bool loadGestureCorpus(const bench::Options &options, std::vector<GestureTrace> &traces);
+
+//! Feeds a trace through the same PanTracker and StrokePipeline PanGestureRecognizer and LineDrawer use,
+//! with the recorded timestamps, one display frame of samples at a time but without waiting for it.
+class GesturePlayer {
+
+public:
+    //! the display refresh the samples are grouped into frames at
+    static constexpr double DefaultFrameInterval = 1.0 / 60;
+    //! between the callbacks of samples delivered together, when stamped at delivery
+    static constexpr double CallbackInterval = 20e-6;
+
+    //! How a frame's moves reach the tracker: one call each, all in one coalesced batch, or only the last
+    //! of them, as a platform that drops the samples it coalesced.
+    enum Delivery { EachSample, Coalesced, LatestOnly };
+
+public:
+    GesturePlayer (const GestureTrace &trace, stroke::PanTracker &tracker, stroke::StrokePipeline &pipeline, double frameInterval = DefaultFrameInterval)
+    : _trace(trace), _tracker(tracker), _pipeline(pipeline), _frameInterval(frameInterval), _next(0),
+      _frameEnd(trace.samples.empty() ? 0 : trace.samples.front().time + frameInterval), _deliveryTimestamps(false), _delivery(EachSample) {}
+
+    //! Stamps the samples with the time they are delivered rather than their own, as callbacks reading the
+    //! clock would: a frame's samples all at its end, CallbackInterval apart.
+    void setDeliveryTimestamps(bool delivery) { _deliveryTimestamps = delivery; }
+    void setDelivery(Delivery delivery) { _delivery = delivery; }
+
+
+    //! hands the pipeline the samples of the next frame, false once the trace is over.
+    bool feedFrame();
+
+private:
+    void deliverMoves();
+    void moveTracker(const stroke::InputSample *samples, size_t count);
+
+private:
+    const GestureTrace &_trace;
+    stroke::PanTracker &_tracker;
+    stroke::StrokePipeline &_pipeline;
+    double _frameInterval;
+    size_t _next;
+    double _frameEnd;
+    bool _deliveryTimestamps;
+    Delivery _delivery;
+    //! the moves of the frame not handed to the tracker yet
+    std::vector<stroke::InputSample> _moves;
+
+};
+
+#endif /* GestureTrace_hpp */
@@ -0,0 +1,275 @@
+//
+//  HistoryBench.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "Benchmarks.hpp"
+
+#include <algorithm>
+#include <random>
+#include "Stroke/StrokeSmoother.hpp"
+#include "Stroke/TileHistory.hpp"
+
+namespace {
+
+const int StrokeCount = 1000;
+const uint32_t Background = 0xffffffff;
+
+//! Tiles of RGBA8888 pixels on the CPU, standing in for TiledCanvas's render textures. Strokes are stamped
+//! as discs along their smoothed polyline: not the GPU's antialiasing, but ink where the GPU would put it,
+//! which is what the history has to capture.
+class PixelCanvas {
+
+public:
+    PixelCanvas () : _grid(stroke::TileGrid::DefaultTileSize, 1) {}
+
+    stroke::TileGrid &getGrid() { return _grid; }
+    int getTilePixels() const { return _grid.getTilePixels(); }
+    uint32_t *getTile(int slot) { return _tiles[slot].data(); }
+
+    int acquire(stroke::TileCoord tile, bool &created)
+    {
+        int slot = _grid.acquire(tile, created);
+        if (created)
+            _tiles.emplace_back(getTilePixels() * getTilePixels(), Background);
+        return slot;
+    }
+
+    void stamp(const std::vector<stroke::LinePoint> &points)
+    {
+        for (size_t i = 1; i < points.size(); ++i) {
+            auto &a = points[i - 1];
+            auto &b = points[i];
+            int steps = std::max(1, (int)ceilf((b.pos - a.pos).getLength() * 2));
+            for (int s = 0; s < steps; ++s) {
+                float t = (float)s / steps;
+                disc(a.pos + (b.pos - a.pos) * t, (a.width + (b.width - a.width) * t) * .5f);
+            }
+        }
+    }
+
+    //! FNV-1a over the tiles with ink, so a tile cleared back to the background hashes as no tile
+    uint64_t hash() const
+    {
+        uint64_t h = 1469598103934665603ull;
+        for (size_t slot = 0; slot < _tiles.size(); ++slot) {
+            auto &tile = _tiles[slot];
+            if (std::all_of(tile.begin(), tile.end(), [] (uint32_t p) { return p == Background; }))
+                continue;
+            auto coord = _grid.getTile((int)slot);
+            h = (h ^ (uint32_t)coord.x) * 1099511628211ull;
+            h = (h ^ (uint32_t)coord.y) * 1099511628211ull;
+            for (auto p : tile) {
+                h = (h ^ p) * 1099511628211ull;
+            }
+        }
+        return h;
+    }
+
+private:
+    void disc(stroke::Vec2 center, float radius)
+    {
+        const int size = getTilePixels();
+        for (int y = (int)floorf(center.y - radius); y <= (int)ceilf(center.y + radius); ++y) {
+            for (int x = (int)floorf(center.x - radius); x <= (int)ceilf(center.x + radius); ++x) {
+                float d = (stroke::Vec2 {x + .5f, y + .5f} - center).getLength();
+                float coverage = std::min(1.0f, std::max(0.0f, radius + .5f - d));
+                if (coverage <= 0)
+                    continue;
+
+                auto tile = _grid.tileAt((float)x, (float)y);
+                int slot = _grid.find(tile);
+                if (slot == stroke::TileGrid::NoTile)
+                    continue;
+
+                uint32_t &pixel = _tiles[slot][(y - tile.y * size) * size + (x - tile.x * size)];
+                uint8_t gray = (uint8_t)lroundf(255 * (1 - coverage));
+                uint8_t current = pixel & 0xff;
+                if (gray < current)
+                    pixel = 0xff000000u | gray << 16 | gray << 8 | gray;
+            }
+        }
+    }
+
+private:
+    stroke::TileGrid _grid;
+    std::vector<std::vector<uint32_t>> _tiles;
+
+};
+
+struct Stroke {
+    std::vector<stroke::LinePoint> points;
+    stroke::Bounds bounds;
+};
+
+std::vector<Stroke> makeStrokes()
+{
+    std::mt19937 random(14);
+    std::uniform_real_distribution<float> x(40, 984), y(40, 728), turn(-0.6f, 0.6f), width(1, 8);
+    std::uniform_int_distribution<int> length(10, 40);
+
+    stroke::StrokeSmoother smoother;
+    std::vector<Stroke> strokes(StrokeCount);
+    std::vector<stroke::LinePoint> input;
+    for (auto &s : strokes) {
+        input.clear();
+        stroke::Vec2 pos {x(random), y(random)};
+        float angle = turn(random) * 10;
+        int count = length(random);
+        for (int i = 0; i < count; ++i) {
+            angle += turn(random);
+            pos += stroke::Vec2 {cosf(angle), sinf(angle)} * 8;
+            input.push_back(stroke::LinePoint {pos, width(random)});
+        }
+        smoother.smoothLinePoints(input, s.points);
+        for (auto &p : s.points) {
+            float r = p.width * .5f + 1;
+            s.bounds.add(stroke::Bounds {p.pos.x - r, p.pos.y - r, p.pos.x + r, p.pos.y + r});
+        }
+    }
+    return strokes;
+}
+
+//! draws a stroke the way TiledCanvas does with its history open: each tile copied before the first write,
+//! and the part of the stroke's bounds in it marked as written, as the scissor box does
+void drawStroke(PixelCanvas &canvas, stroke::TileHistory &history, const Stroke &s)
+{
+    std::vector<stroke::TileCoord> tiles;
+    canvas.getGrid().getOverlappingTiles(s.bounds, tiles);
+    const int size = canvas.getTilePixels();
+
+    history.beginEntry();
+    for (auto tile : tiles) {
+        bool created;
+        int slot = canvas.acquire(tile, created);
+        if (created)
+            history.addNewTile(tile);
+        else
+            history.addSnapshot(tile, canvas.getTile(slot), size);
+
+        auto tileBounds = canvas.getGrid().getTileBounds(tile);
+        int x0 = std::max(0, (int)floorf(s.bounds.minX - tileBounds.minX) - 1);
+        int y0 = std::max(0, (int)floorf(s.bounds.minY - tileBounds.minY) - 1);
+        int x1 = std::min(size, (int)ceilf(s.bounds.maxX - tileBounds.minX) + 1);
+        int y1 = std::min(size, (int)ceilf(s.bounds.maxY - tileBounds.minY) + 1);
+        history.addDirtyRect(tile, x0, y0, x1 - x0, y1 - y0);
+    }
+    canvas.stamp(s.points);
+    history.endEntry();
+}
+
+void restore(PixelCanvas &canvas, const stroke::HistoryEntry &entry, std::vector<uint32_t> &rect)
+{
+    const int size = canvas.getTilePixels();
+    for (auto &tile : entry.tiles) {
+        uint32_t *pixels = canvas.getTile(canvas.getGrid().find(tile.coord));
+        if (!tile.before) {
+            std::fill(pixels, pixels + size * size, Background);
+            continue;
+        }
+
+        rect.resize(tile.width * tile.height);
+        tile.before->restore(rect.data());
+        for (int row = 0; row < tile.height; ++row) {
+            std::copy_n(&rect[row * tile.width], tile.width, &pixels[(tile.y + row) * size + tile.x]);
+        }
+    }
+}
+
+double percentile(std::vector<double> sorted, double p)
+{
+    std::sort(sorted.begin(), sorted.end());
+    return sorted.empty() ? 0 : sorted[std::min(sorted.size() - 1, (size_t)(p * (sorted.size() - 1) + 0.5))];
+}
+
+//! Draws every stroke, then undoes as far as the history goes and redoes part of the way, checking the
+//! canvas against the hash it had after each of the last checked strokes.
+int runHistory(const char *name, const std::vector<Stroke> &strokes, size_t budget, size_t checked, bool report)
+{
+    PixelCanvas canvas;
+    stroke::TileHistory history;
+    history.setMemoryBudget(budget);
+
+    const size_t firstChecked = strokes.size() - std::min(checked, strokes.size());
+    std::vector<uint64_t> hashes(strokes.size() + 1);
+    hashes[0] = canvas.hash();
+    size_t tilePixels = 0;
+    double hashSeconds = 0;
+    auto start = bench::clock::now();
+    for (size_t k = 0; k < strokes.size(); ++k) {
+        drawStroke(canvas, history, strokes[k]);
+        if (k + 1 >= firstChecked) {
+            auto hashStart = bench::clock::now();
+            hashes[k + 1] = canvas.hash();
+            hashSeconds += bench::secondsSince(hashStart);
+        }
+    }
+    double drawSeconds = bench::secondsSince(start) - hashSeconds;
+    size_t historyBytes = history.getMemoryUsage();
+    size_t undoable = history.getUndoCount();
+
+    int failures = 0;
+    std::vector<double> undoMicros;
+    std::vector<uint32_t> rect;
+    for (size_t k = strokes.size(); history.canUndo() && k > firstChecked; --k) {
+        auto undoStart = bench::clock::now();
+        auto &entry = history.undo();
+        restore(canvas, entry, rect);
+        undoMicros.push_back(bench::secondsSince(undoStart) * 1e6);
+        for (auto &tile : entry.tiles) {
+            tilePixels += tile.before ? canvas.getTilePixels() * canvas.getTilePixels() : 0;
+        }
+
+        if (canvas.hash() != hashes[k - 1]) {
+            printf("  %-32s FAILED undoing stroke %zu does not restore the canvas\n", name, k);
+            return failures + 1;
+        }
+    }
+
+    //! redo is drawing the stroke again over the restored tiles
+    size_t first = strokes.size() - history.getRedoCount();
+    for (size_t k = first; k < std::min(strokes.size(), first + 100); ++k) {
+        history.redo();
+        canvas.stamp(strokes[k].points);
+        if (canvas.hash() != hashes[k + 1]) {
+            printf("  %-32s FAILED redoing stroke %zu does not match drawing it\n", name, k);
+            return failures + 1;
+        }
+    }
+
+    if (historyBytes > budget) {
+        printf("  %-32s FAILED history of %zu bytes over its budget of %zu\n", name, historyBytes, budget);
+        failures++;
+    }
+
+    bench::report(name, "undoable strokes", undoable, "");
+    bench::report(name, "evicted strokes", history.getEvictedCount(), "");
+    bench::report(name, "history", historyBytes / 1024.0, "KB");
+    bench::report(name, "history/stroke", (double)historyBytes / strokes.size(), "B");
+    if (report) {
+        const double windowBytes = 1024.0 * 768.0 * 4;
+        bench::report(name, "of full window copies", 100.0 * historyBytes / (windowBytes * strokes.size()), "%");
+        bench::report(name, "of raw tile copies", 100.0 * historyBytes / (tilePixels * 4.0), "%");
+        bench::report(name, "draw + snapshot/stroke", drawSeconds * 1e6 / strokes.size(), "us");
+        bench::report(name, "undo p50", percentile(undoMicros, 0.5), "us");
+        bench::report(name, "undo p99", percentile(undoMicros, 0.99), "us");
+        bench::report(name, "undo max", percentile(undoMicros, 1), "us");
+    }
+    return failures;
+}
+
+}
+
+int benchHistory(const bench::Options &)
+{
+    auto strokes = makeStrokes();
+    int failures = runHistory("1000 strokes", strokes, stroke::TileHistory::DefaultMemoryBudget, strokes.size(), true);
+
+    //! a small budget keeps the newest strokes undoable and drops the oldest
+    const size_t budget = 1 << 20;
+    failures += runHistory("1000 strokes, 1MB budget", strokes, budget, 200, false);
+    return failures;
+}
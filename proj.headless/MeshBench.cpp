@@ -0,0 +1,163 @@
+//
+//  MeshBench.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "Benchmarks.hpp"
+
+#include "MeshValidation.hpp"
+#include "Reference.hpp"
+#include "SyntheticStrokes.hpp"
+#include "Stroke/StrokeSmoother.hpp"
+#include "Stroke/StrokeTessellator.hpp"
+
+namespace {
+
+struct Corner {
+    float x, y;
+    float coverage;
+
+    bool operator==(const Corner &c) const { return x == c.x && y == c.y && coverage == c.coverage; }
+    bool operator!=(const Corner &c) const { return !(*this == c); }
+};
+
+//! the original vertices carry the brush color or transparent, the compact ones coverage 1 or 0
+void appendTriangles(const std::vector<reference::Vertex> &vertices, const unsigned short *indices, size_t indexCount, std::vector<Corner> &out)
+{
+    for (size_t i = 0; i < indexCount; ++i) {
+        auto &v = vertices[indices[i]];
+        out.push_back(Corner {v.x, v.y, v.color.a / 255.0f});
+    }
+}
+
+void appendTriangles(const std::vector<stroke::Vertex> &vertices, const unsigned short *indices, size_t indexCount, std::vector<Corner> &out)
+{
+    for (size_t i = 0; i < indexCount; ++i) {
+        auto &v = vertices[indices[i]];
+        out.push_back(Corner {v.x, v.y, v.coverage});
+    }
+}
+
+struct MeshTotals {
+    size_t vertices = 0;
+    size_t indices = 0;
+};
+
+//! smooths the stroke 4 input points per frame and hands every frame's polyline to draw.
+template <typename DrawFrame>
+void forEachFrame(const std::vector<stroke::LinePoint> &points, DrawFrame draw)
+{
+    stroke::StrokeSmoother smoother;
+    std::vector<stroke::LinePoint> pending {points[0], points[0], points[0]};
+    std::vector<stroke::LinePoint> smoothed;
+
+    for (size_t i = 1; i < points.size(); ++i) {
+        pending.push_back(points[i]);
+        bool last = i == points.size() - 1;
+        if (i % 4 == 0 || last) {
+            smoother.smoothLinePoints(pending, smoothed);
+            draw(smoothed, last);
+            pending.erase(pending.begin(), pending.end() - 2);
+        }
+    }
+}
+
+int runStroke(const char *name, const std::vector<stroke::LinePoint> &points, const bench::Options &options)
+{
+    const stroke::Color4F black {0, 0, 0, 1};
+    int failures = 0;
+
+    float length = 0;
+    for (size_t i = 1; i < points.size(); ++i) {
+        length += (points[i].pos - points[i - 1].pos).getLength();
+    }
+
+    reference::LineTessellator before;
+    stroke::StrokeTessellator after;
+    MeshTotals beforeTotals, afterTotals;
+    bool sameGeometry = true;
+    bool valid = true;
+
+    before.startNewLine();
+    after.startNewLine();
+    forEachFrame(points, [&] (std::vector<stroke::LinePoint> &smoothed, bool last) {
+        if (last) {
+            before.finishLine();
+            after.finishLine();
+        }
+        //! the original drawLines writes through a reference to linePoints[0], give it its own copy
+        std::vector<stroke::LinePoint> copy = smoothed;
+        before.drawLines(copy, black);
+        after.drawLines(smoothed);
+
+        beforeTotals.vertices += before.getVertices().size();
+        beforeTotals.indices += before.getIndices().size();
+        afterTotals.vertices += after.getMesh().getVertices().size();
+        afterTotals.indices += after.getMesh().getIndices().size();
+
+        std::vector<Corner> expected, actual;
+        appendTriangles(before.getVertices(), before.getIndices().data(), before.getIndices().size(), expected);
+        auto &mesh = after.getMesh();
+        for (auto &batch : mesh.getBatches()) {
+            std::vector<stroke::Vertex> batchVertices(mesh.getVertices().begin() + batch.vertexStart, mesh.getVertices().begin() + batch.vertexStart + batch.vertexCount);
+            appendTriangles(batchVertices, mesh.getIndices().data() + batch.indexStart, batch.indexCount, actual);
+        }
+        //! caps are sized by radius now, only the segment triangles in front of them still match the original
+        expected.resize(before.getCapIndexStart());
+        actual.resize(after.getCapIndexStart());
+        sameGeometry = sameGeometry && expected == actual;
+        valid = valid && validateMesh(mesh);
+    });
+
+    const double beforeVertexSize = sizeof(reference::Vertex), afterVertexSize = sizeof(stroke::Vertex);
+    bench::report(name, "stroke length", length, "pt");
+    bench::report(name, "before vertex bytes/pt", beforeTotals.vertices * beforeVertexSize / length, "");
+    bench::report(name, "after vertex bytes/pt", afterTotals.vertices * afterVertexSize / length, "");
+    bench::report(name, "before index bytes/pt", beforeTotals.indices * 2.0 / length, "");
+    bench::report(name, "after index bytes/pt", afterTotals.indices * 2.0 / length, "");
+    bench::report(name, "vertex reduction", (double)beforeTotals.vertices / afterTotals.vertices, "x");
+    bench::report(name, "vertex bytes reduction", beforeTotals.vertices * beforeVertexSize / (afterTotals.vertices * afterVertexSize), "x");
+
+    auto beforeTiming = bench::measure(options, [&] {
+        before.startNewLine();
+        forEachFrame(points, [&] (std::vector<stroke::LinePoint> &smoothed, bool last) {
+            if (last)
+                before.finishLine();
+            before.drawLines(smoothed, black);
+        });
+    });
+    auto afterTiming = bench::measure(options, [&] {
+        after.startNewLine();
+        forEachFrame(points, [&] (std::vector<stroke::LinePoint> &smoothed, bool last) {
+            if (last)
+                after.finishLine();
+            after.drawLines(smoothed);
+        });
+    });
+    bench::report(name, "before time", beforeTiming.microsPerIteration(), "us/stroke");
+    bench::report(name, "after time", afterTiming.microsPerIteration(), "us/stroke");
+
+    if (!sameGeometry) {
+        printf("  %-32s FAILED shared vertex mesh draws different triangles\n", name);
+        failures++;
+    }
+    if (!valid) {
+        printf("  %-32s FAILED mesh validation\n", name);
+        failures++;
+    }
+    return failures;
+}
+
+}
+
+int benchMesh(const bench::Options &options)
+{
+    int count = options.quick ? 200 : 2000;
+    int failures = 0;
+    failures += runStroke("spiral", synthetic::spiral(count), options);
+    failures += runStroke("scribble", synthetic::scribble(count), options);
+    return failures;
+}
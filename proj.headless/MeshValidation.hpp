@@ -0,0 +1,50 @@
+//
+//  MeshValidation.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef MeshValidation_hpp
+#define MeshValidation_hpp
+
+#include <cmath>
+#include "Stroke/StrokeMesh.hpp"
+
+//! A mesh is good when the batches tile the vertex and index buffers, stay within the batch limits,
+//! every index refers to a vertex of its own batch and every position is finite.
+inline bool validateMesh(const stroke::StrokeMesh &mesh,
+                         size_t maxBatchVertices = stroke::StrokeMesh::MaxBatchVertices,
+                         size_t maxBatchIndices = stroke::StrokeMesh::MaxBatchIndices)
+{
+    auto &vertices = mesh.getVertices();
+    auto &indices = mesh.getIndices();
+
+    size_t vertexEnd = 0, indexEnd = 0;
+    for (auto &batch : mesh.getBatches()) {
+        if (batch.vertexStart != vertexEnd || batch.indexStart != indexEnd)
+            return false;
+        if (batch.vertexCount > maxBatchVertices || batch.indexCount > maxBatchIndices || batch.indexCount % 3 != 0)
+            return false;
+
+        for (size_t i = batch.indexStart; i < batch.indexStart + batch.indexCount; ++i) {
+            if (indices[i] >= batch.vertexCount)
+                return false;
+        }
+        vertexEnd += batch.vertexCount;
+        indexEnd += batch.indexCount;
+    }
+    if (vertexEnd != vertices.size() || indexEnd != indices.size())
+        return false;
+
+    //! the bounds are the dirty rectangle LineDrawer scissors to, every vertex has to be inside
+    auto &bounds = mesh.getBounds();
+    for (auto &v : vertices) {
+        if (!std::isfinite(v.x) || !std::isfinite(v.y) || !bounds.contains(v.x, v.y))
+            return false;
+    }
+    return true;
+}
+
+#endif /* MeshValidation_hpp */
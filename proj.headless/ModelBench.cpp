@@ -0,0 +1,129 @@
+//
+//  ModelBench.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "Benchmarks.hpp"
+
+#include <random>
+#include "GestureTrace.hpp"
+#include "MeshValidation.hpp"
+#include "Stroke/StrokeRasterizer.hpp"
+
+namespace {
+
+//! a random walk over a large canvas, on both sides of the origin, must come back within half a step
+int checkQuantization()
+{
+    const char *name = "quantization";
+    std::mt19937 random(13);
+    std::uniform_real_distribution<float> step(-20, 20);
+    std::uniform_real_distribution<float> width(stroke::StrokePipeline::MinWidth, stroke::StrokePipeline::MaxWidth);
+
+    stroke::StrokeModel model;
+    std::vector<stroke::LinePoint> points;
+    stroke::Vec2 pos {-30000, 30000};
+    for (int s = 0; s < 20; ++s) {
+        model.beginStroke();
+        for (int i = 0; i < 500; ++i) {
+            pos += stroke::Vec2 {step(random), step(random)};
+            points.push_back(stroke::LinePoint {pos, width(random)});
+            model.addPoint(points.back());
+        }
+        model.endStroke();
+    }
+
+    float maxError = 0;
+    std::vector<stroke::LinePoint> decoded;
+    size_t next = 0;
+    for (size_t s = 0; s < model.getStrokeCount(); ++s) {
+        model.decode(s, decoded);
+        for (auto &point : decoded) {
+            auto &original = points[next++];
+            maxError = std::max(maxError, std::max(fabsf(point.pos.x - original.pos.x), fabsf(point.pos.y - original.pos.y)));
+            maxError = std::max(maxError, fabsf(point.width - original.width));
+        }
+    }
+
+    bench::report(name, "bytes/point", (double)model.getEncodedBytes() / model.getPointCount(), "B");
+    bench::report(name, "max error", maxError, "pt");
+
+    //! a float at 30000 is itself only good to about 0.002
+    if (next != points.size() || maxError > stroke::StrokeModel::QuantizationStep * .5f + 0.004f) {
+        printf("  %-32s FAILED %zu of %zu points decoded, error %f\n", name, next, points.size(), maxError);
+        return 1;
+    }
+    return 0;
+}
+
+int runGesture(const GestureTrace &trace, const bench::Options &options)
+{
+    const char *name = trace.name.c_str();
+    int failures = 0;
+
+    stroke::StrokeModel model;
+    stroke::PanTracker tracker;
+    stroke::StrokePipeline pipeline;
+    pipeline.setModel(&model);
+
+    GesturePlayer player {trace, tracker, pipeline};
+    size_t liveIndices = 0;
+    while (player.feedFrame()) {
+        if (pipeline.drawFrame())
+            liveIndices += pipeline.getMesh().getIndices().size();
+    }
+
+    bench::report(name, "strokes", model.getStrokeCount(), "");
+    bench::report(name, "bytes/point", (double)model.getEncodedBytes() / model.getPointCount(), "B");
+    bench::report(name, "of LinePoints", 100.0 * model.getEncodedBytes() / (model.getPointCount() * sizeof(stroke::LinePoint)), "%");
+
+    stroke::StrokeRasterizer rasterizer;
+    stroke::StrokeMesh mesh, zoomedMesh;
+    auto &bounds = model.getBounds();
+    rasterizer.rasterize(model, bounds, 1, mesh);
+
+    //! the whole document in one go comes out as the frames drew it, short of what quantization moved.
+    //! triangles rather than vertices: every live frame repeats the cross section it continues from
+    double triangleRatio = (double)mesh.getIndices().size() / liveIndices;
+    bench::report(name, "rasterized/live triangles", triangleRatio, "");
+    if (!validateMesh(mesh) || triangleRatio < 0.95 || triangleRatio > 1.05 || rasterizer.getStrokeCount() != model.getStrokeCount()) {
+        printf("  %-32s FAILED rasterized %zu strokes, %zu triangles against %zu live\n", name, rasterizer.getStrokeCount(), mesh.getIndices().size() / 3, liveIndices / 3);
+        failures++;
+    }
+
+    //! zoomed in, the ink is tessellated finer rather than magnified: same extent scaled, more vertices
+    const float zoom = 4;
+    rasterizer.rasterize(model, bounds, zoom, zoomedMesh);
+    auto &b1 = mesh.getBounds();
+    auto &b4 = zoomedMesh.getBounds();
+    float extentError = std::max(fabsf(b4.getWidth() - b1.getWidth() * zoom), fabsf(b4.getHeight() - b1.getHeight() * zoom));
+    bench::report(name, "vertices at 4x", (double)zoomedMesh.getVertices().size() / mesh.getVertices().size(), "x");
+    if (!validateMesh(zoomedMesh) || extentError > 0.01f * b4.getWidth() + 2 * zoom || zoomedMesh.getVertices().size() <= mesh.getVertices().size()) {
+        printf("  %-32s FAILED 4x rasterization is off by %.2f points or not finer\n", name, extentError);
+        failures++;
+    }
+
+    //! a region only tessellates the strokes over it
+    stroke::Bounds left {bounds.minX, bounds.minY, (bounds.minX + bounds.maxX) * .5f, bounds.maxY};
+    stroke::StrokeMesh regionMesh;
+    rasterizer.rasterize(model, left, 1, regionMesh);
+    bench::report(name, "strokes in left half", rasterizer.getStrokeCount(), "");
+
+    auto full = bench::measure(options, [&] { rasterizer.rasterize(model, bounds, 1, mesh); });
+    auto zoomed = bench::measure(options, [&] { rasterizer.rasterize(model, bounds, zoom, zoomedMesh); });
+    bench::report(name, "rasterize 1x", full.microsPerIteration(), "us");
+    bench::report(name, "rasterize 4x", zoomed.microsPerIteration(), "us");
+    return failures;
+}
+
+}
+
+int benchModel(const bench::Options &options)
+{
+    int failures = checkQuantization();
+    failures += forEachGesture(options, [&] (const GestureTrace &trace) { return runGesture(trace, options); });
+    return failures;
+}
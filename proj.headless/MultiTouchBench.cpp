@@ -0,0 +1,185 @@
+//
+//  MultiTouchBench.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "Benchmarks.hpp"
+
+#include <algorithm>
+#include <memory>
+#include "GestureTrace.hpp"
+#include "MeshValidation.hpp"
+#include "Stroke/TileGrid.hpp"
+
+namespace {
+
+using Strokes = std::vector<std::vector<stroke::LinePoint>>;
+
+bool lessPoints(const std::vector<stroke::LinePoint> &a, const std::vector<stroke::LinePoint> &b)
+{
+    return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), [] (const stroke::LinePoint &p, const stroke::LinePoint &q) {
+        if (p.pos.x != q.pos.x)
+            return p.pos.x < q.pos.x;
+        if (p.pos.y != q.pos.y)
+            return p.pos.y < q.pos.y;
+        return p.width < q.width;
+    });
+}
+
+bool samePoints(const std::vector<stroke::LinePoint> &a, const std::vector<stroke::LinePoint> &b)
+{
+    return !lessPoints(a, b) && !lessPoints(b, a);
+}
+
+void appendStrokes(const stroke::StrokeModel &model, Strokes &strokes)
+{
+    for (size_t s = 0; s < model.getStrokeCount(); ++s) {
+        strokes.emplace_back();
+        model.decode(s, strokes.back());
+    }
+}
+
+struct Finger {
+    stroke::PanTracker tracker;
+    stroke::StrokePipeline pipeline;
+    std::unique_ptr<GesturePlayer> player;
+    bool more = true;
+};
+
+struct MultiTouchTotals {
+    size_t frames = 0;
+    size_t drawnFrames = 0;
+    //! meshes the pipelines drew, one draw each without the combined mesh
+    size_t strokeMeshes = 0;
+    //! tile passes of the combined mesh, and what routing it by its bounds would take
+    size_t tilePasses = 0;
+    size_t boundsTilePasses = 0;
+    //! frames whose combined mesh went to other tiles than its fingers' meshes do
+    size_t misrouted = 0;
+    bool valid = true;
+};
+
+bool lessTile(const stroke::TileCover &a, const stroke::TileCover &b)
+{
+    return a.tile.y != b.tile.y ? a.tile.y < b.tile.y : a.tile.x < b.tile.x;
+}
+
+//! Every trace at once, one finger each, into one model the way LineDrawer records them: each frame every
+//! finger's pipeline draws, and the meshes are appended into the one the canvas would draw, which is
+//! routed to the tiles of every finger's triangles and no others.
+void play(const std::vector<GestureTrace> &traces, stroke::StrokeModel &model, stroke::StrokeMesh &frameMesh, MultiTouchTotals &totals)
+{
+    stroke::TileGrid grid;
+    std::vector<stroke::TileCover> covers, fingerCovers;
+    std::vector<stroke::TileCoord> overlapping;
+    std::vector<std::unique_ptr<Finger>> fingers;
+    for (auto &trace : traces) {
+        fingers.emplace_back(new Finger);
+        auto &finger = *fingers.back();
+        finger.pipeline.setModel(&model);
+        finger.player.reset(new GesturePlayer {trace, finger.tracker, finger.pipeline});
+    }
+
+    for (bool more = true; more; ) {
+        more = false;
+        frameMesh.clear();
+        fingerCovers.clear();
+        size_t vertices = 0;
+        for (auto &finger : fingers) {
+            if (finger->more)
+                finger->more = finger->player->feedFrame();
+            more = more || finger->more;
+            if (finger->pipeline.drawFrame()) {
+                frameMesh.append(finger->pipeline.getMesh());
+                grid.getMeshTiles(finger->pipeline.getMesh(), fingerCovers);
+                totals.strokeMeshes++;
+                vertices += finger->pipeline.getMesh().getVertices().size();
+            }
+        }
+        totals.frames++;
+        if (!frameMesh.empty()) {
+            totals.drawnFrames++;
+            totals.valid = totals.valid && validateMesh(frameMesh) && frameMesh.getVertices().size() == vertices;
+
+            covers.clear();
+            grid.getMeshTiles(frameMesh, covers);
+            std::sort(fingerCovers.begin(), fingerCovers.end(), lessTile);
+            auto end = std::unique(fingerCovers.begin(), fingerCovers.end(), [] (const stroke::TileCover &a, const stroke::TileCover &b) { return a.tile == b.tile; });
+            fingerCovers.erase(end, fingerCovers.end());
+            bool same = covers.size() == fingerCovers.size() && std::equal(covers.begin(), covers.end(), fingerCovers.begin(), [] (const stroke::TileCover &a, const stroke::TileCover &b) { return a.tile == b.tile; });
+            if (!same)
+                totals.misrouted++;
+
+            overlapping.clear();
+            grid.getOverlappingTiles(frameMesh.getBounds(), overlapping);
+            totals.tilePasses += covers.size();
+            totals.boundsTilePasses += overlapping.size();
+        }
+    }
+}
+
+}
+
+int benchMultiTouch(const bench::Options &options)
+{
+    const char *name = "all gestures at once";
+    int failures = 0;
+
+    std::vector<GestureTrace> traces;
+    if (!loadGestureCorpus(options, traces))
+        return 1;
+
+    //! each trace drawn alone records the strokes the fingers together should
+    Strokes expected;
+    for (auto &trace : traces) {
+        stroke::StrokeModel model;
+        stroke::PanTracker tracker;
+        stroke::StrokePipeline pipeline;
+        pipeline.setModel(&model);
+        GesturePlayer player {trace, tracker, pipeline};
+        while (player.feedFrame()) {
+            pipeline.drawFrame();
+        }
+        appendStrokes(model, expected);
+    }
+
+    stroke::StrokeModel model;
+    stroke::StrokeMesh frameMesh;
+    MultiTouchTotals totals;
+    auto start = bench::clock::now();
+    play(traces, model, frameMesh, totals);
+    double seconds = bench::secondsSince(start);
+
+    if (model.isStrokeOpen()) {
+        printf("  %-32s FAILED a stroke was left open\n", name);
+        failures++;
+    }
+    //! strokes interleave in the shared model in the order the fingers began them
+    Strokes recorded;
+    appendStrokes(model, recorded);
+    std::sort(expected.begin(), expected.end(), lessPoints);
+    std::sort(recorded.begin(), recorded.end(), lessPoints);
+    if (recorded.size() != expected.size() || !std::equal(recorded.begin(), recorded.end(), expected.begin(), samePoints)) {
+        printf("  %-32s FAILED %zu strokes recorded, %zu drawn alone, or their points differ\n", name, recorded.size(), expected.size());
+        failures++;
+    }
+    if (totals.misrouted != 0) {
+        printf("  %-32s FAILED %zu frames drawn into other tiles than their fingers' ink\n", name, totals.misrouted);
+        failures++;
+    }
+    if (!totals.valid) {
+        printf("  %-32s FAILED mesh validation\n", name);
+        failures++;
+    }
+
+    bench::report(name, "fingers", traces.size(), "");
+    bench::report(name, "strokes", model.getStrokeCount(), "");
+    bench::report(name, "frame mean", seconds * 1e6 / totals.frames, "us");
+    bench::report(name, "meshes per drawn frame", totals.drawnFrames ? (double)totals.strokeMeshes / totals.drawnFrames : 0, "");
+    bench::report(name, "tile passes/frame", totals.drawnFrames ? (double)totals.tilePasses / totals.drawnFrames : 0, "");
+    bench::report(name, "by bounds/frame", totals.drawnFrames ? (double)totals.boundsTilePasses / totals.drawnFrames : 0, "");
+    return failures;
+}
@@ -0,0 +1,308 @@
+//
+//  OverlayBench.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "Benchmarks.hpp"
+
+#include <algorithm>
+#include <string.h>
+#include "GestureTrace.hpp"
+#include "MeshValidation.hpp"
+#include "SyntheticStrokes.hpp"
+#include "Stroke/MeshUpload.hpp"
+#include "Stroke/SoftwareRenderer.hpp"
+#include "Stroke/TileGrid.hpp"
+
+namespace {
+
+//! half transparent, so ink blended twice where pieces of a stroke overlap shows
+const stroke::Color4F Ink {0, 0, 0, .5f};
+const stroke::Color4F Paper {1, 1, 1, 1};
+
+//! The vertex and index buffers StrokeRenderer keeps for the live stroke, on the CPU: what each frame
+//! uploads, against what uploading the whole mesh would, and whether the buffers end up holding the mesh.
+struct OverlayBuffers {
+    stroke::MeshUpload upload;
+    std::vector<stroke::Vertex> vertices;
+    std::vector<unsigned short> indices;
+    //! what the buffers hold, of the mesh generation last drawn
+    size_t generation = 0;
+    size_t vertexCount = 0, indexCount = 0;
+    size_t uploadBytes = 0;
+    size_t meshBytes = 0;
+    size_t frames = 0;
+
+    void draw(const stroke::StrokeMesh &mesh)
+    {
+        upload.update(mesh);
+        uploadRange(upload.isVertexBufferResized(), upload.getVertexCapacity(), upload.getVertexRange(), mesh.getVertices(), vertices);
+        uploadRange(upload.isIndexBufferResized(), upload.getIndexCapacity(), upload.getIndexRange(), mesh.getIndices(), indices);
+        generation = mesh.getGeneration();
+        vertexCount = mesh.getVertices().size();
+        indexCount = mesh.getIndices().size();
+        uploadBytes += upload.getUploadBytes();
+        meshBytes += vertexCount * sizeof(stroke::Vertex) + indexCount * sizeof(unsigned short);
+        frames++;
+    }
+
+    //! whether the buffers hold what was last drawn of mesh, which has only grown since; a stroke that ended
+    //! before its first overlay frame has nothing in them
+    bool holds(const stroke::StrokeMesh &mesh) const
+    {
+        if (mesh.getGeneration() != generation)
+            return true;
+        return std::equal(vertices.begin(), vertices.begin() + vertexCount, mesh.getVertices().begin(), [] (const stroke::Vertex &a, const stroke::Vertex &b) {
+                return a.x == b.x && a.y == b.y && a.coverage == b.coverage;
+            })
+            && std::equal(indices.begin(), indices.begin() + indexCount, mesh.getIndices().begin());
+    }
+
+    //! A reallocated buffer is filled with all ones, NaN vertices and an index past any batch, as glBufferData()
+    //! without data leaves it undefined: a range that wasn't uploaded can't match the mesh by chance.
+    template <typename T>
+    static void uploadRange(bool resized, size_t capacity, const stroke::MeshUpload::Range &range, const std::vector<T> &data, std::vector<T> &buffer)
+    {
+        if (resized) {
+            buffer.resize(capacity);
+            memset(buffer.data(), 0xff, capacity * sizeof(T));
+        }
+        std::copy(data.begin() + range.start, data.begin() + range.start + range.count, buffer.begin() + range.start);
+    }
+};
+
+struct OverlayTotals {
+    std::vector<double> frameMicros;
+    //! what ends up in the canvas
+    stroke::StrokeMesh ink;
+    size_t committedStrokes = 0;
+    //! tile render passes the canvas would queue for the ink, and routing it by bounds would
+    size_t tilePasses = 0;
+    size_t boundsTilePasses = 0;
+    //! the bounds of the live stroke drawn over the canvas, summed over the frames
+    double overlayArea = 0;
+    size_t overlayFrames = 0;
+    OverlayBuffers buffers;
+    bool valid = true;
+};
+
+//! Replays trace at 60 Hz as LineDrawer draws it. Incrementally every frame's mesh goes into the canvas;
+//! retained the stroke is drawn whole over it every frame, and into it on the frame it ends.
+void replay(const GestureTrace &trace, bool retain, OverlayTotals &totals)
+{
+    stroke::PanTracker tracker;
+    stroke::StrokePipeline pipeline;
+    pipeline.setRetainStroke(retain);
+    GesturePlayer player {trace, tracker, pipeline};
+
+    stroke::TileGrid grid;
+    std::vector<stroke::TileCover> covers;
+    std::vector<stroke::TileCoord> tiles;
+    auto commit = [&] (const stroke::StrokeMesh &mesh) {
+        totals.ink.append(mesh);
+        covers.clear();
+        grid.getMeshTiles(mesh, covers);
+        totals.tilePasses += covers.size();
+        tiles.clear();
+        grid.getOverlappingTiles(mesh.getBounds(), tiles);
+        totals.boundsTilePasses += tiles.size();
+    };
+
+    bool completed = false;
+    for (bool more = true; more; ) {
+        auto start = bench::clock::now();
+        more = player.feedFrame();
+        bool drawn = pipeline.drawFrame();
+        totals.frameMicros.push_back(bench::secondsSince(start) * 1e6);
+
+        //! the stroke stays Completed until the next one begins
+        bool ending = tracker.getState() == stroke::PanTracker::Completed && !completed;
+        completed = tracker.getState() == stroke::PanTracker::Completed;
+
+        auto &mesh = pipeline.getMesh();
+        if (!retain) {
+            if (drawn)
+                commit(mesh);
+        }
+        else if (ending) {
+            totals.valid = totals.valid && validateMesh(mesh) && totals.buffers.holds(mesh);
+            commit(mesh);
+            totals.committedStrokes++;
+        }
+        else if (!completed && !mesh.empty()) {
+            totals.overlayArea += mesh.getBounds().getArea();
+            totals.overlayFrames++;
+            totals.buffers.draw(mesh);
+        }
+    }
+}
+
+stroke::Image render(const stroke::StrokeMesh &mesh, const stroke::Bounds &bounds)
+{
+    stroke::Vec2 origin {floorf(bounds.minX), floorf(bounds.minY)};
+    stroke::Image image {(int)ceilf(bounds.maxX - origin.x), (int)ceilf(bounds.maxY - origin.y)};
+    image.clear(Paper);
+    stroke::SoftwareRenderer renderer {1};
+    renderer.draw(image, mesh, Ink, origin);
+    return image;
+}
+
+//! pixels differing by more than 2/255, as a share of the pixels either image has ink in
+double differingPixels(const stroke::Image &a, const stroke::Image &b)
+{
+    size_t differing = 0, inked = 0;
+    for (size_t i = 0; i < a.pixels.size(); ++i) {
+        int difference = 0;
+        for (int ch = 0; ch < 3; ++ch) {
+            difference = std::max(difference, abs(stroke::Image::channel(a.pixels[i], ch) - stroke::Image::channel(b.pixels[i], ch)));
+        }
+        differing += difference > 2;
+        inked += stroke::Image::channel(a.pixels[i], 0) < 255 || stroke::Image::channel(b.pixels[i], 0) < 255;
+    }
+    return inked ? 100.0 * differing / inked : 0;
+}
+
+double mean(const std::vector<double> &values)
+{
+    double sum = 0;
+    for (auto value : values) {
+        sum += value;
+    }
+    return values.empty() ? 0 : sum / values.size();
+}
+
+double percentile(std::vector<double> values, double p)
+{
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, (size_t)(p * (values.size() - 1) + 0.5))];
+}
+
+int runGesture(const GestureTrace &trace)
+{
+    const char *name = trace.name.c_str();
+    int failures = 0;
+
+    OverlayTotals incremental, retained;
+    replay(trace, false, incremental);
+    replay(trace, true, retained);
+
+    stroke::Bounds bounds = incremental.ink.getBounds();
+    bounds.add(retained.ink.getBounds());
+    double differing = differingPixels(render(incremental.ink, bounds), render(retained.ink, bounds));
+
+    bench::report(name, "incremental frame mean", mean(incremental.frameMicros), "us");
+    bench::report(name, "retained frame mean", mean(retained.frameMicros), "us");
+    bench::report(name, "retained frame p99", percentile(retained.frameMicros, 0.99), "us");
+    bench::report(name, "overlay bounds mean", retained.overlayFrames ? retained.overlayArea / retained.overlayFrames : 0, "pt2");
+    auto &buffers = retained.buffers;
+    bench::report(name, "upload/overlay frame", buffers.frames ? (double)buffers.uploadBytes / buffers.frames : 0, "B");
+    bench::report(name, "whole mesh/frame", buffers.frames ? (double)buffers.meshBytes / buffers.frames : 0, "B");
+    bench::report(name, "incremental tile passes", incremental.tilePasses, "");
+    bench::report(name, "retained tile passes", retained.tilePasses, "");
+    bench::report(name, "by bounds", retained.boundsTilePasses, "");
+    bench::report(name, "ink differing", differing, "%");
+
+    //! the canvas ends up with the same ink either way
+    if (!retained.valid || retained.committedStrokes != trace.getStrokeCount() || differing > 0.1) {
+        printf("  %-32s FAILED %zu of %zu strokes committed, %.2f%% of the ink differs from frame by frame, or the overlay buffers don't hold the stroke\n", name, retained.committedStrokes, trace.getStrokeCount(), differing);
+        failures++;
+    }
+    return failures;
+}
+
+//! A stroke far longer than the recorded ones, retained: a frame smooths and tessellates the points that came
+//! in since the last one however long the stroke already is, so its last frames cost what its first did, and
+//! uploads what they added to the overlay's buffers.
+int runLongStroke(int count, int pointsPerFrame)
+{
+    const char *name = "long spiral, retained";
+    auto points = synthetic::spiral(count);
+
+    stroke::FrameProfiler profiler;
+    stroke::StrokePipeline retained, incremental;
+    retained.setRetainStroke(true);
+    retained.setProfiler(&profiler);
+    stroke::StrokeMesh ink;
+
+    OverlayBuffers buffers;
+    std::vector<double> frameMicros;
+    std::vector<size_t> frameUploads;
+    size_t maxFramePoints = 0;
+    for (auto pipeline : {&retained, &incremental}) {
+        pipeline->startNewLine(points[0].pos, points[0].width);
+        pipeline->addPoint(points[0].pos, points[0].width);
+        pipeline->addPoint(points[0].pos, points[0].width);
+    }
+    for (size_t i = 1; i < points.size(); ++i) {
+        for (auto pipeline : {&retained, &incremental}) {
+            if (i == points.size() - 1)
+                pipeline->endLine(points[i].pos, points[i].width);
+            else
+                pipeline->addPoint(points[i].pos, points[i].width);
+        }
+        if (i % pointsPerFrame != 0 && i != points.size() - 1)
+            continue;
+
+        profiler.beginFrame();
+        auto start = bench::clock::now();
+        retained.drawFrame();
+        frameMicros.push_back(bench::secondsSince(start) * 1e6);
+        profiler.endFrame();
+        maxFramePoints = std::max(maxFramePoints, profiler.getLastFrame().rawPoints);
+        buffers.draw(retained.getMesh());
+        frameUploads.push_back(buffers.upload.getUploadBytes());
+
+        if (incremental.drawFrame())
+            ink.append(incremental.getMesh());
+    }
+
+    size_t tenth = std::max<size_t>(1, frameMicros.size() / 10);
+    double first = mean(std::vector<double>(frameMicros.begin(), frameMicros.begin() + tenth));
+    double last = mean(std::vector<double>(frameMicros.end() - tenth, frameMicros.end()));
+    auto &mesh = retained.getMesh();
+    size_t meshBytes = mesh.getVertices().size() * sizeof(stroke::Vertex) + mesh.getIndices().size() * sizeof(unsigned short);
+    std::sort(frameUploads.begin(), frameUploads.end());
+
+    bench::report(name, "points", points.size(), "");
+    bench::report(name, "first tenth mean", first, "us");
+    bench::report(name, "last tenth mean", last, "us");
+    bench::report(name, "max points/frame", maxFramePoints, "");
+    bench::report(name, "stroke vertices", mesh.getVertices().size(), "");
+    bench::report(name, "upload/frame", (double)buffers.uploadBytes / buffers.frames, "B");
+    bench::report(name, "median upload/frame", frameUploads[frameUploads.size() / 2], "B");
+    bench::report(name, "whole mesh/frame", (double)buffers.meshBytes / buffers.frames, "B");
+
+    int failures = 0;
+    //! the frame's own points and the two kept to continue from, or on the first frame the start point three times
+    if (maxFramePoints > (size_t)pointsPerFrame + 3) {
+        printf("  %-32s FAILED a frame smoothed %zu points for %d new ones\n", name, maxFramePoints, pointsPerFrame);
+        failures++;
+    }
+    //! the stroke mesh is the frames' pieces joined, the ink the canvas would have had frame by frame
+    bool same = mesh.getVertices().size() == ink.getVertices().size() && mesh.getIndices().size() == ink.getIndices().size()
+        && std::equal(mesh.getVertices().begin(), mesh.getVertices().end(), ink.getVertices().begin(), [] (const stroke::Vertex &a, const stroke::Vertex &b) {
+            return a.x == b.x && a.y == b.y && a.coverage == b.coverage;
+        });
+    if (!same || !validateMesh(mesh)) {
+        printf("  %-32s FAILED the stroke mesh differs from its frames' meshes joined\n", name);
+        failures++;
+    }
+    //! the appended pieces once, and the buffers' doublings at most twice more
+    if (!buffers.holds(mesh) || buffers.uploadBytes > 3 * meshBytes) {
+        printf("  %-32s FAILED %zu bytes uploaded for a %zu byte mesh, or the buffers don't hold it\n", name, buffers.uploadBytes, meshBytes);
+        failures++;
+    }
+    return failures;
+}
+
+}
+
+int benchOverlay(const bench::Options &options)
+{
+    int failures = forEachGesture(options, [&] (const GestureTrace &trace) { return runGesture(trace); });
+    failures += runLongStroke(options.quick ? 20000 : 100000, 4);
+    return failures;
+}
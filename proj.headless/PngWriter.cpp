@@ -0,0 +1,351 @@
+//
+//  PngWriter.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "PngWriter.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+namespace {
+
+const int HashSize = 1 << 15;
+//! candidates tried per position: longer chains buy little on line art
+const int MaxChain = 32;
+
+const int LengthBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+const int LengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+const int DistanceBase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+const int DistanceExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+const uint8_t Signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+
+uint32_t crc32(uint32_t crc, const uint8_t *data, size_t size)
+{
+    static const std::vector<uint32_t> table = [] {
+        std::vector<uint32_t> t(256);
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) {
+                c = c & 1 ? 0xedb88320u ^ (c >> 1) : c >> 1;
+            }
+            t[n] = c;
+        }
+        return t;
+    }();
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+void putBigEndian(uint8_t *out, uint32_t value)
+{
+    out[0] = (uint8_t)(value >> 24);
+    out[1] = (uint8_t)(value >> 16);
+    out[2] = (uint8_t)(value >> 8);
+    out[3] = (uint8_t)value;
+}
+
+int hash3(const uint8_t *p)
+{
+    return ((p[0] << 10) ^ (p[1] << 5) ^ p[2]) & (HashSize - 1);
+}
+
+uint8_t paeth(int a, int b, int c)
+{
+    int p = a + b - c;
+    int pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+    return (uint8_t)(pa <= pb && pa <= pc ? a : pb <= pc ? b : c);
+}
+
+}
+
+PngWriter::PngWriter(FILE *file, int width, int height, bool alpha)
+: _file(file), _width(width), _height(height), _channels(alpha ? 4 : 3), _ok(true), _rows(0), _deflater(*this)
+{
+    size_t stride = (size_t)width * _channels;
+    _previous.assign(stride, 0);
+    _current.resize(stride);
+    _filtered.resize(stride);
+    _best.resize(stride);
+
+    _ok = fwrite(Signature, 1, sizeof(Signature), _file) == sizeof(Signature);
+
+    //! 8 bits per channel, truecolor with or without alpha, deflate, adaptive filtering, not interlaced
+    uint8_t header[13];
+    putBigEndian(header, (uint32_t)width);
+    putBigEndian(header + 4, (uint32_t)height);
+    header[8] = 8;
+    header[9] = alpha ? 6 : 2;
+    header[10] = header[11] = header[12] = 0;
+    writeChunk("IHDR", header, sizeof(header));
+}
+
+void PngWriter::writeRow(const uint32_t *pixels)
+{
+    for (int x = 0; x < _width; ++x) {
+        for (int c = 0; c < _channels; ++c) {
+            _current[x * _channels + c] = (uint8_t)(pixels[x] >> (8 * c));
+        }
+    }
+
+    //! the filter with the smallest sum of residuals read as signed bytes, the usual heuristic
+    const size_t stride = _current.size();
+    const size_t bpp = _channels;
+    const uint8_t *x = _current.data();
+    const uint8_t *up = _previous.data();
+    long bestScore = -1;
+    uint8_t bestFilter = 0;
+    for (uint8_t filter = 0; filter <= 4; ++filter) {
+        uint8_t *out = _filtered.data();
+        switch (filter) {
+            case 0:
+                memcpy(out, x, stride);
+                break;
+            case 1:
+                memcpy(out, x, bpp);
+                for (size_t i = bpp; i < stride; ++i) out[i] = (uint8_t)(x[i] - x[i - bpp]);
+                break;
+            case 2:
+                for (size_t i = 0; i < stride; ++i) out[i] = (uint8_t)(x[i] - up[i]);
+                break;
+            case 3:
+                for (size_t i = 0; i < bpp; ++i) out[i] = (uint8_t)(x[i] - up[i] / 2);
+                for (size_t i = bpp; i < stride; ++i) out[i] = (uint8_t)(x[i] - (x[i - bpp] + up[i]) / 2);
+                break;
+            default:
+                for (size_t i = 0; i < bpp; ++i) out[i] = (uint8_t)(x[i] - up[i]);
+                for (size_t i = bpp; i < stride; ++i) out[i] = (uint8_t)(x[i] - paeth(x[i - bpp], up[i], up[i - bpp]));
+                break;
+        }
+
+        long score = 0;
+        for (size_t i = 0; i < stride; ++i) {
+            score += abs((int8_t)out[i]);
+        }
+        if (bestScore < 0 || score < bestScore) {
+            bestScore = score;
+            bestFilter = filter;
+            _best.swap(_filtered);
+        }
+    }
+
+    _deflater.write(&bestFilter, 1);
+    _deflater.write(_best.data(), stride);
+    _previous.swap(_current);
+    _rows++;
+}
+
+bool PngWriter::finish()
+{
+    _deflater.finish();
+    flushChunk();
+    writeChunk("IEND", nullptr, 0);
+    return _ok && _rows == _height;
+}
+
+void PngWriter::writeChunk(const char *type, const uint8_t *data, size_t size)
+{
+    uint8_t length[4], crc[4];
+    putBigEndian(length, (uint32_t)size);
+    uint32_t checksum = crc32(0, reinterpret_cast<const uint8_t *>(type), 4);
+    checksum = crc32(checksum, data, size);
+    putBigEndian(crc, checksum);
+
+    _ok = _ok && fwrite(length, 1, 4, _file) == 4 && fwrite(type, 1, 4, _file) == 4
+        && (size == 0 || fwrite(data, 1, size, _file) == size) && fwrite(crc, 1, 4, _file) == 4;
+}
+
+void PngWriter::emit(uint8_t byte)
+{
+    _chunk.push_back(byte);
+    if (_chunk.size() >= ChunkSize)
+        flushChunk();
+}
+
+void PngWriter::flushChunk()
+{
+    if (_chunk.empty())
+        return;
+    writeChunk("IDAT", _chunk.data(), _chunk.size());
+    _chunk.clear();
+}
+
+PngWriter::Deflater::Deflater(PngWriter &png)
+: _png(png), _buffer(2 * WindowSize), _position(0), _end(0), _head(HashSize, -1), _prev(WindowSize, -1), _bits(0), _bitCount(0), _adler {1, 0}
+{
+    //! zlib header: deflate with a 32K window, no preset dictionary, check bits
+    _png.emit(0x78);
+    _png.emit(0x01);
+
+    //! the whole image is one fixed Huffman block, closed by an empty final one
+    writeBits(0, 1);
+    writeBits(1, 2);
+}
+
+void PngWriter::Deflater::write(const uint8_t *data, size_t size)
+{
+    while (size > 0) {
+        size_t n = std::min(size, _buffer.size() - _end);
+        memcpy(&_buffer[_end], data, n);
+
+        //! Adler-32, reduced often enough not to overflow
+        for (size_t i = 0; i < n; ) {
+            size_t block = std::min(n - i, (size_t)5552);
+            for (size_t j = 0; j < block; ++j) {
+                _adler[0] += data[i + j];
+                _adler[1] += _adler[0];
+            }
+            _adler[0] %= 65521;
+            _adler[1] %= 65521;
+            i += block;
+        }
+
+        _end += (int)n;
+        data += n;
+        size -= n;
+
+        if (_end == (int)_buffer.size()) {
+            compress(false);
+            slide();
+        }
+    }
+}
+
+void PngWriter::Deflater::finish()
+{
+    compress(true);
+    writeCode(0, 7);
+
+    writeBits(1, 1);
+    writeBits(1, 2);
+    writeCode(0, 7);
+    if (_bitCount > 0)
+        writeBits(0, 8 - _bitCount);
+
+    uint8_t adler[4];
+    putBigEndian(adler, _adler[1] << 16 | _adler[0]);
+    for (auto byte : adler) {
+        _png.emit(byte);
+    }
+}
+
+void PngWriter::Deflater::insert(int position)
+{
+    if (position + MinMatch > _end)
+        return;
+    int h = hash3(&_buffer[position]);
+    _prev[position & (WindowSize - 1)] = _head[h];
+    _head[h] = position;
+}
+
+//! without flush, stops a longest match short of the end, so that every match is as long as it can be
+void PngWriter::Deflater::compress(bool flush)
+{
+    const int limit = flush ? _end : _end - MaxMatch;
+    while (_position < limit) {
+        int bestLength = 0, bestDistance = 0;
+        const int maxLength = std::min(MaxMatch, _end - _position);
+        if (maxLength >= MinMatch) {
+            const uint8_t *current = &_buffer[_position];
+            int candidate = _head[hash3(current)];
+            for (int chain = 0; candidate >= 0 && _position - candidate <= WindowSize && chain < MaxChain; ++chain) {
+                const uint8_t *match = &_buffer[candidate];
+                if (match[bestLength] == current[bestLength]) {
+                    int length = 0;
+                    while (length < maxLength && match[length] == current[length])
+                        length++;
+                    if (length > bestLength) {
+                        bestLength = length;
+                        bestDistance = _position - candidate;
+                        if (length == maxLength)
+                            break;
+                    }
+                }
+                int next = _prev[candidate & (WindowSize - 1)];
+                if (next >= candidate)
+                    break;
+                candidate = next;
+            }
+        }
+
+        if (bestLength >= MinMatch) {
+            writeMatch(bestLength, bestDistance);
+            for (int i = 0; i < bestLength; ++i) {
+                insert(_position + i);
+            }
+            _position += bestLength;
+        }
+        else {
+            writeLiteral(_buffer[_position]);
+            insert(_position);
+            _position++;
+        }
+    }
+}
+
+//! drops the oldest window; positions move by exactly the window size, so the chains stay indexed right
+void PngWriter::Deflater::slide()
+{
+    memmove(&_buffer[0], &_buffer[WindowSize], _end - WindowSize);
+    _position -= WindowSize;
+    _end -= WindowSize;
+    for (auto &p : _head) {
+        p = p >= WindowSize ? p - WindowSize : -1;
+    }
+    for (auto &p : _prev) {
+        p = p >= WindowSize ? p - WindowSize : -1;
+    }
+}
+
+void PngWriter::Deflater::writeBits(uint32_t bits, int count)
+{
+    _bits |= bits << _bitCount;
+    _bitCount += count;
+    while (_bitCount >= 8) {
+        _png.emit((uint8_t)_bits);
+        _bits >>= 8;
+        _bitCount -= 8;
+    }
+}
+
+//! Huffman codes go most significant bit first
+void PngWriter::Deflater::writeCode(uint32_t code, int length)
+{
+    uint32_t reversed = 0;
+    for (int i = 0; i < length; ++i) {
+        reversed = reversed << 1 | ((code >> i) & 1);
+    }
+    writeBits(reversed, length);
+}
+
+void PngWriter::Deflater::writeLiteral(int literal)
+{
+    if (literal < 144)
+        writeCode(0x30 + literal, 8);
+    else
+        writeCode(0x190 + literal - 144, 9);
+}
+
+void PngWriter::Deflater::writeMatch(int length, int distance)
+{
+    int l = (int)(std::upper_bound(LengthBase, LengthBase + 29, length) - LengthBase) - 1;
+    int symbol = 257 + l;
+    if (symbol < 280)
+        writeCode(symbol - 256, 7);
+    else
+        writeCode(0xc0 + symbol - 280, 8);
+    writeBits(length - LengthBase[l], LengthExtra[l]);
+
+    int d = (int)(std::upper_bound(DistanceBase, DistanceBase + 30, distance) - DistanceBase) - 1;
+    writeCode(d, 5);
+    writeBits(distance - DistanceBase[d], DistanceExtra[d]);
+}
@@ -0,0 +1,91 @@
+//
+//  PngWriter.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef PngWriter_hpp
+#define PngWriter_hpp
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+//! Streaming PNG encoder: rows go in one at a time and leave as IDAT chunks once a chunk's worth of
+//! compressed data has built up, so neither the filtered image nor the file is ever held whole.
+//! Each row takes whichever PNG filter leaves the smallest residuals, and the zlib stream is deflated
+//! with LZ77 and the fixed Huffman codes: no dependency, and line art on a plain background compresses
+//! to a few percent of its pixels.
+class PngWriter {
+
+public:
+    //! bytes of compressed data per IDAT chunk
+    static const size_t ChunkSize = 1 << 16;
+
+public:
+    //! Starts a width by height image on file, which the caller opens and closes. With alpha the
+    //! pixels are written as RGBA, otherwise the alpha channel is dropped.
+    PngWriter (FILE *file, int width, int height, bool alpha);
+
+    //! appends the next row, top first, as RGBA8888 with straight (not premultiplied) alpha.
+    void writeRow(const uint32_t *pixels);
+
+    //! writes what is left of the image; false if a write to the file failed at any point.
+    bool finish();
+
+private:
+    //! LZ77 over a sliding window of the filtered rows, emitted as one fixed Huffman block
+    class Deflater {
+
+    public:
+        static const int WindowSize = 1 << 15;
+        static const int MinMatch = 3;
+        static const int MaxMatch = 258;
+
+    public:
+        explicit Deflater (PngWriter &png);
+
+        void write(const uint8_t *data, size_t size);
+        void finish();
+
+    private:
+        void compress(bool flush);
+        void insert(int position);
+        void writeBits(uint32_t bits, int count);
+        void writeCode(uint32_t code, int length);
+        void writeLiteral(int literal);
+        void writeMatch(int length, int distance);
+        void slide();
+
+    private:
+        PngWriter &_png;
+        std::vector<uint8_t> _buffer;
+        //! the buffer holds history before _position and lookahead up to _end
+        int _position, _end;
+        std::vector<int> _head, _prev;
+        uint32_t _bits;
+        int _bitCount;
+        uint32_t _adler[2];
+
+    };
+
+    void writeChunk(const char *type, const uint8_t *data, size_t size);
+    void emit(uint8_t byte);
+    void flushChunk();
+
+private:
+    FILE *_file;
+    int _width, _height;
+    int _channels;
+    bool _ok;
+    int _rows;
+
+    std::vector<uint8_t> _previous, _current, _filtered, _best;
+    std::vector<uint8_t> _chunk;
+    Deflater _deflater;
+
+};
+
+#endif /* PngWriter_hpp */
@@ -0,0 +1,157 @@
+//
+//  PredictionBench.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "Benchmarks.hpp"
+
+#include <algorithm>
+#include "GestureTrace.hpp"
+#include "MeshValidation.hpp"
+
+namespace {
+
+const double FrameInterval = GesturePlayer::DefaultFrameInterval;
+//! how far along the trace, back from a frame and ahead of it, a tip is matched to the pen
+const double LookBehind = 0.25;
+const double LookAhead = 0.1;
+//! the prediction horizons compared against no prediction, in frames
+const float Horizons[] = {0.5f, 1, 2};
+
+struct Match {
+    double time;
+    float distance;
+};
+
+//! The time the pen was where tip is, from the samples of the stroke that began at first, within the
+//! window around frameTime; the distance is how far the tip is off the pen's path.
+Match matchTip(const GestureTrace &trace, size_t first, double frameTime, stroke::Vec2 tip)
+{
+    auto &samples = trace.samples;
+    Match best {frameTime, INFINITY};
+    for (size_t i = first + 1; i < samples.size() && samples[i].event != TouchSample::Down; ++i) {
+        auto &a = samples[i - 1], &b = samples[i];
+        if (b.time < frameTime - LookBehind)
+            continue;
+        if (a.time > frameTime + LookAhead)
+            break;
+
+        stroke::Vec2 segment = b.location - a.location;
+        float lengthSq = segment.getLengthSq();
+        float t = lengthSq > 0 ? std::min(1.0f, std::max(0.0f, (tip - a.location).dot(segment) / lengthSq)) : 0;
+        float distance = (a.location + segment * t - tip).getLength();
+        if (distance < best.distance)
+            best = Match {a.time + (b.time - a.time) * t, distance};
+    }
+    return best;
+}
+
+struct Latency {
+    std::vector<double> inkMillis, wetMillis;
+    std::vector<float> wetOffPath;
+    bool valid = true;
+};
+
+//! Replays trace at 60 Hz and, for every frame of a stroke in progress, how long ago the pen was where the
+//! drawn ink and the wet ink end: the latency the drawing adds on top of the display's.
+void measure(const GestureTrace &trace, float horizon, Latency &latency)
+{
+    stroke::PanTracker tracker;
+    stroke::StrokePipeline pipeline;
+    pipeline.setPredictionHorizon(horizon);
+    GesturePlayer player {trace, tracker, pipeline, FrameInterval};
+
+    auto &samples = trace.samples;
+    double frameTime = samples.front().time;
+    size_t next = 0, strokeFirst = 0;
+    stroke::Vec2 inkTip;
+    bool hasInk = false;
+
+    while (player.feedFrame()) {
+        frameTime += FrameInterval;
+        for (; next < samples.size() && samples[next].time < frameTime; ++next) {
+            if (samples[next].event == TouchSample::Down) {
+                strokeFirst = next;
+                hasInk = false;
+            }
+        }
+
+        if (pipeline.drawFrame()) {
+            inkTip = pipeline.getFramePoints()[pipeline.getFramePointCount() - 1].pos;
+            hasInk = true;
+        }
+        latency.valid = latency.valid && (pipeline.getPredictionMesh().empty() || validateMesh(pipeline.getPredictionMesh()));
+
+        auto state = tracker.getState();
+        if (!hasInk || (state != stroke::PanTracker::Began && state != stroke::PanTracker::Changed))
+            continue;
+
+        auto &wet = pipeline.getPredictionPoints();
+        stroke::Vec2 wetTip = wet.empty() ? inkTip : wet.back().pos;
+        Match ink = matchTip(trace, strokeFirst, frameTime, inkTip), wetMatch = matchTip(trace, strokeFirst, frameTime, wetTip);
+        latency.inkMillis.push_back((frameTime - ink.time) * 1000);
+        latency.wetMillis.push_back((frameTime - wetMatch.time) * 1000);
+        latency.wetOffPath.push_back(wetMatch.distance);
+    }
+}
+
+double mean(const std::vector<double> &values)
+{
+    double sum = 0;
+    for (auto value : values) {
+        sum += value;
+    }
+    return values.empty() ? 0 : sum / values.size();
+}
+
+float percentile(std::vector<float> values, double p)
+{
+    if (values.empty())
+        return 0;
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, (size_t)(p * (values.size() - 1) + 0.5))];
+}
+
+}
+
+int benchPrediction(const bench::Options &options)
+{
+    int failures = 0;
+    std::vector<GestureTrace> traces;
+    if (!loadGestureCorpus(options, traces))
+        return 1;
+
+    for (auto frames : Horizons) {
+        Latency total;
+        for (auto &trace : traces) {
+            Latency latency;
+            measure(trace, frames * (float)FrameInterval, latency);
+            total.valid = total.valid && latency.valid;
+            total.inkMillis.insert(total.inkMillis.end(), latency.inkMillis.begin(), latency.inkMillis.end());
+            total.wetMillis.insert(total.wetMillis.end(), latency.wetMillis.begin(), latency.wetMillis.end());
+            total.wetOffPath.insert(total.wetOffPath.end(), latency.wetOffPath.begin(), latency.wetOffPath.end());
+        }
+
+        char name[64];
+        snprintf(name, sizeof(name), "horizon %.1f frames", frames);
+        double hidden = mean(total.inkMillis) - mean(total.wetMillis);
+        bench::report(name, "drawn ink latency", mean(total.inkMillis), "ms");
+        bench::report(name, "wet ink latency", mean(total.wetMillis), "ms");
+        bench::report(name, "latency hidden", hidden / (FrameInterval * 1000), "frames");
+        bench::report(name, "wet tip off path p95", percentile(total.wetOffPath, 0.95), "pt");
+
+        if (!total.valid) {
+            printf("  %-32s FAILED prediction mesh validation\n", name);
+            failures++;
+        }
+        //! the default horizon is there to take a frame off
+        if (frames * (float)FrameInterval == stroke::InkPredictor::DefaultHorizon && hidden < FrameInterval * 1000) {
+            printf("  %-32s FAILED hides %.1f ms, less than a frame\n", name, hidden);
+            failures++;
+        }
+    }
+    return failures;
+}
@@ -0,0 +1,140 @@
+//
+//  RedrawBench.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "Benchmarks.hpp"
+
+#include "GestureTrace.hpp"
+#include "Stroke/RedrawPolicy.hpp"
+
+namespace {
+
+const double FrameInterval = GesturePlayer::DefaultFrameInterval;
+//! the canvas left alone between the recorded gestures
+const double IdleGap = 5;
+
+//! Every recorded gesture one after the other, IdleGap seconds apart: a session of drawing and looking.
+GestureTrace session(const std::vector<GestureTrace> &traces)
+{
+    GestureTrace joined;
+    joined.name = "gestures 5 s apart";
+    double start = 0;
+    for (auto &trace : traces) {
+        double offset = start - trace.samples.front().time;
+        for (auto sample : trace.samples) {
+            sample.time += offset;
+            joined.samples.push_back(sample);
+        }
+        start = joined.samples.back().time + IdleGap;
+    }
+    return joined;
+}
+
+struct RedrawTotals {
+    size_t vsyncs = 0;
+    size_t inkFrames = 0;
+    size_t inkVertices = 0;
+    //! touch-downs whose frame was not drawn
+    size_t missedTouches = 0;
+    //! the most frames drawn in a row with nothing to draw
+    size_t longestLinger = 0;
+    stroke::RedrawPolicy::Stats stats;
+};
+
+//! Replays the session on a 60 Hz display: touches reach the policy as they come, whether the loop runs or
+//! not, and a frame is drawn on each vsync the loop runs on. The clock is the trace's, not the wall clock.
+void play(const GestureTrace &trace, bool onDemand, RedrawTotals &totals)
+{
+    stroke::PanTracker tracker;
+    stroke::StrokePipeline pipeline;
+    GesturePlayer player {trace, tracker, pipeline, FrameInterval};
+    stroke::RedrawPolicy policy;
+    policy.setOnDemand(onDemand);
+
+    const auto epoch = stroke::RedrawPolicy::time_point {};
+    auto timeOf = [&] (double seconds) {
+        return epoch + std::chrono::duration_cast<stroke::RedrawPolicy::time_point::duration>(std::chrono::duration<double>(seconds));
+    };
+
+    auto &samples = trace.samples;
+    double frameStart = samples.front().time;
+    policy.resetStats(timeOf(frameStart));
+    size_t next = 0, linger = 0;
+    for (bool more = true; more; frameStart += FrameInterval) {
+        double frameEnd = frameStart + FrameInterval;
+        bool touchDown = false;
+        for (; next < samples.size() && samples[next].time < frameEnd; ++next) {
+            if (samples[next].event == TouchSample::Down) {
+                policy.touchBegan(timeOf(samples[next].time));
+                touchDown = true;
+            }
+            else if (samples[next].event == TouchSample::Up) {
+                policy.touchEnded();
+            }
+        }
+        //! the input is delivered on every vsync, only drawing stops
+        more = player.feedFrame();
+        totals.vsyncs++;
+        if (!policy.isRunning()) {
+            totals.missedTouches += touchDown;
+            continue;
+        }
+
+        bool drawn = pipeline.drawFrame();
+        if (drawn) {
+            totals.inkFrames++;
+            totals.inkVertices += pipeline.getMesh().getVertices().size();
+        }
+        linger = drawn || policy.getTouchCount() > 0 ? 0 : linger + 1;
+        totals.longestLinger = std::max(totals.longestLinger, linger);
+        policy.frameDrawn(drawn || !pipeline.isIdle(), timeOf(frameEnd));
+    }
+    totals.stats = policy.getStats(timeOf(frameStart));
+}
+
+}
+
+int benchRedraw(const bench::Options &options)
+{
+    std::vector<GestureTrace> traces;
+    if (!loadGestureCorpus(options, traces))
+        return 1;
+    auto trace = session(traces);
+    const char *name = trace.name.c_str();
+    int failures = 0;
+
+    RedrawTotals continuous, onDemand;
+    play(trace, false, continuous);
+    play(trace, true, onDemand);
+
+    bench::report(name, "session", trace.getDuration(), "s");
+    bench::report(name, "continuous frames", continuous.stats.framesDrawn, "");
+    bench::report(name, "on demand frames", onDemand.stats.framesDrawn, "");
+    bench::report(name, "frames avoided", 100.0 * (1 - (double)onDemand.stats.framesDrawn / continuous.stats.framesDrawn), "%");
+    bench::report(name, "wakeups", onDemand.stats.wakeups, "");
+    bench::report(name, "duty cycle", 100 * onDemand.stats.getDutyCycle(), "%");
+
+    //! the same ink on the same frames, no touch-down waits for a frame, and idle stops within the linger
+    if (onDemand.inkFrames != continuous.inkFrames || onDemand.inkVertices != continuous.inkVertices) {
+        printf("  %-32s FAILED %zu frames of ink on demand, %zu continuous\n", name, onDemand.inkFrames, continuous.inkFrames);
+        failures++;
+    }
+    if (onDemand.missedTouches > 0) {
+        printf("  %-32s FAILED %zu touch-downs not drawn on their frame\n", name, onDemand.missedTouches);
+        failures++;
+    }
+    if (onDemand.longestLinger > (size_t)stroke::RedrawPolicy::DefaultLingerFrames) {
+        printf("  %-32s FAILED %zu idle frames drawn in a row\n", name, onDemand.longestLinger);
+        failures++;
+    }
+    //! at the least the loop stops in every gap between the gestures
+    if (onDemand.stats.wakeups < traces.size() - 1) {
+        printf("  %-32s FAILED the loop was started %llu times over %zu gestures\n", name, (unsigned long long)onDemand.stats.wakeups, traces.size());
+        failures++;
+    }
+    return failures;
+}
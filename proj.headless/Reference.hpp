@@ -0,0 +1,257 @@
+//
+//  Reference.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef Reference_hpp
+#define Reference_hpp
+
+#include <algorithm>
+#include <vector>
+#include "Stroke/StrokeTypes.hpp"
+
+//! The original LineDrawer implementations, kept verbatim as the baseline the optimized library code
+//! is benchmarked and checked against.
+namespace reference {
+
+using stroke::CirclePoint;
+using stroke::Color4F;
+using stroke::LinePoint;
+using stroke::Vec2;
+
+struct Color4B {
+    uint8_t r, g, b, a;
+
+    Color4B() : r(0), g(0), b(0), a(0) {}
+    explicit Color4B(const Color4F &c)
+    : r((uint8_t)(c.r * 255)), g((uint8_t)(c.g * 255)), b((uint8_t)(c.b * 255)), a((uint8_t)(c.a * 255)) {}
+};
+
+//! cocos2d::V3F_C4B_T2F, 24 bytes
+struct Vertex {
+    float x, y, z;
+    Color4B color;
+    float u, v;
+};
+
+inline std::vector<LinePoint> smoothLinePoints(std::vector<LinePoint> &linePoints)
+{
+    std::vector<LinePoint> result;
+
+    if (linePoints.size() > 2) {
+        for (unsigned int i = 2; i < linePoints.size(); ++i) {
+            auto prev2 = linePoints[i - 2];
+            auto prev1 = linePoints[i - 1];
+            auto cur = linePoints[i];
+
+            Vec2 midPoint1 = (prev1.pos + prev2.pos) * .5;
+            Vec2 midPoint2 = (cur.pos + prev1.pos) * .5;
+
+            int segmentDistance = 2;
+            float distance = (midPoint1 - midPoint2).getLength();
+            int numberOfSegments = std::min(128, std::max((int)floorf(distance / segmentDistance), 32));
+
+            float t = 0.0f;
+            float step = 1.0f / numberOfSegments;
+            for (int j = 0; j < numberOfSegments; j++) {
+                LinePoint newPoint;
+                newPoint.pos = midPoint1 * powf(1 - t, 2) + prev1.pos * 2.0f * (1 - t) * t + midPoint2 * t * t;
+                newPoint.width = powf(1 - t, 2) * ((prev1.width + prev2.width) * 0.5f) + 2.0f * (1 - t) * t * prev1.width + t * t * ((cur.width + prev1.width) * 0.5f);
+
+                result.push_back(newPoint);
+                t += step;
+            }
+            LinePoint finalPoint;
+            finalPoint.pos = midPoint2;
+            finalPoint.width = (cur.width + prev1.width) * 0.5f;
+            result.push_back(finalPoint);
+        }
+    }
+
+    return result;
+}
+
+//! drawLines with triangulateRect and triangulateCircle: 12 fresh vertices per segment, one index range.
+class LineTessellator {
+
+public:
+    static constexpr float Overdraw = .5f;
+
+public:
+    LineTessellator () : _connectingLine(false), _finishingLine(false), _capIndexStart(0) {}
+
+    void startNewLine() { _connectingLine = false; }
+    void finishLine() { _finishingLine = true; }
+
+    std::vector<Vertex> &getVertices() { return _vertices; }
+    std::vector<unsigned short> &getIndices() { return _indices; }
+    size_t getCapIndexStart() const { return _capIndexStart; }
+
+    void drawLines(std::vector<LinePoint> &linePoints, Color4F color)
+    {
+        const Color4F fadeOutColor {0, 0, 0, 0};
+
+        LinePoint &prevPoint = linePoints[0];
+
+        _vertices.clear();
+        _indices.clear();
+
+        std::vector<CirclePoint> circles;
+
+        for (size_t i = 1; i < linePoints.size(); i++) {
+            auto curPoint = linePoints[i];
+
+            if (curPoint.pos.fuzzyEquals(prevPoint.pos, 0.0001f)) {
+                continue;
+            }
+
+            Vec2 dir = curPoint.pos - prevPoint.pos;
+            Vec2 perp = dir.getPerp().getNormalized();
+            Vec2 A = prevPoint.pos + perp * prevPoint.width / 2;
+            Vec2 B = prevPoint.pos - perp * prevPoint.width / 2;
+            Vec2 C = curPoint.pos + perp * curPoint.width / 2;
+            Vec2 D = curPoint.pos - perp * curPoint.width / 2;
+
+            if (_connectingLine || _indices.size() > 0) {
+                A = _prevC;
+                B = _prevD;
+            } else if (_indices.size() == 0) {
+                circles.push_back(CirclePoint {curPoint.pos, curPoint.width, (linePoints[i - 1].pos - curPoint.pos).getNormalized()});
+            }
+
+            triangulateRect(A, B, C, D, color, _vertices, _indices);
+
+            _prevD = D;
+            _prevC = C;
+            if (_finishingLine && (i == linePoints.size() - 1)) {
+                circles.push_back(CirclePoint {curPoint.pos, curPoint.width, (curPoint.pos - linePoints[i - 1].pos).getNormalized()});
+                _finishingLine = false;
+            }
+
+            prevPoint = curPoint;
+
+            //! Add overdraw
+            Vec2 F = A + perp * Overdraw;
+            Vec2 G = C + perp * Overdraw;
+            Vec2 H = B - perp * Overdraw;
+            Vec2 I = D - perp * Overdraw;
+
+            if (_connectingLine || _indices.size() > 6) {
+                F = _prevG;
+                H = _prevI;
+            }
+            _prevG = G;
+            _prevI = I;
+
+            triangulateRect(F, fadeOutColor, A, color, G, fadeOutColor, C, color, _vertices, _indices, 0);
+            triangulateRect(B, color, H, fadeOutColor, D, color, I, fadeOutColor, _vertices, _indices, 0);
+        }
+
+        _capIndexStart = _indices.size();
+        for (auto c : circles) {
+            triangulateCircle(c, color, Overdraw, _vertices, _indices);
+        }
+
+        if (_indices.size() > 0) {
+            _connectingLine = true;
+        }
+    }
+
+    static void triangulateRect(Vec2 A, Vec2 B, Vec2 C, Vec2 D, Color4F color, std::vector<Vertex> &vertices, std::vector<unsigned short> &indices, float z = 0)
+    {
+        triangulateRect(A, color, B, color, C, color, D, color, vertices, indices, z);
+    }
+
+    static void triangulateRect(Vec2 A, Color4F a, Vec2 B, Color4F b, Vec2 C, Color4F c, Vec2 D, Color4F d, std::vector<Vertex> &vertices, std::vector<unsigned short> &indices, float z)
+    {
+        auto startIndex = vertices.size();
+
+        vertices.push_back(Vertex {A.x, A.y, z, Color4B {a}, 0, 0});
+        vertices.push_back(Vertex {B.x, B.y, z, Color4B {b}, 0, 0});
+        vertices.push_back(Vertex {C.x, C.y, z, Color4B {c}, 0, 0});
+        vertices.push_back(Vertex {D.x, D.y, z, Color4B {d}, 0, 0});
+
+        indices.push_back(startIndex);     //A
+        indices.push_back(startIndex + 1); //B
+        indices.push_back(startIndex + 2); //C
+
+        indices.push_back(startIndex + 1); //B
+        indices.push_back(startIndex + 2); //C
+        indices.push_back(startIndex + 3); //D
+    }
+
+    static void triangulateCircle(CirclePoint circle, Color4F color, float overdraw, std::vector<Vertex> &vertices, std::vector<unsigned short> &indices, float z = 0)
+    {
+        Color4F fadeOutColor = Color4F {};
+
+        int numberOfSegments = 32;
+        float anglePerSegment = (float)(M_PI / (numberOfSegments - 1));
+
+        Vec2 perp = circle.dir.getPerp();
+
+        float angle = acosf(perp.dot(Vec2 {0, 1}));
+        const float rightDot = perp.dot(Vec2 {1, 0});
+        if (rightDot < 0.0f) {
+            angle *= -1;
+        }
+
+        const float radius = circle.width * .5;
+        const unsigned short centerIndex = vertices.size();
+
+        vertices.push_back(Vertex {circle.pos.x, circle.pos.y, z, Color4B {color}, 0, 0});
+
+        int prevIndex = 0;
+        Vec2 prevPoint, prevDir;
+        for (int i = 0; i < numberOfSegments; ++i) {
+            Vec2 dir = Vec2 {sinf(angle), cosf(angle)};
+            Vec2 curPoint = Vec2 {circle.pos.x + radius * dir.x, circle.pos.y + radius * dir.y};
+
+            int currentIndex = vertices.size();
+            vertices.push_back(Vertex {curPoint.x, curPoint.y, z, Color4B {color}, 0, 0});
+
+            if (i > 0) {
+                indices.push_back(centerIndex);
+                indices.push_back(prevIndex);
+                indices.push_back(currentIndex);
+
+                Vec2 prevOverdrawnPoint = prevPoint + prevDir * overdraw;
+                Vec2 currentOverdrawnPoint = curPoint + dir * overdraw;
+
+                auto prevOverdrawIndex = vertices.size();
+                vertices.push_back(Vertex {prevOverdrawnPoint.x, prevOverdrawnPoint.y, z, Color4B {fadeOutColor}, 0, 0});
+
+                auto curOverdrawIndex = vertices.size();
+                vertices.push_back(Vertex {currentOverdrawnPoint.x, currentOverdrawnPoint.y, z, Color4B {fadeOutColor}, 0, 0});
+
+                indices.push_back(prevIndex);
+                indices.push_back(curOverdrawIndex);
+                indices.push_back(prevOverdrawIndex);
+
+                indices.push_back(prevIndex);
+                indices.push_back(currentIndex);
+                indices.push_back(curOverdrawIndex);
+            }
+
+            prevIndex = currentIndex;
+            prevPoint = curPoint;
+            prevDir = dir;
+            angle += anglePerSegment;
+        }
+    }
+
+private:
+    bool _connectingLine, _finishingLine;
+    Vec2 _prevC, _prevD, _prevG, _prevI;
+
+    std::vector<Vertex> _vertices;
+    std::vector<unsigned short> _indices;
+    size_t _capIndexStart;
+
+};
+
+}
+
+#endif /* Reference_hpp */
@@ -0,0 +1,118 @@
+//
+//  ReplayBench.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "Benchmarks.hpp"
+
+#include <algorithm>
+#include "GestureTrace.hpp"
+#include "MeshValidation.hpp"
+
+namespace {
+
+//! the app's design resolution, the area a full render texture pass covers
+const double CanvasArea = 1024.0 * 768.0;
+
+struct ReplayTotals {
+    std::vector<double> frameMicros;
+    size_t frames = 0;
+    size_t samples = 0;
+    size_t drawnFrames = 0;
+    size_t vertices = 0;
+    size_t maxFrameVertices = 0;
+    double dirtyArea = 0;
+    double seconds = 0;
+    bool valid = true;
+};
+
+//! times each frame from the first sample handed to the pipeline to the end of its drawFrame()
+void replay(const GestureTrace &trace, stroke::PanTracker &tracker, stroke::StrokePipeline &pipeline, bool validate, ReplayTotals &totals)
+{
+    GesturePlayer player {trace, tracker, pipeline};
+
+    for (;;) {
+        auto start = bench::clock::now();
+        if (!player.feedFrame())
+            break;
+        bool drawn = pipeline.drawFrame();
+
+        double micros = std::chrono::duration<double, std::micro>(bench::clock::now() - start).count();
+        totals.frameMicros.push_back(micros);
+        totals.seconds += micros * 1e-6;
+        totals.frames++;
+
+        if (drawn) {
+            auto &mesh = pipeline.getMesh();
+            totals.drawnFrames++;
+            totals.vertices += mesh.getVertices().size();
+            totals.maxFrameVertices = std::max(totals.maxFrameVertices, mesh.getVertices().size());
+            totals.dirtyArea += mesh.getBounds().getArea();
+            if (validate)
+                totals.valid = totals.valid && validateMesh(mesh);
+        }
+    }
+    totals.samples += trace.samples.size();
+}
+
+double percentile(const std::vector<double> &sorted, double p)
+{
+    size_t index = std::min(sorted.size() - 1, (size_t)(p * (sorted.size() - 1) + 0.5));
+    return sorted[index];
+}
+
+int runGesture(const GestureTrace &trace, const bench::Options &options)
+{
+    const char *name = trace.name.c_str();
+    stroke::PanTracker tracker;
+    stroke::StrokePipeline pipeline;
+
+    ReplayTotals check;
+    replay(trace, tracker, pipeline, true, check);
+
+    //! replay until there are enough frames for stable percentiles, the pipeline and its buffers are kept
+    ReplayTotals totals;
+    auto start = bench::clock::now();
+    do {
+        replay(trace, tracker, pipeline, false, totals);
+    } while (bench::secondsSince(start) < options.minSeconds);
+
+    std::sort(totals.frameMicros.begin(), totals.frameMicros.end());
+
+    bench::report(name, "duration", trace.getDuration(), "s");
+    bench::report(name, "strokes", trace.getStrokeCount(), "");
+    bench::report(name, "touch samples", trace.samples.size(), "");
+    bench::report(name, "frames", check.frames, "");
+    bench::report(name, "samples/s", totals.samples / totals.seconds, "");
+    bench::report(name, "frame p50", percentile(totals.frameMicros, 0.5), "us");
+    bench::report(name, "frame p90", percentile(totals.frameMicros, 0.9), "us");
+    bench::report(name, "frame p99", percentile(totals.frameMicros, 0.99), "us");
+    bench::report(name, "frame max", totals.frameMicros.back(), "us");
+    bench::report(name, "vertices", check.vertices, "");
+    bench::report(name, "vertices/drawn frame", check.drawnFrames ? (double)check.vertices / check.drawnFrames : 0, "");
+    bench::report(name, "max frame vertices", check.maxFrameVertices, "");
+    //! frames LineDrawer skips the render texture pass for, and how much of it the others scissor to
+    bench::report(name, "skipped frames", 100.0 * (check.frames - check.drawnFrames) / check.frames, "%");
+    bench::report(name, "dirty area/drawn frame", check.drawnFrames ? 100.0 * check.dirtyArea / check.drawnFrames / CanvasArea : 0, "%");
+
+    int failures = 0;
+    if (!check.valid) {
+        printf("  %-32s FAILED mesh validation\n", name);
+        failures++;
+    }
+    if (check.drawnFrames == 0) {
+        printf("  %-32s FAILED nothing was drawn\n", name);
+        failures++;
+    }
+    return failures;
+}
+
+}
+
+int benchReplay(const bench::Options &options)
+{
+    return forEachGesture(options, [&] (const GestureTrace &trace) { return runGesture(trace, options); });
+}
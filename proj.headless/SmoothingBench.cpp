@@ -0,0 +1,98 @@
+//
+//  SmoothingBench.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "Benchmarks.hpp"
+
+#include <cmath>
+#include "Reference.hpp"
+#include "SyntheticStrokes.hpp"
+#include "Stroke/QuadraticEvaluator.hpp"
+#include "Stroke/StrokeSmoother.hpp"
+
+using stroke::QuadraticEvaluator;
+
+namespace {
+
+//! largest position or width difference between two smoothed polylines, infinite if they differ in length.
+float maxDifference(const std::vector<stroke::LinePoint> &a, const std::vector<stroke::LinePoint> &b)
+{
+    if (a.size() != b.size())
+        return INFINITY;
+
+    float result = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        result = std::max(result, std::fabs(a[i].pos.x - b[i].pos.x));
+        result = std::max(result, std::fabs(a[i].pos.y - b[i].pos.y));
+        result = std::max(result, std::fabs(a[i].width - b[i].width));
+    }
+    return result;
+}
+
+int runStroke(const char *name, std::vector<stroke::LinePoint> points, const bench::Options &options)
+{
+    const float tolerance = 1e-2f;
+    int failures = 0;
+
+    auto expected = reference::smoothLinePoints(points);
+    auto referenceTiming = bench::measure(options, [&] {
+        auto result = reference::smoothLinePoints(points);
+        bench::doNotOptimize(result);
+    });
+    double referenceRate = referenceTiming.perSecond(expected.size());
+    bench::report(name, "reference", referenceRate / 1e6, "M points/s");
+
+    auto backend = QuadraticEvaluator::getBackend();
+    const QuadraticEvaluator::Backend backends[] = {
+        QuadraticEvaluator::Backend::Scalar,
+        QuadraticEvaluator::Backend::SSE2,
+        QuadraticEvaluator::Backend::AVX2,
+        QuadraticEvaluator::Backend::NEON,
+    };
+
+    //! the reference always samples at the fixed rate
+    stroke::StrokeSmoother smoother;
+    smoother.setFlattening(stroke::StrokeSmoother::Flattening::Fixed);
+
+    std::vector<stroke::LinePoint> result;
+    for (auto b : backends) {
+        if (!QuadraticEvaluator::setBackend(b))
+            continue;
+
+        smoother.smoothLinePoints(points, result);
+        float error = maxDifference(expected, result);
+
+        auto timing = bench::measure(options, [&] {
+            smoother.smoothLinePoints(points, result);
+            bench::doNotOptimize(result);
+        });
+        double rate = timing.perSecond(result.size());
+
+        char label[64];
+        snprintf(label, sizeof(label), "%s (%.1fx)", QuadraticEvaluator::getBackendName(b), rate / referenceRate);
+        bench::report(name, label, rate / 1e6, "M points/s");
+
+        if (!(error <= tolerance)) {
+            printf("  %-32s FAILED %s differs from reference by %g\n", name, QuadraticEvaluator::getBackendName(b), error);
+            failures++;
+        }
+    }
+    QuadraticEvaluator::setBackend(backend);
+
+    return failures;
+}
+
+}
+
+int benchSmoothing(const bench::Options &options)
+{
+    int count = options.quick ? 200 : 2000;
+    int failures = 0;
+    failures += runStroke("spiral", synthetic::spiral(count), options);
+    failures += runStroke("scribble", synthetic::scribble(count), options);
+    return failures;
+}
@@ -0,0 +1,223 @@
+//
+//  SoftwareBench.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "Benchmarks.hpp"
+
+#include <thread>
+#include "GestureTrace.hpp"
+#include "Stroke/SoftwareRenderer.hpp"
+#include "Stroke/StrokeRasterizer.hpp"
+
+namespace {
+
+const stroke::Color4F Ink {0, 0, 0, 1};
+const stroke::Color4F Paper {1, 1, 1, 1};
+
+//! What SoftwareRenderer computes, pixel by pixel over each triangle's bounds with barycentric coverage, in
+//! one thread: the baseline its spans, bins and threads are checked against.
+void referenceDraw(stroke::Image &image, const stroke::StrokeMesh &mesh, const stroke::Color4F &color, stroke::Vec2 origin, float scale)
+{
+    const float source[4] = {color.r * color.a * 255, color.g * color.a * 255, color.b * color.a * 255, color.a * 255};
+    auto &vertices = mesh.getVertices();
+    auto &indices = mesh.getIndices();
+
+    for (auto &batch : mesh.getBatches()) {
+        for (size_t i = 0; i + 2 < batch.indexCount; i += 3) {
+            stroke::Vertex v[3];
+            for (int k = 0; k < 3; ++k) {
+                auto &vertex = vertices[batch.vertexStart + indices[batch.indexStart + i + k]];
+                v[k] = stroke::Vertex {(vertex.x - origin.x) * scale, (vertex.y - origin.y) * scale, vertex.coverage};
+            }
+            float area = (v[1].x - v[0].x) * (v[2].y - v[0].y) - (v[2].x - v[0].x) * (v[1].y - v[0].y);
+            if (area == 0)
+                continue;
+            if (area < 0) {
+                std::swap(v[1], v[2]);
+                area = -area;
+            }
+
+            float a[3], b[3], c[3];
+            bool inclusive[3];
+            for (int k = 0; k < 3; ++k) {
+                auto &p0 = v[k];
+                auto &p1 = v[(k + 1) % 3];
+                a[k] = p0.y - p1.y;
+                b[k] = p1.x - p0.x;
+                c[k] = -(a[k] * p0.x + b[k] * p0.y);
+                inclusive[k] = a[k] > 0 || (a[k] == 0 && b[k] < 0);
+            }
+
+            int x0 = std::max(0, (int)floorf(std::min(v[0].x, std::min(v[1].x, v[2].x))));
+            int y0 = std::max(0, (int)floorf(std::min(v[0].y, std::min(v[1].y, v[2].y))));
+            int x1 = std::min(image.width - 1, (int)ceilf(std::max(v[0].x, std::max(v[1].x, v[2].x))));
+            int y1 = std::min(image.height - 1, (int)ceilf(std::max(v[0].y, std::max(v[1].y, v[2].y))));
+            for (int y = y0; y <= y1; ++y) {
+                for (int x = x0; x <= x1; ++x) {
+                    float px = x + .5f, py = y + .5f;
+                    float e[3];
+                    bool in = true;
+                    for (int k = 0; k < 3; ++k) {
+                        e[k] = a[k] * px + b[k] * py + c[k];
+                        in = in && (e[k] > 0 || (e[k] == 0 && inclusive[k]));
+                    }
+                    if (!in)
+                        continue;
+
+                    float coverage = (v[0].coverage * e[1] + v[1].coverage * e[2] + v[2].coverage * e[0]) / area;
+                    coverage = std::min(1.0f, std::max(0.0f, coverage));
+                    uint32_t &pixel = image.at(x, y);
+                    uint8_t out[4];
+                    for (int ch = 0; ch < 4; ++ch) {
+                        float value = source[ch] * coverage + stroke::Image::channel(pixel, ch) * (1 - color.a * coverage);
+                        out[ch] = (uint8_t)std::min(255, std::max(0, (int)(value + .5f)));
+                    }
+                    pixel = stroke::Image::pack(out[0], out[1], out[2], out[3]);
+                }
+            }
+        }
+    }
+}
+
+int maxDifference(const stroke::Image &a, const stroke::Image &b, size_t &differing)
+{
+    int result = 0;
+    differing = 0;
+    for (size_t i = 0; i < a.pixels.size(); ++i) {
+        int pixelDifference = 0;
+        for (int ch = 0; ch < 4; ++ch) {
+            pixelDifference = std::max(pixelDifference, abs(stroke::Image::channel(a.pixels[i], ch) - stroke::Image::channel(b.pixels[i], ch)));
+        }
+        differing += pixelDifference > 0;
+        result = std::max(result, pixelDifference);
+    }
+    return result;
+}
+
+//! The ink across a straight stroke, in pixels of full coverage, against its exact value: the width, plus
+//! the fringe, which ramps coverage out over Overdraw on either side and so adds half of it to each edge.
+//! Pixel centers sample the fringe, a narrower ramp than a pixel, so the ink across varies with where the
+//! stroke falls on the pixel grid, on a GPU too; averaged over offsets it has to come out right.
+int checkStraightStroke()
+{
+    const char *name = "straight stroke";
+    int failures = 0;
+    stroke::SoftwareRenderer renderer {1};
+
+    const int offsets = 16;
+    //! columns well away from the caps
+    const int x0 = 100, x1 = 140;
+    for (float width : {2.0f, 6.0f, 12.0f}) {
+        double ink = 0;
+        for (int offset = 0; offset < offsets; ++offset) {
+            stroke::StrokeModel model;
+            model.beginStroke();
+            for (int i = 0; i <= 40; ++i) {
+                model.addPoint(stroke::LinePoint {stroke::Vec2 {20.0f + i * 5, 50 + (float)offset / offsets}, width});
+            }
+            model.endStroke();
+
+            stroke::StrokeRasterizer rasterizer;
+            stroke::StrokeMesh mesh;
+            rasterizer.rasterize(model, model.getBounds(), 1, mesh);
+
+            stroke::Image image {260, 100};
+            image.clear(stroke::Color4F {0, 0, 0, 0});
+            renderer.draw(image, mesh, Ink);
+
+            for (int x = x0; x < x1; ++x) {
+                for (int y = 0; y < image.height; ++y) {
+                    ink += stroke::Image::channel(image.at(x, y), 3) / 255.0;
+                }
+            }
+        }
+        ink /= (x1 - x0) * offsets;
+        const double exact = width + stroke::StrokeTessellator::Overdraw;
+        double error = 100 * (ink - exact) / exact;
+
+        char metric[32];
+        snprintf(metric, sizeof(metric), "cross section %.0fpt", width);
+        bench::report(name, metric, error, "%");
+        if (fabs(error) > 2) {
+            printf("  %-32s FAILED %.3f of ink across against %.3f\n", name, ink, exact);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+int runGesture(const GestureTrace &trace, const bench::Options &options)
+{
+    const char *name = trace.name.c_str();
+    int failures = 0;
+
+    stroke::StrokeModel model;
+    stroke::PanTracker tracker;
+    stroke::StrokePipeline pipeline;
+    pipeline.setModel(&model);
+    GesturePlayer player {trace, tracker, pipeline};
+    while (player.feedFrame()) {
+        pipeline.drawFrame();
+    }
+
+    stroke::StrokeRasterizer rasterizer;
+    stroke::StrokeMesh mesh;
+    auto bounds = model.getBounds().expanded(2);
+    rasterizer.rasterize(model, bounds, 1, mesh);
+    stroke::Vec2 origin {floorf(bounds.minX), floorf(bounds.minY)};
+    const int width = (int)ceilf(bounds.maxX - origin.x), height = (int)ceilf(bounds.maxY - origin.y);
+
+    stroke::Image reference {width, height}, single {width, height}, threaded {width, height};
+    reference.clear(Paper);
+    referenceDraw(reference, mesh, Ink, origin, 1);
+
+    stroke::SoftwareRenderer one {1};
+    stroke::SoftwareRenderer many {std::max(4u, std::thread::hardware_concurrency())};
+    single.clear(Paper);
+    one.draw(single, mesh, Ink, origin);
+    threaded.clear(Paper);
+    many.draw(threaded, mesh, Ink, origin);
+
+    size_t differing, threadDiffering;
+    int difference = maxDifference(reference, single, differing);
+    int threadDifference = maxDifference(single, threaded, threadDiffering);
+    bench::report(name, "pixels", width * height / 1e6, "Mpx");
+    bench::report(name, "triangles", one.getTriangleCount(), "");
+    bench::report(name, "max diff vs reference", difference, "/255");
+    bench::report(name, "pixels differing", 100.0 * differing / reference.pixels.size(), "%");
+    if (difference > 1 || threadDifference != 0) {
+        printf("  %-32s FAILED %d/255 from the reference, %zu pixels change with %u threads\n", name, difference, threadDiffering, many.getThreadCount());
+        failures++;
+    }
+
+    //! a 2x export: the mesh tessellated for the output scale, as StrokeRender would draw it
+    stroke::StrokeMesh mesh2x;
+    rasterizer.rasterize(model, bounds, 2, mesh2x);
+    stroke::Image image2x {width * 2, height * 2};
+
+    auto naive = bench::measure(options, [&] { referenceDraw(reference, mesh, Ink, origin, 1); });
+    auto timingOne = bench::measure(options, [&] { one.draw(single, mesh, Ink, origin); });
+    auto timingMany = bench::measure(options, [&] { many.draw(threaded, mesh, Ink, origin); });
+    auto timing2x = bench::measure(options, [&] { many.draw(image2x, mesh2x, Ink, origin * 2); });
+    bench::report(name, "reference", naive.microsPerIteration(), "us");
+    bench::report(name, "1 thread", timingOne.microsPerIteration(), "us");
+    char metric[32];
+    snprintf(metric, sizeof(metric), "%u threads", many.getThreadCount());
+    bench::report(name, metric, timingMany.microsPerIteration(), "us");
+    bench::report(name, "2x export", timing2x.microsPerIteration(), "us");
+    bench::report(name, "2x export rate", width * height * 4 / timing2x.microsPerIteration(), "Mpx/s");
+    return failures;
+}
+
+}
+
+int benchSoftware(const bench::Options &options)
+{
+    int failures = checkStraightStroke();
+    failures += forEachGesture(options, [&] (const GestureTrace &trace) { return runGesture(trace, options); });
+    return failures;
+}
@@ -0,0 +1,97 @@
+//
+//  StressBench.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "Benchmarks.hpp"
+
+#include "FrameDriver.hpp"
+#include "MeshValidation.hpp"
+#include "SyntheticStrokes.hpp"
+
+using stroke::StrokeMesh;
+
+namespace {
+
+//! resolves the indices of every batch into a flat list of triangle corner positions.
+std::vector<stroke::Vec2> expandTriangles(const StrokeMesh &mesh)
+{
+    std::vector<stroke::Vec2> corners;
+    corners.reserve(mesh.getIndices().size());
+
+    for (auto &batch : mesh.getBatches()) {
+        for (size_t i = batch.indexStart; i < batch.indexStart + batch.indexCount; ++i) {
+            auto &v = mesh.getVertices()[batch.vertexStart + mesh.getIndices()[i]];
+            corners.push_back(stroke::Vec2 {v.x, v.y});
+        }
+    }
+    return corners;
+}
+
+//! the whole stroke arrives in one frame, as it does after a stall on a fast scribble.
+void drawInOneFrame(FrameDriver &driver, const std::vector<stroke::LinePoint> &points)
+{
+    driver.startNewLine(points[0]);
+    for (size_t i = 1; i + 1 < points.size(); ++i) {
+        driver.addPoint(points[i]);
+    }
+    driver.endLine(points.back());
+    driver.drawFrame();
+}
+
+int runStroke(const char *name, const std::vector<stroke::LinePoint> &points, const bench::Options &options)
+{
+    int failures = 0;
+
+    FrameDriver driver;
+    driver.getSmoother().setFlattening(stroke::StrokeSmoother::Flattening::Fixed);
+    drawInOneFrame(driver, points);
+
+    auto &mesh = driver.getTessellator().getMesh();
+    size_t vertices = mesh.getVertices().size();
+    bench::report(name, "vertices in frame", vertices, "");
+    bench::report(name, "batches", mesh.getBatches().size(), "");
+    bench::report(name, "over 16 bit range", vertices > 65536 ? vertices - 65536 : 0, "vertices");
+
+    if (vertices <= StrokeMesh::MaxBatchVertices) {
+        printf("  %-32s FAILED frame did not exceed one batch\n", name);
+        failures++;
+    }
+    if (!validateMesh(mesh)) {
+        printf("  %-32s FAILED mesh validation\n", name);
+        failures++;
+    }
+
+    //! splitting must not change the geometry: compare against much smaller batches
+    auto expected = expandTriangles(mesh);
+
+    FrameDriver smallBatches;
+    smallBatches.getSmoother().setFlattening(stroke::StrokeSmoother::Flattening::Fixed);
+    smallBatches.getTessellator().getMesh().setBatchLimits(1000, 1500);
+    drawInOneFrame(smallBatches, points);
+
+    if (!validateMesh(smallBatches.getTessellator().getMesh(), 1000, 1500) || expandTriangles(smallBatches.getTessellator().getMesh()) != expected) {
+        printf("  %-32s FAILED geometry differs with small batches\n", name);
+        failures++;
+    }
+
+    auto timing = bench::measure(options, [&] { drawInOneFrame(driver, points); });
+    bench::report(name, "frame time", timing.microsPerIteration() / 1000, "ms");
+    bench::report(name, "vertices/s", timing.perSecond(vertices) / 1e6, "M");
+
+    return failures;
+}
+
+}
+
+int benchStress(const bench::Options &options)
+{
+    int count = options.quick ? 800 : 4000;
+    int failures = 0;
+    failures += runStroke("scribble, one frame", synthetic::scribble(count), options);
+    failures += runStroke("spiral, one frame", synthetic::spiral(count), options);
+    return failures;
+}
@@ -0,0 +1,375 @@
+//
+//  StrokeLogBench.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "Benchmarks.hpp"
+
+#include <math.h>
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include "GestureTrace.hpp"
+#include "Stroke/StrokeLog.hpp"
+
+namespace {
+
+//! how long a drawing session the corpus is repeated into, and the pause between gestures
+const double SessionSeconds = 2 * 3600;
+const double QuickSessionSeconds = 10 * 60;
+const double GesturePause = 2;
+//! every few gestures a second finger draws the fast scribble alongside
+const int SecondFingerEvery = 4;
+const int SeekCount = 1000;
+
+struct SessionSample {
+    double time;
+    int finger;
+    TouchSample sample;
+};
+
+//! the corpus over and over, in time order, until the session is seconds long
+std::vector<SessionSample> buildSession(const std::vector<GestureTrace> &traces, double seconds)
+{
+    std::vector<SessionSample> session;
+    double offset = 0;
+    for (int gesture = 0; offset < seconds; ++gesture) {
+        auto &trace = traces[gesture % traces.size()];
+        double start = trace.samples.front().time;
+        for (auto &sample : trace.samples) {
+            session.push_back(SessionSample {offset + sample.time - start, 0, sample});
+        }
+        if (gesture % SecondFingerEvery == 0) {
+            auto &second = traces[1];
+            for (auto &sample : second.samples) {
+                session.push_back(SessionSample {offset + sample.time - second.samples.front().time, 1, sample});
+            }
+        }
+        offset += trace.getDuration() + GesturePause;
+    }
+    std::stable_sort(session.begin(), session.end(), [] (const SessionSample &a, const SessionSample &b) { return a.time < b.time; });
+    return session;
+}
+
+stroke::PanTracker::time_point timestampOf(double seconds)
+{
+    return stroke::PanTracker::time_point {} + std::chrono::duration_cast<stroke::PanTracker::time_point::duration>(std::chrono::duration<double>(seconds));
+}
+
+//! a finger's pan, with widths as StrokePipeline::extractSize() filters them
+struct Finger {
+    stroke::PanTracker tracker;
+    uint32_t slot = 0;
+    float width = 0;
+    double time = 0;
+
+    float extractWidth(stroke::Vec2 velocity)
+    {
+        float size = std::min(std::max(velocity.getLength() / stroke::StrokePipeline::SpeedPerWidth, stroke::StrokePipeline::MinWidth), stroke::StrokePipeline::MaxWidth);
+        width = width != 0 ? size * 0.8f + width * 0.2f : size;
+        return width;
+    }
+};
+
+//! Tracks the session's pans and writes their samples to log, keeping the records as written in records,
+//! with their seconds from the session's start.
+void record(const std::vector<SessionSample> &session, stroke::StrokeLogWriter &log, std::vector<stroke::StrokeLogRecord> &records)
+{
+    Finger fingers[2];
+    for (auto &s : session) {
+        Finger &finger = fingers[s.finger];
+        auto &sample = s.sample;
+        if (sample.event == TouchSample::Down) {
+            finger.tracker.touchBegan(sample.location, timestampOf(s.time));
+        }
+        else if (sample.event == TouchSample::Move) {
+            stroke::InputSample input {sample.location, timestampOf(s.time)};
+            if (!finger.tracker.touchMoved(&input, 1))
+                continue;
+            for (auto &pan : finger.tracker.getSamples()) {
+                double seconds = std::chrono::duration<double>(pan.timestamp.time_since_epoch()).count();
+                bool began = finger.tracker.getState() == stroke::PanTracker::Began && &pan == &finger.tracker.getSamples().front();
+                if (began) {
+                    finger.width = 0;
+                    float width = finger.extractWidth(pan.velocity);
+                    finger.slot = log.beginStroke(pan.location, width, pan.timestamp);
+                    records.push_back(stroke::StrokeLogRecord {stroke::StrokeLogRecord::Begin, finger.slot, pan.location, width, seconds});
+                }
+                else {
+                    float width = finger.extractWidth(pan.velocity);
+                    log.addSample(finger.slot, pan.location, width, pan.timestamp);
+                    records.push_back(stroke::StrokeLogRecord {stroke::StrokeLogRecord::Sample, finger.slot, pan.location, width, seconds});
+                }
+                finger.time = seconds;
+            }
+        }
+        else if (finger.tracker.touchEnded(sample.location)) {
+            float width = finger.extractWidth(finger.tracker.getVelocity());
+            log.endStroke(finger.slot, finger.tracker.getLocation(), width, timestampOf(finger.time));
+            records.push_back(stroke::StrokeLogRecord {stroke::StrokeLogRecord::End, finger.slot, finger.tracker.getLocation(), width, finger.time});
+        }
+    }
+}
+
+//! the records decoded match the ones written, to within half a quantization step
+bool matches(const stroke::StrokeLogRecord &decoded, const stroke::StrokeLogRecord &written, double epoch)
+{
+    const float position = stroke::strokelog::PositionStep * 0.5f + 1e-3f;
+    const double time = stroke::strokelog::TimeStep * 0.5 + 1e-6;
+    return decoded.kind == written.kind && decoded.slot == written.slot
+        && fabsf(decoded.location.x - written.location.x) <= position && fabsf(decoded.location.y - written.location.y) <= position
+        && fabsf(decoded.width - written.width) <= position && fabs(decoded.seconds - (written.seconds - epoch)) <= time;
+}
+
+std::string tempPath(const char *name)
+{
+    const char *tmp = getenv("TMPDIR");
+    return std::string(tmp ? tmp : "/tmp") + "/" + name;
+}
+
+//! the first bytes of path into a new file, as a log cut off before it was closed
+bool truncateCopy(const std::string &path, const std::string &copy, size_t bytes)
+{
+    FILE *in = fopen(path.c_str(), "rb");
+    FILE *out = fopen(copy.c_str(), "wb");
+    std::vector<char> data(bytes);
+    bool copied = in && out && fread(data.data(), 1, bytes, in) == bytes && fwrite(data.data(), 1, bytes, out) == bytes;
+    if (in)
+        fclose(in);
+    if (out)
+        fclose(out);
+    return copied;
+}
+
+//! A 100 byte log with the header of path and a trailer of indexOffset and count, the index entries all
+//! pointing to entryOffset: what a corrupt or half overwritten file could hold.
+bool writeCorruptCopy(const std::string &path, const std::string &copy, uint64_t indexOffset, uint32_t count, uint64_t entryOffset)
+{
+    const size_t Bytes = 100;
+    auto put = [] (uint8_t *p, uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            p[i] = (uint8_t)(value >> (8 * i));
+        }
+    };
+    std::vector<uint8_t> data(Bytes);
+    FILE *in = fopen(path.c_str(), "rb");
+    bool read = in && fread(data.data(), 1, stroke::strokelog::HeaderBytes, in) == stroke::strokelog::HeaderBytes;
+    if (in)
+        fclose(in);
+    if (!read)
+        return false;
+
+    uint8_t *trailer = data.data() + Bytes - stroke::strokelog::TrailerBytes;
+    for (uint8_t *entry = trailer - stroke::strokelog::IndexEntryBytes; entry >= data.data() + stroke::strokelog::HeaderBytes; entry -= stroke::strokelog::IndexEntryBytes) {
+        put(entry, entryOffset, 8);
+        put(entry + 16, 1, 4);
+    }
+    put(trailer, indexOffset, 8);
+    put(trailer + 8, count, 4);
+    put(trailer + 12, stroke::strokelog::IndexMagic, 4);
+
+    FILE *out = fopen(copy.c_str(), "wb");
+    bool written = out && fwrite(data.data(), 1, Bytes, out) == Bytes;
+    if (out)
+        fclose(out);
+    return written;
+}
+
+//! the pipeline writes a record for every pan sample it is handed and one more for each stroke's end
+int checkPipeline(const GestureTrace &trace)
+{
+    std::string path = tempPath("StrokeBench-pipeline.strokelog");
+    stroke::StrokeLogWriter log;
+    stroke::StrokeLogReader reader;
+    size_t panSamples = 0;
+    if (log.open(path.c_str())) {
+        stroke::PanTracker tracker;
+        stroke::StrokePipeline pipeline;
+        pipeline.setLog(&log);
+        GesturePlayer player {trace, tracker, pipeline};
+        while (player.feedFrame()) {
+            pipeline.clearPoints();
+        }
+        log.close();
+        reader.open(path.c_str());
+    }
+
+    size_t begins = 0, ends = 0;
+    for (size_t b = 0; b < reader.getBlockCount(); ++b) {
+        auto cursor = reader.read(b);
+        stroke::StrokeLogRecord record;
+        while (cursor.next(record)) {
+            begins += record.kind == stroke::StrokeLogRecord::Begin;
+            ends += record.kind == stroke::StrokeLogRecord::End;
+            panSamples += record.kind != stroke::StrokeLogRecord::End;
+        }
+    }
+    remove(path.c_str());
+
+    stroke::StrokeLogWriter direct;
+    std::vector<stroke::StrokeLogRecord> records;
+    std::vector<SessionSample> session;
+    for (auto &sample : trace.samples) {
+        session.push_back(SessionSample {sample.time, 0, sample});
+    }
+    record(session, direct, records);
+
+    if (!reader.hasIndex() || begins != trace.getStrokeCount() || ends != begins || panSamples + ends != records.size()) {
+        printf("  %-32s FAILED the pipeline logged %zu strokes and %zu records of %zu\n", trace.name.c_str(), begins, panSamples + ends, records.size());
+        return 1;
+    }
+    return 0;
+}
+
+}
+
+int benchStrokeLog(const bench::Options &options)
+{
+    std::vector<GestureTrace> traces;
+    if (!loadGestureCorpus(options, traces))
+        return 1;
+
+    int failures = 0;
+    const char *name = options.quick ? "10 minute session" : "2 hour session";
+    auto session = buildSession(traces, options.quick ? QuickSessionSeconds : SessionSeconds);
+
+    std::string path = tempPath("StrokeBench-session.strokelog");
+    stroke::StrokeLogWriter log;
+    if (!log.open(path.c_str())) {
+        printf("  %-32s FAILED can't create %s\n", name, path.c_str());
+        return 1;
+    }
+    std::vector<stroke::StrokeLogRecord> written;
+    auto start = bench::clock::now();
+    record(session, log, written);
+    bool closed = log.close();
+    double writeSeconds = bench::secondsSince(start);
+
+    stroke::StrokeLogReader reader;
+    start = bench::clock::now();
+    bool opened = reader.open(path.c_str());
+    double openMicros = bench::secondsSince(start) * 1e6;
+    if (!closed || !opened || written.empty()) {
+        printf("  %-32s FAILED %s\n", name, opened ? "writing the log" : reader.getError().c_str());
+        remove(path.c_str());
+        return 1;
+    }
+
+    //! the whole log, in order, against what was written
+    double epoch = written.front().seconds;
+    size_t decoded = 0, mismatched = 0;
+    bool malformed = false;
+    std::vector<size_t> blockFirst;
+    for (size_t b = 0; b < reader.getBlockCount(); ++b) {
+        blockFirst.push_back(decoded);
+        auto cursor = reader.read(b);
+        stroke::StrokeLogRecord record;
+        while (cursor.next(record)) {
+            mismatched += decoded >= written.size() || !matches(record, written[decoded], epoch);
+            decoded++;
+        }
+        malformed = malformed || cursor.failed();
+    }
+
+    auto decode = bench::measure(options, [&] {
+        for (size_t b = 0; b < reader.getBlockCount(); ++b) {
+            auto cursor = reader.read(b);
+            stroke::StrokeLogRecord record;
+            while (cursor.next(record)) {
+                bench::doNotOptimize(record);
+            }
+        }
+    });
+
+    //! seeking: the block findBlock() picks holds the time, and decoding into it finds the record
+    size_t misplaced = 0;
+    double sessionSeconds = written.back().seconds - epoch;
+    start = bench::clock::now();
+    for (int i = 0; i < SeekCount; ++i) {
+        double seconds = sessionSeconds * (i + 0.5) / SeekCount;
+        size_t b = reader.findBlock(seconds);
+        auto cursor = reader.read(b);
+        stroke::StrokeLogRecord record;
+        size_t index = blockFirst[b];
+        bool found = false;
+        while (!found && cursor.next(record)) {
+            found = record.seconds >= seconds;
+            index += !found;
+        }
+        bool inBlock = reader.getBlock(b).seconds <= seconds || b == 0;
+        bool nextLater = b + 1 == reader.getBlockCount() || reader.getBlock(b + 1).seconds > seconds;
+        //! a time between blocks is found at the start of the next one
+        bool atRecord = found ? matches(record, written[index], epoch) : nextLater;
+        misplaced += !inBlock || !nextLater || !atRecord;
+    }
+    double seekMicros = bench::secondsSince(start) * 1e6 / SeekCount;
+
+    //! cut off halfway through its last block, the log is read up to the block before
+    std::string cutPath = tempPath("StrokeBench-cut.strokelog");
+    auto &last = reader.getBlock(reader.getBlockCount() - 1);
+    stroke::StrokeLogReader cut;
+    bool recovered = truncateCopy(path, cutPath, last.offset + last.payloadBytes / 2) && cut.open(cutPath.c_str())
+        && !cut.hasIndex() && cut.getBlockCount() == reader.getBlockCount() - 1 && cut.getRecordCount() == reader.getRecordCount() - last.recordCount;
+    cut.close();
+    remove(cutPath.c_str());
+
+    //! A trailer whose count times the entry size wraps the offset around to the trailer, and an index
+    //! entry whose block header would wrap past the end, are not taken for an index: the log opens as
+    //! one that was never closed, with nothing in it.
+    const uint64_t end = 100 - stroke::strokelog::TrailerBytes;
+    const uint64_t wrappedOffset = end - 0xffffffffull * stroke::strokelog::IndexEntryBytes;
+    const uint64_t indexOffset = end - stroke::strokelog::IndexEntryBytes;
+    std::string corruptPath = tempPath("StrokeBench-corrupt.strokelog");
+    bool rejected = true;
+    for (auto trailer : {std::make_pair(wrappedOffset, 0xffffffffu), std::make_pair(indexOffset, 1u)}) {
+        stroke::StrokeLogReader corrupt;
+        rejected = rejected && writeCorruptCopy(path, corruptPath, trailer.first, trailer.second, ~0ull - 8)
+            && corrupt.open(corruptPath.c_str()) && !corrupt.hasIndex() && corrupt.getRecordCount() == 0;
+    }
+    remove(corruptPath.c_str());
+
+    double rawBytes = (double)written.size() * stroke::strokelog::RawRecordBytes;
+    double bytes = reader.getByteCount();
+    double compression = rawBytes / bytes;
+    bench::report(name, "records", written.size(), "");
+    bench::report(name, "blocks", reader.getBlockCount(), "");
+    bench::report(name, "log size", bytes / (1 << 20), "MB");
+    bench::report(name, "bytes per record", bytes / written.size(), "bytes");
+    bench::report(name, "compression", compression, "x");
+    bench::report(name, "write", written.size() / writeSeconds / 1e6, "M records/s");
+    bench::report(name, "open", openMicros, "us");
+    bench::report(name, "decode", decode.perSecond(bytes) / (1 << 20), "MB/s");
+    bench::report(name, "decode records", decode.perSecond(written.size()) / 1e6, "M records/s");
+    bench::report(name, "seek", seekMicros, "us");
+
+    if (!reader.hasIndex() || malformed || decoded != written.size() || mismatched) {
+        printf("  %-32s FAILED decoded %zu of %zu records, %zu differ from the ones written\n", name, decoded, written.size(), mismatched);
+        failures++;
+    }
+    if (compression < 5) {
+        printf("  %-32s FAILED %.2fx smaller than the raw records, under 5x\n", name, compression);
+        failures++;
+    }
+    if (misplaced) {
+        printf("  %-32s FAILED %zu of %d seeks land in the wrong place\n", name, misplaced, SeekCount);
+        failures++;
+    }
+    if (!recovered) {
+        printf("  %-32s FAILED a log cut off before closing isn't read up to its last whole block\n", name);
+        failures++;
+    }
+    if (!rejected) {
+        printf("  %-32s FAILED a corrupt index is read as one\n", name);
+        failures++;
+    }
+    reader.close();
+    remove(path.c_str());
+
+    for (auto &trace : traces) {
+        failures += checkPipeline(trace);
+    }
+    return failures;
+}
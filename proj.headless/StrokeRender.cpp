@@ -0,0 +1,307 @@
+//
+//  StrokeRender.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "GestureTrace.hpp"
+#include "PngWriter.hpp"
+#include "Stroke/SoftwareRenderer.hpp"
+#include "Stroke/StrokeRasterizer.hpp"
+
+#if defined(_WIN32)
+//! keeps windows.h from defining min and max over std::min and std::max
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <dirent.h>
+#include <sys/resource.h>
+#endif
+
+//! Batch renderer for recorded drawings. Runs without a display or a GL context: every gesture trace is
+//! played through the PanTracker and StrokePipeline LineDrawer uses into a StrokeModel, tessellated again by
+//! StrokeRasterizer at the output scale, drawn by SoftwareRenderer and streamed to PNG. Files are rendered
+//! in parallel, one per worker.
+//!
+//!     StrokeRender [--jobs n] [--scale s] [--thumbnail pixels] [--transparent] [--output dir] [--quiet] trace|dir...
+//!
+//! A directory stands for the .txt traces in it. Each trace gives name.png, and name-thumb.png with
+//! --thumbnail. The exit status is the number of traces that failed.
+
+namespace {
+
+const stroke::Color4F Ink {0, 0, 0, 1};
+const stroke::Color4F Paper {1, 1, 1, 1};
+//! points of paper around the ink
+const float Margin = 8;
+
+struct RenderOptions {
+    unsigned jobs = 0;
+    float scale = 1;
+    int thumbnail = 0;
+    bool transparent = false;
+    bool quiet = false;
+    std::string outputDir = ".";
+};
+
+struct RenderResult {
+    bool ok = false;
+    std::string error;
+    size_t pixels = 0;
+    size_t bytes = 0;
+};
+
+void usage()
+{
+    printf("usage: StrokeRender [--jobs n] [--scale s] [--thumbnail pixels] [--transparent] [--output dir] [--quiet] trace|dir...\n");
+}
+
+double peakResidentMegabytes()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+    return counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+    return usage.ru_maxrss / 1024.0;
+#endif
+#endif
+}
+
+bool endsWith(const std::string &s, const char *suffix)
+{
+    size_t n = strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+//! path itself, or the traces in it if it is a directory, sorted so runs are repeatable
+void addInputs(const std::string &path, std::vector<std::string> &inputs)
+{
+    std::vector<std::string> traces;
+#if defined(_WIN32)
+    DWORD attributes = GetFileAttributesA(path.c_str());
+    if (attributes == INVALID_FILE_ATTRIBUTES || !(attributes & FILE_ATTRIBUTE_DIRECTORY)) {
+        inputs.push_back(path);
+        return;
+    }
+
+    WIN32_FIND_DATAA entry;
+    HANDLE find = FindFirstFileA((path + "/*").c_str(), &entry);
+    if (find != INVALID_HANDLE_VALUE) {
+        do {
+            std::string name = entry.cFileName;
+            if (endsWith(name, ".txt"))
+                traces.push_back(path + "/" + name);
+        } while (FindNextFileA(find, &entry));
+        FindClose(find);
+    }
+#else
+    DIR *dir = opendir(path.c_str());
+    if (dir == nullptr) {
+        inputs.push_back(path);
+        return;
+    }
+
+    while (struct dirent *entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (endsWith(name, ".txt"))
+            traces.push_back(path + "/" + name);
+    }
+    closedir(dir);
+#endif
+    std::sort(traces.begin(), traces.end());
+    inputs.insert(inputs.end(), traces.begin(), traces.end());
+}
+
+std::string baseName(const std::string &path)
+{
+    size_t slash = path.find_last_of("/\\");
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    size_t dot = name.find_last_of('.');
+    return dot == std::string::npos ? name : name.substr(0, dot);
+}
+
+//! PNG rows run top down, the image's bottom up. Ink over paper is opaque; over nothing it is unpremultiplied.
+bool writePng(const std::string &path, const stroke::Image &image, bool transparent, size_t &bytes)
+{
+    FILE *file = fopen(path.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+
+    PngWriter png {file, image.width, image.height, transparent};
+    std::vector<uint32_t> row(image.width);
+    for (int y = image.height - 1; y >= 0; --y) {
+        const uint32_t *pixels = &image.pixels[(size_t)y * image.width];
+        if (!transparent) {
+            png.writeRow(pixels);
+            continue;
+        }
+        for (int x = 0; x < image.width; ++x) {
+            uint32_t p = pixels[x];
+            int a = stroke::Image::channel(p, 3);
+            auto straight = [&] (int c) { return (uint8_t)(a == 0 ? 0 : std::min(255, (stroke::Image::channel(p, c) * 255 + a / 2) / a)); };
+            row[x] = stroke::Image::pack(straight(0), straight(1), straight(2), (uint8_t)a);
+        }
+        png.writeRow(row.data());
+    }
+
+    bool ok = png.finish();
+    bytes = (size_t)ftell(file);
+    return fclose(file) == 0 && ok;
+}
+
+//! draws the model at scale into a new image just big enough for it
+void renderModel(const stroke::StrokeModel &model, float scale, const RenderOptions &options, stroke::Image &image)
+{
+    auto bounds = model.getBounds().expanded(Margin);
+    stroke::Vec2 origin {floorf(bounds.minX * scale), floorf(bounds.minY * scale)};
+    image = stroke::Image {(int)ceilf(bounds.maxX * scale - origin.x), (int)ceilf(bounds.maxY * scale - origin.y)};
+    image.clear(options.transparent ? stroke::Color4F {0, 0, 0, 0} : Paper);
+
+    stroke::StrokeRasterizer rasterizer;
+    stroke::StrokeMesh mesh;
+    rasterizer.rasterize(model, bounds, scale, mesh);
+
+    //! one thread per image: the pool is already running an image per thread
+    stroke::SoftwareRenderer renderer {1};
+    renderer.draw(image, mesh, Ink, origin);
+}
+
+RenderResult renderTrace(const std::string &path, const RenderOptions &options)
+{
+    RenderResult result;
+    GestureTrace trace;
+    if (!loadGestureTrace(path, trace, result.error))
+        return result;
+
+    stroke::StrokeModel model;
+    stroke::PanTracker tracker;
+    stroke::StrokePipeline pipeline;
+    pipeline.setModel(&model);
+    GesturePlayer player {trace, tracker, pipeline};
+    while (player.feedFrame()) {
+        pipeline.drawFrame();
+    }
+    if (model.getBounds().isEmpty()) {
+        result.error = "no strokes";
+        return result;
+    }
+
+    stroke::Image image;
+    std::string output = options.outputDir + "/" + baseName(path);
+    size_t bytes;
+
+    renderModel(model, options.scale, options, image);
+    if (!writePng(output + ".png", image, options.transparent, bytes)) {
+        result.error = "cannot write " + output + ".png";
+        return result;
+    }
+    result.pixels += image.pixels.size();
+    result.bytes += bytes;
+
+    if (options.thumbnail > 0) {
+        auto &bounds = model.getBounds();
+        //! a pixel short, for the origin rounding down to the pixel grid
+        float extent = std::max(bounds.getWidth(), bounds.getHeight()) + 2 * Margin;
+        renderModel(model, (options.thumbnail - 1) / extent, options, image);
+        if (!writePng(output + "-thumb.png", image, options.transparent, bytes)) {
+            result.error = "cannot write " + output + "-thumb.png";
+            return result;
+        }
+        result.pixels += image.pixels.size();
+        result.bytes += bytes;
+    }
+
+    result.ok = true;
+    return result;
+}
+
+}
+
+int main(int argc, char **argv)
+{
+    RenderOptions options;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+            options.jobs = (unsigned)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--scale") == 0 && i + 1 < argc) {
+            options.scale = (float)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--thumbnail") == 0 && i + 1 < argc) {
+            options.thumbnail = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            options.outputDir = argv[++i];
+        } else if (strcmp(argv[i], "--transparent") == 0) {
+            options.transparent = true;
+        } else if (strcmp(argv[i], "--quiet") == 0) {
+            options.quiet = true;
+        } else if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
+            usage();
+            return 0;
+        } else if (argv[i][0] == '-') {
+            printf("unknown option '%s'\n", argv[i]);
+            usage();
+            return 1;
+        } else {
+            addInputs(argv[i], inputs);
+        }
+    }
+
+    if (inputs.empty() || !(options.scale > 0)) {
+        usage();
+        return 1;
+    }
+
+    stroke::WorkerPool pool {options.jobs};
+    std::vector<RenderResult> results(inputs.size());
+    std::mutex outputMutex;
+
+    auto start = std::chrono::steady_clock::now();
+    pool.run(inputs.size(), [&] (size_t i) {
+        auto fileStart = std::chrono::steady_clock::now();
+        results[i] = renderTrace(inputs[i], options);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - fileStart).count();
+
+        std::lock_guard<std::mutex> lock(outputMutex);
+        if (!results[i].ok)
+            printf("  %-40s FAILED %s\n", inputs[i].c_str(), results[i].error.c_str());
+        else if (!options.quiet)
+            printf("  %-40s %8.2f Mpx %8zu KB %8.1f ms\n", inputs[i].c_str(), results[i].pixels / 1e6, results[i].bytes / 1024, ms);
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    int failures = 0;
+    size_t pixels = 0, bytes = 0;
+    for (auto &result : results) {
+        failures += !result.ok;
+        pixels += result.pixels;
+        bytes += result.bytes;
+    }
+    size_t rendered = inputs.size() - failures;
+
+    printf("%zu of %zu traces rendered on %u threads in %.2f s\n", rendered, inputs.size(), pool.getThreadCount(), seconds);
+    printf("  %-20s %10.1f\n", "images/s", rendered * (options.thumbnail > 0 ? 2 : 1) / seconds);
+    printf("  %-20s %10.1f\n", "Mpx/s", pixels / 1e6 / seconds);
+    printf("  %-20s %10.1f\n", "PNG KB/image", rendered ? bytes / 1024.0 / rendered : 0.0);
+    printf("  %-20s %10.1f\n", "peak RSS MB", peakResidentMegabytes());
+    return failures;
+}
@@ -0,0 +1,66 @@
+//
+//  SyntheticStrokes.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "SyntheticStrokes.hpp"
+
+#include <algorithm>
+#include <random>
+
+namespace synthetic {
+
+std::vector<stroke::LinePoint> spiral(int count, float spacing)
+{
+    std::vector<stroke::LinePoint> points;
+    points.reserve(count);
+
+    const stroke::Vec2 center {512, 384};
+    float angle = 0;
+    float radius = 10;
+    for (int i = 0; i < count; ++i) {
+        stroke::Vec2 pos = center + stroke::Vec2 {cosf(angle), sinf(angle)} * radius;
+        float width = 2.0f + 6.0f * (0.5f + 0.5f * sinf(i * 0.05f));
+        points.push_back(stroke::LinePoint {pos, width});
+
+        //! advance by roughly spacing along the arc
+        angle += spacing / radius;
+        radius = std::min(radius + spacing * 0.02f, 360.0f);
+    }
+    return points;
+}
+
+std::vector<stroke::LinePoint> scribble(int count, unsigned int seed)
+{
+    std::vector<stroke::LinePoint> points;
+    points.reserve(count);
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> jitter(-1.0f, 1.0f);
+
+    stroke::Vec2 pos {512, 384};
+    stroke::Vec2 dir {1, 0};
+    for (int i = 0; i < count; ++i) {
+        float speed = 20.0f + 60.0f * (0.5f + 0.5f * jitter(rng));
+        dir = (dir + stroke::Vec2 {jitter(rng), jitter(rng)} * 0.8f).getNormalized();
+
+        pos += dir * speed;
+        if (pos.x < 0 || pos.x > 1024) {
+            dir.x = -dir.x;
+            pos.x = std::max(0.0f, std::min(pos.x, 1024.0f));
+        }
+        if (pos.y < 0 || pos.y > 768) {
+            dir.y = -dir.y;
+            pos.y = std::max(0.0f, std::min(pos.y, 768.0f));
+        }
+
+        float width = std::max(1.0f, std::min(speed / 2.5f, 40.0f));
+        points.push_back(stroke::LinePoint {pos, width});
+    }
+    return points;
+}
+
+}
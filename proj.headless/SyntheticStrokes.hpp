@@ -0,0 +1,26 @@
+//
+//  SyntheticStrokes.hpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#ifndef SyntheticStrokes_hpp
+#define SyntheticStrokes_hpp
+
+#include <vector>
+#include "Stroke/StrokeTypes.hpp"
+
+//! Deterministic input strokes for the headless benchmarks, in design resolution points (1024x768).
+namespace synthetic {
+
+//! a spiral drawn at a steady pace, widths follow the speed the way LineDrawer::extractSize would.
+std::vector<stroke::LinePoint> spiral(int count, float spacing = 6.0f);
+
+//! a fast zig-zag scribble with large jumps between input points and quickly changing widths.
+std::vector<stroke::LinePoint> scribble(int count, unsigned int seed = 1);
+
+}
+
+#endif /* SyntheticStrokes_hpp */
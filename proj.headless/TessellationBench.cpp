@@ -0,0 +1,83 @@
+//
+//  TessellationBench.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "Benchmarks.hpp"
+
+#include <cmath>
+#include "FrameDriver.hpp"
+#include "SyntheticStrokes.hpp"
+#include "MeshValidation.hpp"
+
+namespace {
+
+struct StrokeTotals {
+    size_t inputPoints = 0;
+    size_t smoothedPoints = 0;
+    size_t vertices = 0;
+    size_t indices = 0;
+    size_t frames = 0;
+};
+
+
+//! draws the stroke pointsPerFrame input points at a time, the way touch events arrive between frames.
+bool drawStroke(FrameDriver &driver, const std::vector<stroke::LinePoint> &points, int pointsPerFrame, bool validate, StrokeTotals &totals)
+{
+    driver.startNewLine(points[0]);
+    for (size_t i = 1; i < points.size(); ++i) {
+        if (i == points.size() - 1)
+            driver.endLine(points[i]);
+        else
+            driver.addPoint(points[i]);
+        totals.inputPoints++;
+
+        if (i % pointsPerFrame == 0 || i == points.size() - 1) {
+            auto frame = driver.drawFrame();
+            totals.smoothedPoints += frame.smoothedPoints;
+            totals.vertices += frame.vertices;
+            totals.indices += frame.indices;
+            totals.frames++;
+
+            if (validate && !validateMesh(driver.getTessellator().getMesh()))
+                return false;
+        }
+    }
+    return true;
+}
+
+int runStroke(const char *name, const std::vector<stroke::LinePoint> &points, int pointsPerFrame, const bench::Options &options)
+{
+    FrameDriver driver;
+    StrokeTotals check;
+    if (!drawStroke(driver, points, pointsPerFrame, true, check)) {
+        printf("  %-32s FAILED mesh validation\n", name);
+        return 1;
+    }
+
+    StrokeTotals totals;
+    auto timing = bench::measure(options, [&] {
+        drawStroke(driver, points, pointsPerFrame, false, totals);
+    });
+
+    bench::report(name, "input points/s", timing.perSecond(check.inputPoints), "");
+    bench::report(name, "smoothed points/s", timing.perSecond(check.smoothedPoints), "");
+    bench::report(name, "vertices/s", timing.perSecond(check.vertices), "");
+    bench::report(name, "vertices/input point", (double)check.vertices / check.inputPoints, "");
+    bench::report(name, "us/frame", timing.seconds * 1e6 / (timing.iterations * check.frames), "");
+    return 0;
+}
+
+}
+
+int benchTessellation(const bench::Options &options)
+{
+    int count = options.quick ? 200 : 2000;
+    int failures = 0;
+    failures += runStroke("spiral, 4 points/frame", synthetic::spiral(count), 4, options);
+    failures += runStroke("scribble, 4 points/frame", synthetic::scribble(count), 4, options);
+    return failures;
+}
@@ -0,0 +1,235 @@
+//
+//  ThreadedBench.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "Benchmarks.hpp"
+
+#include <time.h>
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include "GestureTrace.hpp"
+#include "MeshValidation.hpp"
+#include "SyntheticStrokes.hpp"
+#include "Stroke/SoftwareRenderer.hpp"
+
+namespace {
+
+//! a burst: a quarter of a second of input arriving in one frame, as after a stall
+const double BurstInterval = 0.25;
+//! The rest of a frame, rendering or waiting for vsync: the main thread is off the CPU and the worker can run.
+//! Recorded gestures take microseconds a frame, so a short idle keeps the real time replay quick.
+const int IdleMicros = 500;
+const int FrameMicros = 16667;
+//! a scribble delivered in frames this heavy, where a synchronous frame takes a good part of the frame budget
+const int HeavyPoints = 16000;
+const int HeavyFramePoints = 2000;
+
+const stroke::Color4F Ink {0, 0, 0, 1};
+const stroke::Color4F Paper {1, 1, 1, 1};
+
+//! CPU time of the calling thread: what the main thread spends, without the time the worker preempts it for
+double threadMicros()
+{
+    timespec t;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t);
+    return t.tv_sec * 1e6 + t.tv_nsec / 1e3;
+}
+
+struct ThreadedTotals {
+    std::vector<double> frameMicros;
+    double mainMicros = 0;
+    size_t drawnFrames = 0;
+    double workerMicros = 0;
+    uint64_t builds = 0;
+    //! every frame's mesh, in order: the ink the canvas ends up with
+    stroke::StrokeMesh ink;
+    bool valid = true;
+};
+
+//! Hands a frame of input to the pipeline, false once there is none left; strokeEnding is set when a stroke
+//! ended in it.
+using FrameFeed = std::function<bool(bool &strokeEnding)>;
+//! a feed for a new pipeline
+using FeedFactory = std::function<FrameFeed(stroke::StrokePipeline &)>;
+
+FeedFactory gestureFeed(const GestureTrace &trace, double frameInterval)
+{
+    return [&trace, frameInterval] (stroke::StrokePipeline &pipeline) {
+        auto tracker = std::make_shared<stroke::PanTracker>();
+        auto player = std::make_shared<GesturePlayer>(trace, *tracker, pipeline, frameInterval);
+        return FrameFeed {[tracker, player] (bool &strokeEnding) {
+            bool more = player->feedFrame();
+            strokeEnding = tracker->getState() == stroke::PanTracker::Completed;
+            return more;
+        }};
+    };
+}
+
+FeedFactory strokeFeed(const std::vector<stroke::LinePoint> &points, size_t framePoints)
+{
+    return [&points, framePoints] (stroke::StrokePipeline &pipeline) {
+        auto next = std::make_shared<size_t>(0);
+        return FrameFeed {[&points, &pipeline, framePoints, next] (bool &strokeEnding) {
+            size_t &i = *next;
+            if (i == points.size())
+                return false;
+            for (size_t end = std::min(points.size(), i + framePoints); i < end; ++i) {
+                if (i == 0)
+                    pipeline.startNewLine(points[i].pos, points[i].width);
+                else if (i + 1 == points.size())
+                    pipeline.endLine(points[i].pos, points[i].width);
+                else
+                    pipeline.addPoint(points[i].pos, points[i].width);
+            }
+            strokeEnding = i == points.size();
+            return true;
+        }};
+    };
+}
+
+//! Replays the input as LineDrawer draws it: input and drawFrame() on this thread, waiting for the worker on
+//! the frame a stroke ends on, then idle until the next frame if threaded. Only the main thread's CPU time is
+//! counted, so the idle time isn't.
+void replay(const FeedFactory &feedFactory, bool threaded, bool keepInk, ThreadedTotals &totals, int idleMicros = IdleMicros)
+{
+    stroke::StrokePipeline pipeline;
+    pipeline.setThreaded(threaded);
+    FrameFeed feed = feedFactory(pipeline);
+
+    for (bool more = true; more; ) {
+        double start = threadMicros();
+        bool strokeEnding = false;
+        more = feed(strokeEnding);
+        //! and once more after the input, for whatever the worker still has
+        strokeEnding = strokeEnding || !more;
+        bool drawn = pipeline.drawFrame(strokeEnding);
+        double micros = threadMicros() - start;
+
+        totals.frameMicros.push_back(micros);
+        totals.mainMicros += micros;
+        if (drawn) {
+            totals.drawnFrames++;
+            if (keepInk) {
+                totals.valid = totals.valid && validateMesh(pipeline.getMesh());
+                totals.ink.append(pipeline.getMesh());
+            }
+        }
+        if (threaded)
+            std::this_thread::sleep_for(std::chrono::microseconds(idleMicros));
+    }
+
+    if (!pipeline.isIdle())
+        totals.valid = false;
+    if (auto worker = pipeline.getWorker()) {
+        totals.workerMicros += worker->getStats().buildMicros;
+        totals.builds += worker->getStats().builds;
+    }
+}
+
+double percentile(std::vector<double> &values, double p)
+{
+    std::sort(values.begin(), values.end());
+    size_t index = std::min(values.size() - 1, (size_t)(p * (values.size() - 1) + 0.5));
+    return values[index];
+}
+
+stroke::Image render(const stroke::StrokeMesh &mesh, const stroke::Bounds &bounds)
+{
+    stroke::Vec2 origin {floorf(bounds.minX), floorf(bounds.minY)};
+    stroke::Image image {(int)ceilf(bounds.maxX - origin.x), (int)ceilf(bounds.maxY - origin.y)};
+    image.clear(Paper);
+    stroke::SoftwareRenderer renderer {1};
+    renderer.draw(image, mesh, Ink, origin);
+    return image;
+}
+
+//! The pixels of threaded ink against synchronous ink. The worker splits the strokes where the points happen
+//! to have arrived rather than at frames; where the pieces overlap a fringe pixel can round differently.
+int compareInk(const char *name, const char *metric, const ThreadedTotals &sync, const ThreadedTotals &threaded)
+{
+    stroke::Bounds bounds = sync.ink.getBounds();
+    bounds.add(threaded.ink.getBounds());
+    auto a = render(sync.ink, bounds), b = render(threaded.ink, bounds);
+
+    size_t differing = 0;
+    int maxDifference = 0;
+    for (size_t i = 0; i < a.pixels.size(); ++i) {
+        int difference = 0;
+        for (int ch = 0; ch < 4; ++ch) {
+            difference = std::max(difference, abs(stroke::Image::channel(a.pixels[i], ch) - stroke::Image::channel(b.pixels[i], ch)));
+        }
+        differing += difference > 2;
+        maxDifference = std::max(maxDifference, difference);
+    }
+    double percent = 100.0 * differing / a.pixels.size();
+    bench::report(name, metric, percent, "%");
+    if (percent > 0.1) {
+        printf("  %-32s FAILED %.3f%% of the pixels differ by more than 2/255 from the synchronous ink, up to %d\n", name, percent, maxDifference);
+        return 1;
+    }
+    return 0;
+}
+
+//! the threaded pass runs in real time, once; the synchronous one is repeated for as long as that takes
+int compareModes(const char *name, const FeedFactory &feed, const ThreadedTotals &reference, const bench::Options &options, int idleMicros = IdleMicros)
+{
+    int failures = 0;
+    ThreadedTotals sync, threaded;
+    replay(feed, true, true, threaded, idleMicros);
+    if (!threaded.valid) {
+        printf("  %-32s FAILED mesh validation, or points left with the worker\n", name);
+        failures++;
+    }
+    failures += compareInk(name, "ink differing", reference, threaded);
+
+    auto start = bench::clock::now();
+    do {
+        replay(feed, false, false, sync);
+    } while (bench::secondsSince(start) < options.minSeconds);
+
+    double syncMean = sync.mainMicros / sync.frameMicros.size(), threadedMean = threaded.mainMicros / threaded.frameMicros.size();
+    bench::report(name, "sync frame mean", syncMean, "us");
+    bench::report(name, "sync frame p99", percentile(sync.frameMicros, 0.99), "us");
+    bench::report(name, "threaded frame mean", threadedMean, "us");
+    bench::report(name, "threaded frame p99", percentile(threaded.frameMicros, 0.99), "us");
+    bench::report(name, "worker build mean", threaded.builds ? threaded.workerMicros / threaded.builds : 0, "us");
+    bench::report(name, "main thread saved", 100 * (1 - threadedMean / syncMean), "%");
+    bench::report(name, "drawn frames", 100.0 * threaded.drawnFrames / threaded.frameMicros.size(), "%");
+    return failures;
+}
+
+int runGesture(const GestureTrace &trace, const bench::Options &options)
+{
+    //! Synchronous bursts lose the end of a stroke when the next one starts in the same frame, since the
+    //! stroke only gets drawn at the end of the frame; the worker builds each stroke as it ends. Both are
+    //! checked against synchronous frames at 60 Hz.
+    ThreadedTotals reference;
+    replay(gestureFeed(trace, GesturePlayer::DefaultFrameInterval), false, true, reference);
+
+    int failures = compareModes(trace.name.c_str(), gestureFeed(trace, GesturePlayer::DefaultFrameInterval), reference, options);
+    failures += compareModes((trace.name + " burst").c_str(), gestureFeed(trace, BurstInterval), reference, options);
+    return failures;
+}
+
+int runHeavy(const bench::Options &options)
+{
+    auto points = synthetic::scribble(HeavyPoints);
+    ThreadedTotals reference;
+    replay(strokeFeed(points, HeavyFramePoints), false, true, reference);
+    //! idle for the whole frame, heavy frames take long enough to show how far behind the worker falls
+    return compareModes("heavy scribble", strokeFeed(points, HeavyFramePoints), reference, options, FrameMicros);
+}
+
+}
+
+int benchThreaded(const bench::Options &options)
+{
+    int failures = forEachGesture(options, [&] (const GestureTrace &trace) { return runGesture(trace, options); });
+    failures += runHeavy(options);
+    return failures;
+}
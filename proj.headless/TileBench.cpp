@@ -0,0 +1,175 @@
+//
+//  TileBench.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "Benchmarks.hpp"
+
+#include <algorithm>
+
+#include "GestureTrace.hpp"
+#include "Stroke/TileGrid.hpp"
+
+namespace {
+
+//! a retina display at the app's design resolution, what the single full window render texture cost
+const float PixelScale = 2;
+const double WindowBytes = 1024.0 * 768.0 * PixelScale * PixelScale * stroke::TileGrid::BytesPerPixel;
+
+struct TileTotals {
+    size_t drawnFrames = 0;
+    size_t tileDraws = 0;
+    size_t maxFrameTiles = 0;
+    double routingSeconds = 0;
+    //! what routing by the mesh's bounds would have drawn
+    size_t boundsTileDraws = 0;
+    //! vertices that fell on a tile the mesh was not routed to
+    size_t missedVertices = 0;
+    //! tile draws, and allocated tiles, that no triangle reached
+    size_t emptyDraws = 0;
+    size_t emptyTiles = 0;
+    //! every frame's mesh appended, the gesture as one mesh
+    stroke::StrokeMesh gestureMesh;
+};
+
+//! Replays trace and routes every frame's mesh to the tiles of grid its triangles overlap, with the
+//! triangles that reach each, the way TiledCanvas does.
+void routeGesture(const GestureTrace &trace, stroke::TileGrid &grid, TileTotals &totals)
+{
+    stroke::PanTracker tracker;
+    stroke::StrokePipeline pipeline;
+    GesturePlayer player {trace, tracker, pipeline};
+    std::vector<stroke::TileCover> covers;
+    std::vector<stroke::TileCoord> overlapping;
+    stroke::StrokeMesh tileMesh;
+    //! by slot
+    std::vector<bool> inked;
+
+    while (player.feedFrame()) {
+        if (!pipeline.drawFrame())
+            continue;
+
+        auto &mesh = pipeline.getMesh();
+        auto start = bench::clock::now();
+        covers.clear();
+        grid.getMeshTiles(mesh, covers);
+        size_t routed = 0;
+        for (auto &cover : covers) {
+            bool created;
+            int slot = grid.acquire(cover.tile, created);
+            if (slot == stroke::TileGrid::NoTile)
+                continue;
+            tileMesh.clear();
+            tileMesh.appendOverlapping(mesh, grid.getTileBounds(cover.tile));
+            inked.resize(grid.getTileCount());
+            if (tileMesh.empty())
+                totals.emptyDraws++;
+            else
+                inked[slot] = true;
+            routed++;
+        }
+        totals.routingSeconds += bench::secondsSince(start);
+
+        overlapping.clear();
+        grid.getOverlappingTiles(mesh.getBounds(), overlapping);
+        totals.boundsTileDraws += overlapping.size();
+
+        totals.gestureMesh.append(mesh);
+        totals.drawnFrames++;
+        totals.tileDraws += routed;
+        totals.maxFrameTiles = std::max(totals.maxFrameTiles, routed);
+
+        for (auto &v : mesh.getVertices()) {
+            if (grid.find(grid.tileAt(v.x, v.y)) == stroke::TileGrid::NoTile)
+                totals.missedVertices++;
+        }
+    }
+    totals.emptyTiles = std::count(inked.begin(), inked.end(), false);
+}
+
+GestureTrace offsetTrace(const GestureTrace &trace, stroke::Vec2 offset)
+{
+    GestureTrace result = trace;
+    for (auto &sample : result.samples) {
+        sample.location += offset;
+    }
+    return result;
+}
+
+int runGesture(const GestureTrace &trace)
+{
+    const char *name = trace.name.c_str();
+    int failures = 0;
+
+    stroke::TileGrid grid {stroke::TileGrid::DefaultTileSize, PixelScale};
+    TileTotals totals;
+    routeGesture(trace, grid, totals);
+
+    bench::report(name, "tiles", grid.getTileCount(), "");
+    bench::report(name, "backing store", grid.getMemoryUsage() / (1024.0 * 1024.0), "MB");
+    bench::report(name, "of a window texture", 100.0 * grid.getMemoryUsage() / WindowBytes, "%");
+    bench::report(name, "tile draws/drawn frame", totals.drawnFrames ? (double)totals.tileDraws / totals.drawnFrames : 0, "");
+    bench::report(name, "by bounds/drawn frame", totals.drawnFrames ? (double)totals.boundsTileDraws / totals.drawnFrames : 0, "");
+    bench::report(name, "max tiles/frame", totals.maxFrameTiles, "");
+    bench::report(name, "routing/drawn frame", totals.drawnFrames ? totals.routingSeconds * 1e6 / totals.drawnFrames : 0, "us");
+
+    if (totals.missedVertices != 0) {
+        printf("  %-32s FAILED %zu vertices outside the tiles their mesh was routed to\n", name, totals.missedVertices);
+        failures++;
+    }
+    //! every tile allocated, and every tile pass, has ink to draw
+    if (totals.emptyTiles != 0 || totals.emptyDraws != 0) {
+        printf("  %-32s FAILED %zu tiles and %zu tile draws no triangle reached\n", name, totals.emptyTiles, totals.emptyDraws);
+        failures++;
+    }
+
+    //! the gesture drawn as one mesh, as a stroke is when it ends, needs the tiles of its frames and no more
+    std::vector<stroke::TileCover> covers;
+    grid.getMeshTiles(totals.gestureMesh, covers);
+    std::vector<stroke::TileCoord> overlapping;
+    grid.getOverlappingTiles(totals.gestureMesh.getBounds(), overlapping);
+    bench::report(name, "whole gesture tiles", covers.size(), "");
+    bench::report(name, "by bounds", overlapping.size(), "");
+    size_t unallocated = std::count_if(covers.begin(), covers.end(), [&] (const stroke::TileCover &cover) {
+        return grid.find(cover.tile) == stroke::TileGrid::NoTile;
+    });
+    if (covers.size() != grid.getTileCount() || unallocated != 0) {
+        printf("  %-32s FAILED whole gesture routed to %zu tiles, %zu new, against %zu\n", name, covers.size(), unallocated, grid.getTileCount());
+        failures++;
+    }
+
+    //! the same ink far from the origin, on the negative side too, needs the same tiles: the cost follows
+    //! the ink, not where it is on the canvas
+    const float far = 64 * stroke::TileGrid::DefaultTileSize;
+    stroke::TileGrid farGrid {stroke::TileGrid::DefaultTileSize, PixelScale};
+    TileTotals farTotals;
+    routeGesture(offsetTrace(trace, stroke::Vec2 {far, -far}), farGrid, farTotals);
+    if (farGrid.getTileCount() != grid.getTileCount() || farTotals.missedVertices != 0) {
+        printf("  %-32s FAILED %zu tiles far from the origin against %zu\n", name, farGrid.getTileCount(), grid.getTileCount());
+        failures++;
+    }
+
+    //! a budget smaller than the ink refuses tiles instead of going over
+    size_t budgetTiles = std::max<size_t>(1, grid.getTileCount() / 2);
+    stroke::TileGrid budgetGrid {stroke::TileGrid::DefaultTileSize, PixelScale};
+    budgetGrid.setMemoryBudget(budgetTiles * budgetGrid.getTileBytes());
+    TileTotals budgetTotals;
+    routeGesture(trace, budgetGrid, budgetTotals);
+    bool overBudget = budgetGrid.getMemoryUsage() > budgetGrid.getMemoryBudget();
+    bool refused = grid.getTileCount() <= budgetTiles || budgetGrid.getRejectedCount() > 0;
+    if (overBudget || !refused) {
+        printf("  %-32s FAILED %zu tiles in a budget of %zu, %zu refused\n", name, budgetGrid.getTileCount(), budgetTiles, budgetGrid.getRejectedCount());
+        failures++;
+    }
+    return failures;
+}
+
+}
+
+int benchTiles(const bench::Options &options)
+{
+    return forEachGesture(options, [&] (const GestureTrace &trace) { return runGesture(trace); });
+}
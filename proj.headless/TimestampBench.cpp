@@ -0,0 +1,98 @@
+//
+//  TimestampBench.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "Benchmarks.hpp"
+
+#include <math.h>
+#include "GestureTrace.hpp"
+
+namespace {
+
+//! input delivered four frames at a time, as from a main thread under load
+const double BurstInterval = 4 * GesturePlayer::DefaultFrameInterval;
+
+struct Widths {
+    std::vector<float> widths;
+    //! root mean square of the change in width from point to point, within strokes
+    double jitter = 0;
+    bool finite = true;
+};
+
+//! the widths LineDrawer would draw the trace with, delivered every frameInterval
+Widths play(const GestureTrace &trace, double frameInterval, bool deliveryTimestamps)
+{
+    stroke::StrokeModel model;
+    stroke::PanTracker tracker;
+    stroke::StrokePipeline pipeline;
+    pipeline.setModel(&model);
+    GesturePlayer player {trace, tracker, pipeline, frameInterval};
+    player.setDeliveryTimestamps(deliveryTimestamps);
+    while (player.feedFrame()) {
+        pipeline.drawFrame();
+    }
+
+    Widths result;
+    double squares = 0;
+    size_t steps = 0;
+    std::vector<stroke::LinePoint> points;
+    for (size_t s = 0; s < model.getStrokeCount(); ++s) {
+        model.decode(s, points);
+        for (size_t i = 0; i < points.size(); ++i) {
+            float width = points[i].width;
+            result.finite = result.finite && std::isfinite(width);
+            result.widths.push_back(width);
+            if (i > 0) {
+                squares += (width - points[i - 1].width) * (width - points[i - 1].width);
+                steps++;
+            }
+        }
+    }
+    result.jitter = steps ? sqrt(squares / steps) : 0;
+    return result;
+}
+
+//! mean difference in width, point for point, over the points both have
+double meanDifference(const Widths &a, const Widths &b)
+{
+    size_t count = std::min(a.widths.size(), b.widths.size());
+    double sum = 0;
+    for (size_t i = 0; i < count; ++i) {
+        sum += fabs(a.widths[i] - b.widths[i]);
+    }
+    return count ? sum / count : 0;
+}
+
+int runGesture(const GestureTrace &trace)
+{
+    const char *name = trace.name.c_str();
+    Widths reference = play(trace, GesturePlayer::DefaultFrameInterval, false);
+    Widths burst = play(trace, BurstInterval, false);
+    Widths delivered = play(trace, BurstInterval, true);
+
+    bench::report(name, "width jitter 60 Hz", reference.jitter, "pt");
+    bench::report(name, "width jitter bursts", burst.jitter, "pt");
+    bench::report(name, "width error bursts", meanDifference(reference, burst), "pt");
+    bench::report(name, "stamped late error", meanDifference(reference, delivered), "pt");
+    //! with the events' own timestamps, how the input is delivered makes no difference to the widths
+    if (!reference.finite || !burst.finite || !delivered.finite) {
+        printf("  %-32s FAILED widths that are not finite\n", name);
+        return 1;
+    }
+    if (reference.widths.size() != burst.widths.size() || meanDifference(reference, burst) > 0.01) {
+        printf("  %-32s FAILED %zu points in bursts, %zu at 60 Hz, %.3f pt apart\n", name, burst.widths.size(), reference.widths.size(), meanDifference(reference, burst));
+        return 1;
+    }
+    return 0;
+}
+
+}
+
+int benchTimestamps(const bench::Options &options)
+{
+    return forEachGesture(options, [&] (const GestureTrace &trace) { return runGesture(trace); });
+}
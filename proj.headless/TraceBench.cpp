@@ -0,0 +1,128 @@
+//
+//  TraceBench.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "Benchmarks.hpp"
+
+#include <cstdlib>
+#include <string>
+#include "FrameDriver.hpp"
+#include "SyntheticStrokes.hpp"
+
+namespace {
+
+struct PhaseTotals {
+    size_t frames = 0;
+    double micros[stroke::FrameStats::PhaseCount] = {};
+    bool countsMatch = true;
+};
+
+void drawStroke(FrameDriver &driver, stroke::FrameProfiler *profiler, const std::vector<stroke::LinePoint> &points, PhaseTotals &totals)
+{
+    driver.setProfiler(profiler);
+    driver.startNewLine(points[0]);
+    for (size_t i = 1; i < points.size(); ++i) {
+        if (i == points.size() - 1)
+            driver.endLine(points[i]);
+        else
+            driver.addPoint(points[i]);
+
+        if (i % 4 == 0 || i == points.size() - 1) {
+            auto frame = driver.drawFrame();
+            if (profiler == nullptr)
+                continue;
+
+            auto &stats = profiler->getLastFrame();
+            totals.frames++;
+            for (int phase = 0; phase < stroke::FrameStats::PhaseCount; ++phase) {
+                totals.micros[phase] += stats.micros[phase];
+            }
+            totals.countsMatch = totals.countsMatch && stats.smoothedPoints == frame.smoothedPoints
+                && stats.vertices == frame.vertices && stats.indices == frame.indices;
+        }
+    }
+}
+
+std::string readFile(const std::string &path)
+{
+    std::string contents;
+    FILE *file = fopen(path.c_str(), "r");
+    if (file == nullptr)
+        return contents;
+
+    char buffer[4096];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        contents.append(buffer, read);
+    }
+    fclose(file);
+    return contents;
+}
+
+size_t countOf(const std::string &text, const char *needle)
+{
+    size_t count = 0;
+    for (size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1)) {
+        count++;
+    }
+    return count;
+}
+
+}
+
+int benchTrace(const bench::Options &options)
+{
+    int count = options.quick ? 200 : 2000;
+    auto points = synthetic::scribble(count);
+    int failures = 0;
+
+    FrameDriver driver;
+    stroke::FrameProfiler profiler;
+
+    PhaseTotals totals;
+    drawStroke(driver, &profiler, points, totals);
+    //! submission and the render texture pass only exist in LineDrawer
+    for (auto phase : {stroke::FrameStats::Smoothing, stroke::FrameStats::Tessellation}) {
+        bench::report(stroke::FrameStats::getPhaseName(phase), "mean", totals.micros[phase] / totals.frames, "us/frame");
+    }
+    if (!totals.countsMatch) {
+        printf("  %-32s FAILED frame stats disagree with the frames drawn\n", "counters");
+        failures++;
+    }
+
+    const char *tmp = getenv("TMPDIR");
+    std::string path = std::string(tmp ? tmp : "/tmp") + "/StrokeBench-trace.json";
+    if (!profiler.openTrace(path.c_str())) {
+        printf("  %-32s FAILED can't create %s\n", "trace", path.c_str());
+        return failures + 1;
+    }
+    PhaseTotals traced;
+    drawStroke(driver, &profiler, points, traced);
+    size_t events = profiler.getTrace().getEventCount();
+    profiler.closeTrace();
+
+    //! 2 slices (smoothing, tessellation) and 1 counter per frame that drew geometry, 1 counter per empty frame
+    std::string trace = readFile(path);
+    size_t slices = countOf(trace, "\"ph\":\"X\"");
+    size_t counters = countOf(trace, "\"ph\":\"C\"");
+    bool wellFormed = trace.size() > 4 && trace.compare(0, 2, "[\n") == 0 && trace.compare(trace.size() - 3, 3, "\n]\n") == 0
+        && countOf(trace, "{") == countOf(trace, "}") && slices + counters == events && counters == traced.frames;
+    remove(path.c_str());
+
+    bench::report("trace", "events", events, "");
+    bench::report("trace", "size", (double)trace.size() / traced.frames, "bytes/frame");
+    if (!wellFormed) {
+        printf("  %-32s FAILED malformed trace (%zu slices, %zu counters, %zu events)\n", "trace", slices, counters, events);
+        failures++;
+    }
+
+    auto off = bench::measure(options, [&] { PhaseTotals t; drawStroke(driver, nullptr, points, t); });
+    auto on = bench::measure(options, [&] { PhaseTotals t; drawStroke(driver, &profiler, points, t); });
+    bench::report("profiler", "off", off.microsPerIteration(), "us/stroke");
+    bench::report("profiler", "on", on.microsPerIteration(), "us/stroke");
+    return failures;
+}
@@ -0,0 +1,179 @@
+//
+//  VelocityBench.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include "Benchmarks.hpp"
+
+#include <math.h>
+#include <string>
+#include "Stroke/StrokePipeline.hpp"
+#include "Stroke/VelocityCalculator.hpp"
+
+namespace {
+
+//! a touch screen sampling at 120 Hz, each sample up to a millisecond early or late
+const double SampleInterval = 1.0 / 120;
+const double SampleJitter = 0.001;
+const double Duration = 1.5;
+//! samples before the estimate counts, while every estimator is still starting up
+const int WarmUpSamples = 5;
+
+//! a pen path with its exact velocity, in points and seconds
+struct Trajectory {
+    const char *name;
+    stroke::Vec2 (*location)(double t);
+    stroke::Vec2 (*velocity)(double t);
+};
+
+const double Tau = 2 * M_PI;
+
+const Trajectory Trajectories[] = {
+    {"circle",
+        [] (double t) { return stroke::Vec2 {(float)(150 * cos(Tau * t)), (float)(150 * sin(Tau * t))}; },
+        [] (double t) { return stroke::Vec2 {(float)(-150 * Tau * sin(Tau * t)), (float)(150 * Tau * cos(Tau * t))}; }},
+    //! speeds up from rest to 600 points per second and back, twice a second
+    {"stop and go",
+        [] (double t) { return stroke::Vec2 {(float)(300 * (t - sin(Tau * 2 * t) / (Tau * 2))), 0}; },
+        [] (double t) { return stroke::Vec2 {(float)(300 * (1 - cos(Tau * 2 * t))), 0}; }},
+    //! a fast figure of eight, turning sharply at its ends
+    {"figure eight",
+        [] (double t) { return stroke::Vec2 {(float)(200 * sin(Tau * 1.5 * t)), (float)(120 * sin(Tau * 3 * t))}; },
+        [] (double t) { return stroke::Vec2 {(float)(200 * Tau * 1.5 * cos(Tau * 1.5 * t)), (float)(120 * Tau * 3 * cos(Tau * 3 * t))}; }},
+};
+
+//! how the samples are spoiled: locations rounded to half a point as a 2x screen reports them, or with a
+//! point of noise on top and an 8 point outlier every 40 samples
+enum Condition { Clean, Noisy };
+const char *const ConditionNames[] = {"clean", "noisy"};
+
+struct Sample {
+    double seconds;
+    stroke::Vec2 location, velocity;
+};
+
+std::vector<Sample> sample(const Trajectory &trajectory, Condition condition)
+{
+    uint32_t seed = 12345;
+    auto random = [&seed] {
+        seed = seed * 1664525u + 1013904223u;
+        return (seed >> 8) / (double)(1 << 24) * 2 - 1;
+    };
+
+    std::vector<Sample> samples;
+    for (int i = 0; i * SampleInterval < Duration; ++i) {
+        double t = i * SampleInterval + (i > 0 ? random() * SampleJitter : 0);
+        stroke::Vec2 location = trajectory.location(t);
+        if (condition == Noisy) {
+            location += stroke::Vec2 {(float)random(), (float)random()};
+            if (i % 40 == 39)
+                location.x += 8;
+        }
+        location = stroke::Vec2 {roundf(location.x * 2) / 2, roundf(location.y * 2) / 2};
+        samples.push_back(Sample {t, location, trajectory.velocity(t)});
+    }
+    return samples;
+}
+
+struct Accuracy {
+    //! root mean square of the velocity error, points per second
+    double velocityError = 0;
+    //! root mean square error of the width LineDrawer::extractSize draws for the velocity, before its own filter
+    double widthError = 0;
+    double nanosPerSample = 0;
+    bool finite = true;
+};
+
+float widthFor(stroke::Vec2 velocity)
+{
+    float width = velocity.getLength() / stroke::StrokePipeline::SpeedPerWidth;
+    return std::min(std::max(width, stroke::StrokePipeline::MinWidth), stroke::StrokePipeline::MaxWidth);
+}
+
+template <class Estimator>
+Accuracy measure(const std::vector<Sample> &samples, const bench::Options &options)
+{
+    using Calculator = stroke::BasicVelocityCalculator<Estimator>;
+    const auto epoch = typename Calculator::time_point {};
+    auto timeOf = [&] (double seconds) {
+        return epoch + std::chrono::duration_cast<typename Calculator::time_point::duration>(std::chrono::duration<double>(seconds));
+    };
+
+    Accuracy accuracy;
+    Calculator calculator;
+    double velocitySquares = 0, widthSquares = 0;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        calculator.addLocation(samples[i].location, timeOf(samples[i].seconds));
+        stroke::Vec2 velocity = calculator.getVelocity();
+        accuracy.finite = accuracy.finite && std::isfinite(velocity.x) && std::isfinite(velocity.y);
+        if ((int)i < WarmUpSamples)
+            continue;
+        velocitySquares += (velocity - samples[i].velocity).getLengthSq();
+        float widthError = widthFor(velocity) - widthFor(samples[i].velocity);
+        widthSquares += widthError * widthError;
+    }
+    size_t counted = samples.size() - WarmUpSamples;
+    accuracy.velocityError = sqrt(velocitySquares / counted);
+    accuracy.widthError = sqrt(widthSquares / counted);
+
+    std::vector<typename Calculator::time_point> timestamps;
+    for (auto &sample : samples) {
+        timestamps.push_back(timeOf(sample.seconds));
+    }
+    size_t added = 0;
+    float sink = 0;
+    auto start = bench::clock::now();
+    do {
+        calculator.reset();
+        for (size_t i = 0; i < samples.size(); ++i) {
+            calculator.addLocation(samples[i].location, timestamps[i]);
+            sink += calculator.getVelocity().x;
+        }
+        added += samples.size();
+    } while (bench::secondsSince(start) < options.minSeconds);
+    accuracy.nanosPerSample = bench::secondsSince(start) * 1e9 / added;
+    accuracy.finite = accuracy.finite && std::isfinite(sink);
+    return accuracy;
+}
+
+void report(const std::string &name, const char *estimator, const Accuracy &accuracy)
+{
+    std::string row = name + " " + estimator;
+    bench::report(row.c_str(), "velocity error", accuracy.velocityError, "pt/s");
+    bench::report(row.c_str(), "width error", accuracy.widthError, "pt");
+    bench::report(row.c_str(), "per sample", accuracy.nanosPerSample, "ns");
+}
+
+}
+
+int benchVelocity(const bench::Options &options)
+{
+    int failures = 0;
+    for (auto &trajectory : Trajectories) {
+        for (auto condition : {Clean, Noisy}) {
+            std::string name = std::string(trajectory.name) + " " + ConditionNames[condition];
+            auto samples = sample(trajectory, condition);
+
+            Accuracy boxcar = measure<stroke::BoxcarEstimator>(samples, options);
+            Accuracy leastSquares = measure<stroke::LeastSquaresEstimator>(samples, options);
+            Accuracy kalman = measure<stroke::KalmanEstimator>(samples, options);
+            report(name, "boxcar", boxcar);
+            report(name, "least squares", leastSquares);
+            report(name, "kalman", kalman);
+
+            if (!boxcar.finite || !leastSquares.finite || !kalman.finite) {
+                printf("  %-32s FAILED velocities that are not finite\n", name.c_str());
+                failures++;
+            }
+            //! both are there to track the pen more closely than the boxcar
+            if (leastSquares.velocityError >= boxcar.velocityError || kalman.velocityError >= boxcar.velocityError) {
+                printf("  %-32s FAILED least squares %.0f, kalman %.0f pt/s off against boxcar %.0f\n", name.c_str(), leastSquares.velocityError, kalman.velocityError, boxcar.velocityError);
+                failures++;
+            }
+        }
+    }
+    return failures;
+}
@@ -0,0 +1,103 @@
+//
+//  main.cpp
+//  SmoothDrawing
+//
+//  Created by Benny Khoo on 16/10/2026.
+//
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "Benchmarks.hpp"
+
+//! Headless driver for the stroke geometry library. Runs without cocos2d or a GL context, so the smoothing
+//! and tessellation throughput can be profiled and regression-checked on any machine.
+//!
+//!     StrokeBench [--quick] [--min-time seconds] [--gestures dir] [benchmark...]
+//!
+//! With no benchmark names every benchmark is run. The exit status is the number of failed checks.
+
+static const std::vector<bench::Benchmark> Benchmarks = {
+    {"tessellation", "per-frame smoothing and tessellation of synthetic strokes", benchTessellation},
+    {"smoothing", "quadratic curve evaluation against the original powf implementation", benchSmoothing},
+    {"flattening", "adaptive curve flattening against the fixed sample count", benchFlattening},
+    {"stress", "single frames of hundreds of thousands of vertices split into 16 bit batches", benchStress},
+    {"mesh", "vertex traffic of shared cross sections against 12 vertices per segment", benchMesh},
+    {"caps", "radius adaptive round caps against the fixed 32 point caps", benchCaps},
+    {"alloc", "heap allocations per frame of a steady state stroke, must be zero", benchAllocations},
+    {"trace", "per-frame counters and Chrome trace export of the frame profiler", benchTrace},
+    {"replay", "recorded gestures through pan tracking, width extraction, smoothing and tessellation", benchReplay},
+    {"tiles", "tiled canvas memory and mesh to tile routing over the recorded gestures", benchTiles},
+    {"model", "retained stroke model size and rasterization at other scales", benchModel},
+    {"history", "copy on write tile undo history over 1000 strokes: memory and undo latency", benchHistory},
+    {"software", "CPU rasterizer: agreement with a per-pixel reference, thread scaling and export rate", benchSoftware},
+    {"threaded", "main thread time with smoothing and tessellation on a worker thread, at 60 Hz and in bursts", benchThreaded},
+    {"multitouch", "every recorded gesture drawn at once, one finger each, into one model and one mesh a frame", benchMultiTouch},
+    {"prediction", "latency the predicted wet ink hides at a few horizons, and how far off the path it strays", benchPrediction},
+    {"overlay", "live strokes drawn whole over the canvas and into it once, against frame by frame", benchOverlay},
+    {"redraw", "frames drawn on demand against a continuous 60 Hz loop over gestures with idle gaps", benchRedraw},
+    {"timestamps", "stroke widths with event timestamps against delivery timestamps, at 60 Hz and in bursts", benchTimestamps},
+    {"velocity", "boxcar, least squares and Kalman velocity estimators against synthetic paths of known velocity", benchVelocity},
+    {"coalesced", "each frame's touch samples delivered as one batch, one at a time and only the latest", benchCoalesced},
+    {"strokelog", "a long drawing session recorded to a stroke log, read back, decoded and seeked", benchStrokeLog},
+};
+
+static void usage()
+{
+    printf("usage: StrokeBench [--quick] [--min-time seconds] [--gestures dir] [benchmark...]\n\nbenchmarks:\n");
+    for (auto &b : Benchmarks) {
+        printf("  %-16s %s\n", b.name, b.description);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    bench::Options options;
+    std::vector<const char *> selected;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--quick") == 0) {
+            options.quick = true;
+            options.minSeconds = 0.05;
+        } else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            options.minSeconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--gestures") == 0 && i + 1 < argc) {
+            options.gestureDir = argv[++i];
+        } else if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
+            usage();
+            return 0;
+        } else {
+            selected.push_back(argv[i]);
+        }
+    }
+
+    for (auto name : selected) {
+        bool known = false;
+        for (auto &b : Benchmarks) {
+            known = known || strcmp(name, b.name) == 0;
+        }
+        if (!known) {
+            printf("unknown benchmark '%s'\n", name);
+            usage();
+            return 1;
+        }
+    }
+
+    int failures = 0;
+    for (auto &b : Benchmarks) {
+        bool run = selected.empty();
+        for (auto name : selected) {
+            run = run || strcmp(name, b.name) == 0;
+        }
+        if (!run)
+            continue;
+
+        printf("%s: %s\n", b.name, b.description);
+        failures += b.run(options);
+    }
+
+    return failures;
+}
@@ -27,6 +27,77 @@
 #import "cocos2d.h"
 #import "AppDelegate.h"
 #import "RootViewController.h"
+#include <chrono>
+#include <vector>
+#include "Stroke/InputClock.hpp"
+
+//! Hands cocos2d each touch event along with the time it happened, through stroke::InputClock, so the
+//! gesture recognizers measure velocity over the touches' own timestamps rather than their delivery. Moves
+//! also bring the samples the touch screen took since the last event, which UIKit coalesces into it.
+@interface TimestampedEAGLView : CCEAGLView
+@end
+
+@implementation TimestampedEAGLView
+
+- (void)dispatchEvent:(UIEvent *)event touches:(void (^)(void))dispatch
+{
+    // UIEvent timestamps count seconds of system uptime
+    stroke::InputClock::beginEvent([NSProcessInfo processInfo].systemUptime - event.timestamp);
+    dispatch();
+    stroke::InputClock::endEvent();
+}
+
+- (void)touchesBegan:(NSSet *)touches withEvent:(UIEvent *)event
+{
+    [self dispatchEvent:event touches:^{ [super touchesBegan:touches withEvent:event]; }];
+}
+
+- (void)touchesMoved:(NSSet *)touches withEvent:(UIEvent *)event
+{
+    [self dispatchEvent:event touches:^{
+        [self addCoalescedTouches:touches event:event];
+        [super touchesMoved:touches withEvent:event];
+    }];
+}
+
+- (void)addCoalescedTouches:(NSSet *)touches event:(UIEvent *)event
+{
+    if (![event respondsToSelector:@selector(coalescedTouchesForTouch:)])
+        return;
+
+    // the locations as cocos2d hands touches over: in pixels, into the viewport, then into GL coordinates
+    auto director = cocos2d::Director::getInstance();
+    auto glview = director->getOpenGLView();
+    cocos2d::Rect viewPort = glview->getViewPortRect();
+    float scale = self.contentScaleFactor;
+    NSTimeInterval uptime = [NSProcessInfo processInfo].systemUptime;
+    auto now = std::chrono::steady_clock::now();
+
+    static std::vector<stroke::InputSample> samples;
+    for (UITouch *touch in touches) {
+        samples.clear();
+        for (UITouch *coalesced in [event coalescedTouchesForTouch:touch]) {
+            CGPoint point = [coalesced locationInView:[touch view]];
+            cocos2d::Vec2 location = director->convertToGL(cocos2d::Vec2((point.x * scale - viewPort.origin.x) / glview->getScaleX(),
+                                                                        (point.y * scale - viewPort.origin.y) / glview->getScaleY()));
+            auto age = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(uptime - coalesced.timestamp));
+            samples.push_back(stroke::InputSample {stroke::Vec2 {location.x, location.y}, now - age});
+        }
+        stroke::InputClock::addSamples(samples.data(), samples.size());
+    }
+}
+
+- (void)touchesEnded:(NSSet *)touches withEvent:(UIEvent *)event
+{
+    [self dispatchEvent:event touches:^{ [super touchesEnded:touches withEvent:event]; }];
+}
+
+- (void)touchesCancelled:(NSSet *)touches withEvent:(UIEvent *)event
+{
+    [self dispatchEvent:event touches:^{ [super touchesCancelled:touches withEvent:event]; }];
+}
+
+@end
 
 @implementation AppController
 
@@ -48,16 +119,16 @@ static AppDelegate s_sharedApplication;
     window = [[UIWindow alloc] initWithFrame: [[UIScreen mainScreen] bounds]];
 
     // Init the CCEAGLView
-    CCEAGLView *eaglView = [CCEAGLView viewWithFrame: [window bounds]
-                                         pixelFormat: (NSString*)cocos2d::GLViewImpl::_pixelFormat
-                                         depthFormat: cocos2d::GLViewImpl::_depthFormat
-                                  preserveBackbuffer: NO
-                                          sharegroup: nil
-                                       multiSampling: NO
-                                     numberOfSamples: 0 ];
+    CCEAGLView *eaglView = [TimestampedEAGLView viewWithFrame: [window bounds]
+                                                  pixelFormat: (NSString*)cocos2d::GLViewImpl::_pixelFormat
+                                                  depthFormat: cocos2d::GLViewImpl::_depthFormat
+                                           preserveBackbuffer: NO
+                                                   sharegroup: nil
+                                                multiSampling: NO
+                                              numberOfSamples: 0 ];
     
     // Enable or disable multiple touches
-    [eaglView setMultipleTouchEnabled:NO];
+    [eaglView setMultipleTouchEnabled:YES];
 
     // Use RootViewController manage CCEAGLView 
     _viewController = [[RootViewController alloc] initWithNibName:nil bundle:nil];